@@ -0,0 +1,142 @@
+#include <Benchmark.hpp>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/time.h>
+#endif
+
+vector<Benchmark*> * BenchmarkManager::benchmarkLst = 0;
+
+const double BenchmarkManager::minTime = 0.2;
+const double BenchmarkManager::tolerance = 0.1;
+
+static double now()
+{
+#ifdef _WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+    timeval tv;
+    gettimeofday(&tv, 0);
+    return tv.tv_sec + tv.tv_usec * 1E-6;
+#endif
+}
+
+Benchmark::Benchmark(const string & name)
+: className(name), iterations(0), count(0), items(1), start(0.0), seconds(0.0), sink(0.0)
+{
+
+}
+
+bool Benchmark::keepRunning()
+{
+    if(count == 0) start = now();
+
+    if(count++ < iterations) return true;
+
+    seconds = now() - start;
+    return false;
+}
+
+double Benchmark::uniform(double lo, double hi)
+{
+    return lo + (hi - lo) * (rand() / (double)RAND_MAX);
+}
+
+void Benchmark::measure(int iterations)
+{
+    this->iterations = iterations;
+    count = 0;
+    seconds = 0.0;
+    srand(1);
+
+    run();
+}
+
+BenchmarkManager::BenchmarkManager()
+{
+
+}
+
+BenchmarkManager::~BenchmarkManager()
+{
+
+}
+
+void BenchmarkManager::run(const string & filter)
+{
+    if(!benchmarkLst) return;
+
+    for(unsigned int i=0; i<benchmarkLst->size(); i++){
+        Benchmark * bench = (*benchmarkLst)[i];
+        if(bench->getName().find(filter) == string::npos) continue;
+
+        // grow the number of iterations until the measurement is long enough
+        int iterations = 1;
+        bench->measure(iterations);
+        while(bench->getSeconds() < minTime && iterations < (1 << 30)){
+            const double scale = bench->getSeconds() > 0.0 ? 1.5 * minTime / bench->getSeconds() : 100.0;
+            iterations = (int)std::min(iterations * std::min(std::max(scale, 2.0), 100.0), (double)(1 << 30));
+            bench->measure(iterations);
+        }
+
+        names.push_back(bench->getName());
+        nanoseconds.push_back(bench->getSeconds() * 1E9 / ((double)iterations * bench->getItems()));
+    }
+}
+
+void BenchmarkManager::print() const
+{
+    for(unsigned int i=0; i<names.size(); i++){
+        map<string, double>::const_iterator it = baseline.find(names[i]);
+
+        if(it == baseline.end()){
+            printf("%-36s %12.2f ns\n", names[i].c_str(), nanoseconds[i]);
+        } else {
+            const double ratio = nanoseconds[i] / it->second;
+            printf("%-36s %12.2f ns %8.2fx%s\n", names[i].c_str(), nanoseconds[i], ratio, ratio > 1.0 + tolerance ? "  REGRESSION" : "");
+        }
+    }
+    printf("Benchmarks run: %d\n", (int)names.size());
+}
+
+void BenchmarkManager::save(const string & filename) const
+{
+    FILE * fp = fopen(filename.c_str(), "wt");
+    if(!fp) return;
+
+    for(unsigned int i=0; i<names.size(); i++){
+        fprintf(fp, "%s %f\n", names[i].c_str(), nanoseconds[i]);
+    }
+    fclose(fp);
+}
+
+void BenchmarkManager::load(const string & filename)
+{
+    FILE * fp = fopen(filename.c_str(), "rt");
+    if(!fp) return;
+
+    char name[256];
+    double value;
+    while(fscanf(fp, "%255s %lf", name, &value) == 2){
+        baseline[name] = value;
+    }
+    fclose(fp);
+}
+
+int BenchmarkManager::addBenchmark(Benchmark* a_bench)
+{
+    if(!benchmarkLst) benchmarkLst = new vector<Benchmark*>;
+
+    benchmarkLst->push_back(a_bench);
+
+    return (int)benchmarkLst->size();
+}
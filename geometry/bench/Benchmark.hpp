@@ -0,0 +1,90 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <vector>
+#include <string>
+#include <map>
+
+using namespace std;
+
+class Benchmark
+{
+public:
+    Benchmark(const string & name);
+
+    virtual void run() = 0;
+
+    //! Drives the timed loop of run(): the clock starts at the first call and stops when it returns false.
+    bool keepRunning();
+
+    //! Number of items processed by one iteration, the results are reported per item.
+    void setItems(int items){ this->items = items; }
+
+    //! Keeps a result alive so that the compiler cannot optimize the measured code away.
+    void use(double value){ sink = sink + value; }
+
+    //! Uniform random number between \a lo and \a hi.
+    static double uniform(double lo, double hi);
+
+    void measure(int iterations);
+
+    const string & getName() const { return className; }
+    double getSeconds() const { return seconds; }
+    int getItems() const { return items; }
+
+private:
+    string className;
+
+    int iterations;
+    int count;
+    int items;
+    double start;
+    double seconds;
+
+    volatile double sink;
+};
+
+class BenchmarkManager
+{
+public:
+    BenchmarkManager();
+    virtual ~BenchmarkManager();
+
+    void run(const string & filter);
+    void print() const;
+    void save(const string & filename) const;
+    void load(const string & filename);
+
+    static int addBenchmark(Benchmark*);
+
+private:
+    // minimal duration of a measurement, in seconds
+    static const double minTime;
+    // relative slowdown reported as a regression
+    static const double tolerance;
+
+    // warning: doesn't work if not ptr due to random static order init.
+    static vector<Benchmark*> * benchmarkLst;
+
+    vector<string> names;
+    vector<double> nanoseconds;
+    map<string, double> baseline;
+};
+
+// Defines a benchmark measured for both float and double, the body is a member template of Type.
+#define RUN_BENCHMARK(className) RUN_BENCHMARK_TYPES(className, float, double)
+
+// Same as RUN_BENCHMARK(), measured for the two given types.
+#define RUN_BENCHMARK_TYPES(className, Type1, Type2) \
+    template<typename Type> class className : public Benchmark{ \
+        public: \
+        className(const char * name) : Benchmark(name){} \
+        void run(); \
+        static int init(){ \
+            BenchmarkManager::addBenchmark(new className<Type1>(#className "<" #Type1 ">")); \
+            return BenchmarkManager::addBenchmark(new className<Type2>(#className "<" #Type2 ">")); } \
+    };\
+    static const int dummy_object##className = className<Type1>::init(); \
+    template<typename Type> void className<Type>::run()
+
+#endif
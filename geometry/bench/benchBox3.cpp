@@ -0,0 +1,112 @@
+#include <Benchmark.hpp>
+#include <gtl/box3.hpp>
+#include <gtl/xfbox3.hpp>
+#include <gtl/quat.hpp>
+
+using namespace gtl;
+
+enum { COUNT = 1024 };
+
+template<typename Type>
+static void randomInstances(std::vector< Box3<Type> > & boxes, std::vector< Matrix4<Type> > & matrices)
+{
+    for(int i = 0; i < COUNT; i++){
+        Vec3<Type> center((Type)Benchmark::uniform(-10, 10), (Type)Benchmark::uniform(-10, 10), (Type)Benchmark::uniform(-10, 10));
+        Vec3<Type> half((Type)Benchmark::uniform(0.1, 2), (Type)Benchmark::uniform(0.1, 2), (Type)Benchmark::uniform(0.1, 2));
+        boxes.push_back(Box3<Type>(center - half, center + half));
+
+        Vec3<Type> axis((Type)Benchmark::uniform(-1, 1), (Type)Benchmark::uniform(-1, 1), (Type)Benchmark::uniform(-1, 1));
+        axis.normalize();
+        Matrix4<Type> rotate, translate;
+        rotate.setRotate(Quat<Type>(axis, (Type)Benchmark::uniform(0, 360)));
+        translate.setTranslate(Vec3<Type>((Type)Benchmark::uniform(-10, 10), (Type)Benchmark::uniform(-10, 10), (Type)Benchmark::uniform(-10, 10)));
+        matrices.push_back(rotate * translate);
+    }
+}
+
+RUN_BENCHMARK(BenchBox3Transform)
+{
+    std::vector< Box3<Type> > boxes, out(COUNT);
+    std::vector< Matrix4<Type> > matrices;
+    randomInstances(boxes, matrices);
+
+    for(int i = 0; keepRunning(); i = (i + 1) & (COUNT - 1)){
+        out[i] = boxes[i];
+        out[i].transform(matrices[i]);
+    }
+    use(out[COUNT / 2].getMax()[0]);
+}
+
+// reported per box
+RUN_BENCHMARK(BenchBox3TransformMany)
+{
+    std::vector< Box3<Type> > boxes, out(COUNT);
+    std::vector< Matrix4<Type> > matrices;
+    randomInstances(boxes, matrices);
+    setItems(COUNT);
+
+    while(keepRunning()){
+        Box3<Type>::transformMany(&boxes[0], &matrices[0], &out[0], COUNT);
+    }
+    use(out[COUNT / 2].getMax()[0]);
+}
+
+// oriented boxes against each other, most pairs are apart
+RUN_BENCHMARK(BenchXfBox3Intersect)
+{
+    std::vector< Box3<Type> > boxes;
+    std::vector< Matrix4<Type> > matrices;
+    randomInstances(boxes, matrices);
+
+    std::vector< XfBox3<Type> > xfboxes;
+    for(int i = 0; i < COUNT; i++){
+        const Vec3<Type> center = boxes[i].getCenter();
+        xfboxes.push_back(XfBox3<Type>(boxes[i].getMin() - center, boxes[i].getMax() - center));
+        xfboxes.back().setTransform(matrices[i]);
+    }
+
+    std::size_t sum = 0;
+    for(int i = 0; keepRunning(); i = (i + 1) & (COUNT - 1)){
+        sum += xfboxes[i].intersect(xfboxes[(i * 7 + 1) & (COUNT - 1)]);
+    }
+    use((double)sum);
+}
+
+enum { POINTS = 1 << 20 };
+
+template<typename Type>
+static void randomPoints(std::vector< Vec3<Type> > & points)
+{
+    for(int i = 0; i < POINTS; i++){
+        points.push_back(Vec3<Type>((Type)Benchmark::uniform(-10, 10), (Type)Benchmark::uniform(-10, 10), (Type)Benchmark::uniform(-10, 10)));
+    }
+}
+
+// reported per point, the loop fromPoints() replaces
+RUN_BENCHMARK(BenchBox3ExtendBy)
+{
+    std::vector< Vec3<Type> > points;
+    randomPoints(points);
+    setItems(POINTS);
+
+    Box3<Type> box;
+    while(keepRunning()){
+        box.makeEmpty();
+        for(int i = 0; i < POINTS; i++) box.extendBy(points[i]);
+    }
+    use(box.getMax()[0]);
+}
+
+// reported per point
+RUN_BENCHMARK(BenchBox3FromPoints)
+{
+    std::vector< Vec3<Type> > points;
+    randomPoints(points);
+    setItems(POINTS);
+
+    Box3<Type> box;
+    while(keepRunning()){
+        box = Box3<Type>::fromPoints(points);
+    }
+    use(box.getMax()[0]);
+}
@@ -0,0 +1,79 @@
+#include <Benchmark.hpp>
+#include <gtl/curve2.hpp>
+
+#include <algorithm>
+
+using namespace gtl;
+
+enum { KNOTS = 1000, COUNT = 4096 };
+
+template<typename Type>
+static void randomCurve(Curve2<Type> & curve, typename Curve2<Type>::INTERPOL_TYPES interpol)
+{
+    std::vector< Vec2<Type> > pts;
+    Type x = 0;
+    for(int i = 0; i < KNOTS; i++){
+        pts.push_back(Vec2<Type>(x, (Type)sin((double)x)));
+        x += (Type)Benchmark::uniform(0.01, 0.1);
+    }
+    curve.setPoints(&pts[0], KNOTS);
+    curve.setInterpol(interpol);
+}
+
+// positions within the knots of randomCurve()
+template<typename Type>
+static void randomPositions(std::vector<Type> & xs)
+{
+    xs.resize(COUNT);
+    for(int i = 0; i < COUNT; i++) xs[i] = (Type)Benchmark::uniform(0, 10);
+}
+
+RUN_BENCHMARK(BenchCurve2Linear)
+{
+    Curve2<Type> curve;
+    randomCurve(curve, Curve2<Type>::INTERPOL_LINEAR);
+    std::vector<Type> xs;
+    randomPositions(xs);
+
+    Type sum = 0;
+    for(int i = 0; keepRunning(); i = (i + 1) & (COUNT - 1)){
+        Vec2<Type> pt;
+        curve.getPoint(xs[i], pt);
+        sum += pt[1];
+    }
+    use(sum);
+}
+
+RUN_BENCHMARK(BenchCurve2Akima)
+{
+    Curve2<Type> curve;
+    randomCurve(curve, Curve2<Type>::INTERPOL_AKIMA);
+    std::vector<Type> xs;
+    randomPositions(xs);
+
+    Type sum = 0;
+    for(int i = 0; keepRunning(); i = (i + 1) & (COUNT - 1)){
+        Vec2<Type> pt;
+        curve.getPoint(xs[i], pt);
+        sum += pt[1];
+    }
+    use(sum);
+}
+
+// sorted positions evaluated in one call, reported per position
+RUN_BENCHMARK(BenchCurve2AkimaBatch)
+{
+    Curve2<Type> curve;
+    randomCurve(curve, Curve2<Type>::INTERPOL_AKIMA);
+    std::vector<Type> xs, ys(COUNT);
+    randomPositions(xs);
+    std::sort(xs.begin(), xs.end());
+    setItems(COUNT);
+
+    Type sum = 0;
+    while(keepRunning()){
+        curve.getPoints(&xs[0], &ys[0], COUNT);
+        sum += ys[COUNT / 2];
+    }
+    use(sum);
+}
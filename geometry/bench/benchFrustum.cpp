@@ -0,0 +1,117 @@
+#include <Benchmark.hpp>
+#include <gtl/frustum.hpp>
+
+using namespace gtl;
+
+enum { INSTANCES = 65536 };
+
+// camera at the center of a field of instances, a quarter of them is visible
+template<typename Type>
+static Frustum<Type> camera()
+{
+    const Type f = (Type)1 / (Type)tan(0.6);
+    const Type znear = 1, zfar = 500;
+
+    Matrix4<Type> projection(f, 0, 0, 0,
+                             0, f, 0, 0,
+                             0, 0, (zfar + znear) / (znear - zfar), -1,
+                             0, 0, 2 * zfar * znear / (znear - zfar), 0);
+
+    return Frustum<Type>(projection);
+}
+
+template<typename Type>
+static void randomBoxes(std::vector< Box3<Type> > & boxes)
+{
+    for(int i = 0; i < INSTANCES; i++){
+        Vec3<Type> lo((Type)Benchmark::uniform(-100, 100), (Type)Benchmark::uniform(-100, 100), (Type)Benchmark::uniform(-100, 100));
+        boxes.push_back(Box3<Type>(lo, lo + Vec3<Type>((Type)Benchmark::uniform(0, 2), (Type)Benchmark::uniform(0, 2), (Type)Benchmark::uniform(0, 2))));
+    }
+}
+
+// six planes tested by hand per box, as before the frustum
+RUN_BENCHMARK(BenchFrustumPlanes)
+{
+    std::vector< Box3<Type> > boxes;
+    randomBoxes(boxes);
+
+    const Frustum<Type> frustum = camera<Type>();
+    std::vector<unsigned char> results(INSTANCES);
+
+    setItems(INSTANCES);
+
+    std::size_t sum = 0;
+    while(keepRunning()){
+        for(int i = 0; i < INSTANCES; i++){
+            const Box3<Type> & box = boxes[i];
+            bool visible = true;
+
+            for(int p = 0; p < 6 && visible; p++){
+                const Plane<Type> & plane = frustum.getPlane(p);
+                const Vec3<Type> & n = plane.getNormal();
+                Vec3<Type> corner(n[0] > 0 ? box.getMax()[0] : box.getMin()[0],
+                                  n[1] > 0 ? box.getMax()[1] : box.getMin()[1],
+                                  n[2] > 0 ? box.getMax()[2] : box.getMin()[2]);
+                visible = plane.isInHalfSpace(corner);
+            }
+            results[i] = visible;
+            sum += visible;
+        }
+    }
+    use((double)sum);
+}
+
+RUN_BENCHMARK(BenchFrustumBoxes)
+{
+    std::vector< Box3<Type> > boxes;
+    randomBoxes(boxes);
+
+    const Frustum<Type> frustum = camera<Type>();
+    std::vector<unsigned char> results(INSTANCES);
+
+    setItems(INSTANCES);
+
+    std::size_t sum = 0;
+    while(keepRunning()){
+        sum += frustum.cull(&boxes[0], INSTANCES, &results[0]);
+    }
+    use((double)sum);
+}
+
+// the plane which rejected a box last is tested first
+RUN_BENCHMARK(BenchFrustumBoxesHints)
+{
+    std::vector< Box3<Type> > boxes;
+    randomBoxes(boxes);
+
+    const Frustum<Type> frustum = camera<Type>();
+    std::vector<unsigned char> results, hints;
+
+    setItems(INSTANCES);
+
+    std::size_t sum = 0;
+    while(keepRunning()){
+        sum += frustum.cull(boxes, results, hints);
+    }
+    use((double)sum);
+}
+
+RUN_BENCHMARK(BenchFrustumSpheresHints)
+{
+    std::vector< Sphere<Type> > spheres;
+    for(int i = 0; i < INSTANCES; i++){
+        Vec3<Type> center((Type)Benchmark::uniform(-100, 100), (Type)Benchmark::uniform(-100, 100), (Type)Benchmark::uniform(-100, 100));
+        spheres.push_back(Sphere<Type>(center, (Type)Benchmark::uniform(0, 1)));
+    }
+
+    const Frustum<Type> frustum = camera<Type>();
+    std::vector<unsigned char> results, hints;
+
+    setItems(INSTANCES);
+
+    std::size_t sum = 0;
+    while(keepRunning()){
+        sum += frustum.cull(spheres, results, hints);
+    }
+    use((double)sum);
+}
@@ -0,0 +1,36 @@
+#include <Benchmark.hpp>
+#include <gtl/gtl.hpp>
+#include <cmath>
+
+using namespace gtl;
+
+enum { COUNT = 1024 };
+
+// Squaring the way the former SQR macro did, through the double pow().
+RUN_BENCHMARK_TYPES(BenchSqrPow, float, int)
+{
+    std::vector<Type> a(COUNT);
+    for(int i = 0; i < COUNT; i++){
+        a[i] = (Type)uniform(-100, 100);
+    }
+
+    Type sum = 0;
+    for(int i = 0; keepRunning(); i = (i + 1) & (COUNT - 1)){
+        sum += (Type)pow((double)a[i], 2.0);
+    }
+    use(sum);
+}
+
+RUN_BENCHMARK_TYPES(BenchSqr, float, int)
+{
+    std::vector<Type> a(COUNT);
+    for(int i = 0; i < COUNT; i++){
+        a[i] = (Type)uniform(-100, 100);
+    }
+
+    Type sum = 0;
+    for(int i = 0; keepRunning(); i = (i + 1) & (COUNT - 1)){
+        sum += sqr(a[i]);
+    }
+    use(sum);
+}
@@ -0,0 +1,78 @@
+#include <Benchmark.hpp>
+#include <gtl/ray.hpp>
+#include <gtl/box3.hpp>
+#include <gtl/sphere.hpp>
+#include <gtl/plane.hpp>
+
+using namespace gtl;
+
+enum { COUNT = 1024 };
+
+// rays starting around the unit cube and aiming at it, roughly half of them hit
+template<typename Type>
+static void randomRays(std::vector< Ray<Type> > & rays)
+{
+    for(int i = 0; i < COUNT; i++){
+        Vec3<Type> origin((Type)Benchmark::uniform(-5, 5), (Type)Benchmark::uniform(-5, 5), (Type)Benchmark::uniform(-5, 5));
+        Vec3<Type> target((Type)Benchmark::uniform(-1.5, 1.5), (Type)Benchmark::uniform(-1.5, 1.5), (Type)Benchmark::uniform(-1.5, 1.5));
+        Vec3<Type> direction = target - origin;
+        direction.normalize();
+        rays.push_back(Ray<Type>(origin, direction));
+    }
+}
+
+RUN_BENCHMARK(BenchBox3Ray)
+{
+    std::vector< Ray<Type> > rays;
+    randomRays(rays);
+    Box3<Type> box(Vec3<Type>(-1, -1, -1), Vec3<Type>(1, 1, 1));
+
+    Type sum = 0;
+    for(int i = 0; keepRunning(); i = (i + 1) & (COUNT - 1)){
+        Type tmin, tmax;
+        if(box.intersect(rays[i], tmin, tmax)) sum += tmin;
+    }
+    use(sum);
+}
+
+RUN_BENCHMARK(BenchSphereRay)
+{
+    std::vector< Ray<Type> > rays;
+    randomRays(rays);
+    Sphere<Type> sphere(Vec3<Type>(0, 0, 0), 1);
+
+    Type sum = 0;
+    for(int i = 0; keepRunning(); i = (i + 1) & (COUNT - 1)){
+        Type t0, t1;
+        if(sphere.intersect(rays[i], t0, t1)) sum += t0;
+    }
+    use(sum);
+}
+
+RUN_BENCHMARK(BenchPlaneRay)
+{
+    std::vector< Ray<Type> > rays;
+    randomRays(rays);
+    Plane<Type> plane(Vec3<Type>(0, 0, 1), (Type)0.5);
+
+    Type sum = 0;
+    for(int i = 0; keepRunning(); i = (i + 1) & (COUNT - 1)){
+        Type t;
+        if(plane.intersect(rays[i], t)) sum += t;
+    }
+    use(sum);
+}
+
+RUN_BENCHMARK(BenchTriangleRay)
+{
+    std::vector< Ray<Type> > rays;
+    randomRays(rays);
+    Vec3<Type> v0(-1, -1, 0), v1(1, -1, 0), v2(0, 1, 0);
+
+    Type sum = 0;
+    for(int i = 0; keepRunning(); i = (i + 1) & (COUNT - 1)){
+        Vec3<Type> tuv;
+        if(rays[i].intersect(v0, v1, v2, tuv)) sum += tuv[0];
+    }
+    use(sum);
+}
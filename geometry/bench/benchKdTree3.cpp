@@ -0,0 +1,86 @@
+#include <Benchmark.hpp>
+#include <gtl/kdtree3.hpp>
+
+using namespace gtl;
+
+enum { COUNT = 1024, POINTS = 100000, K = 8 };
+
+template<typename Type>
+static void randomPoints(std::vector< Vec3<Type> > & points, int n)
+{
+    for(int i = 0; i < n; i++){
+        points.push_back(Vec3<Type>((Type)Benchmark::uniform(0, 100), (Type)Benchmark::uniform(0, 100), (Type)Benchmark::uniform(0, 100)));
+    }
+}
+
+RUN_BENCHMARK(BenchKdTree3Build)
+{
+    std::vector< Vec3<Type> > points;
+    randomPoints(points, POINTS);
+
+    KdTree3<Type> tree;
+
+    setItems(POINTS);
+
+    std::size_t sum = 0;
+    while(keepRunning()){
+        tree.build(points);
+        sum += tree.size();
+    }
+    use((double)sum);
+}
+
+RUN_BENCHMARK(BenchKdTree3Nearest)
+{
+    std::vector< Vec3<Type> > points, queries;
+    randomPoints(points, POINTS);
+    randomPoints(queries, COUNT);
+
+    KdTree3<Type> tree(points);
+    std::vector< typename KdTree3<Type>::Neighbor > neighbors;
+
+    Type sum = 0;
+    for(int i = 0; keepRunning(); i = (i + 1) & (COUNT - 1)){
+        tree.findNearest(queries[i], K, neighbors);
+        sum += neighbors[0].sqr_distance;
+    }
+    use(sum);
+}
+
+// the batch runs on all the threads
+RUN_BENCHMARK(BenchKdTree3NearestBatch)
+{
+    std::vector< Vec3<Type> > points, queries;
+    randomPoints(points, POINTS);
+    randomPoints(queries, COUNT);
+
+    KdTree3<Type> tree(points);
+    std::vector<int> indices;
+    std::vector<Type> sqr_distances;
+
+    setItems(COUNT);
+
+    Type sum = 0;
+    while(keepRunning()){
+        tree.findNearest(queries, K, indices, sqr_distances);
+        sum += sqr_distances[0];
+    }
+    use(sum);
+}
+
+RUN_BENCHMARK(BenchKdTree3Radius)
+{
+    std::vector< Vec3<Type> > points, queries;
+    randomPoints(points, POINTS);
+    randomPoints(queries, COUNT);
+
+    KdTree3<Type> tree(points);
+    std::vector<unsigned int> indices;
+
+    std::size_t sum = 0;
+    for(int i = 0; keepRunning(); i = (i + 1) & (COUNT - 1)){
+        indices.clear();
+        sum += tree.findRadius(queries[i], (Type)3, indices);
+    }
+    use((double)sum);
+}
@@ -0,0 +1,157 @@
+#include <Benchmark.hpp>
+#include <gtl/matrix3.hpp>
+#include <gtl/matrix4.hpp>
+#include <gtl/affine3.hpp>
+#include <gtl/quat.hpp>
+
+using namespace gtl;
+
+enum { COUNT = 256 };
+
+// random rotation, scale and translation
+template<typename Type>
+static Matrix4<Type> randomMatrix4()
+{
+    Vec3<Type> axis((Type)Benchmark::uniform(-1, 1), (Type)Benchmark::uniform(-1, 1), (Type)Benchmark::uniform(-1, 1));
+    axis.normalize();
+
+    Matrix4<Type> rotate, scale, translate;
+    rotate.setRotate(Quat<Type>(axis, (Type)Benchmark::uniform(0, 360)));
+    scale.setScale((Type)Benchmark::uniform(0.5, 2));
+    translate.setTranslate(Vec3<Type>((Type)Benchmark::uniform(-10, 10), (Type)Benchmark::uniform(-10, 10), (Type)Benchmark::uniform(-10, 10)));
+
+    return rotate * scale * translate;
+}
+
+template<typename Type>
+static Matrix3<Type> randomMatrix3()
+{
+    Vec3<Type> axis((Type)Benchmark::uniform(-1, 1), (Type)Benchmark::uniform(-1, 1), (Type)Benchmark::uniform(-1, 1));
+    axis.normalize();
+
+    Matrix3<Type> rotate, scale;
+    rotate.setRotate(Quat<Type>(axis, (Type)Benchmark::uniform(0, 360)));
+    scale.setScale((Type)Benchmark::uniform(0.5, 2));
+
+    return rotate * scale;
+}
+
+RUN_BENCHMARK(BenchMatrix3Mult)
+{
+    std::vector< Matrix3<Type> > a(COUNT), b(COUNT), c(COUNT);
+    for(int i = 0; i < COUNT; i++){
+        a[i] = randomMatrix3<Type>();
+        b[i] = randomMatrix3<Type>();
+    }
+
+    for(int i = 0; keepRunning(); i = (i + 1) & (COUNT - 1)){
+        c[i] = a[i] * b[i];
+    }
+    use(c[COUNT / 2][1][2]);
+}
+
+RUN_BENCHMARK(BenchMatrix3Inverse)
+{
+    std::vector< Matrix3<Type> > a(COUNT), c(COUNT);
+    for(int i = 0; i < COUNT; i++) a[i] = randomMatrix3<Type>();
+
+    for(int i = 0; keepRunning(); i = (i + 1) & (COUNT - 1)){
+        c[i] = a[i].inverse();
+    }
+    use(c[COUNT / 2][1][2]);
+}
+
+RUN_BENCHMARK(BenchMatrix4Mult)
+{
+    std::vector< Matrix4<Type> > a(COUNT), b(COUNT), c(COUNT);
+    for(int i = 0; i < COUNT; i++){
+        a[i] = randomMatrix4<Type>();
+        b[i] = randomMatrix4<Type>();
+    }
+
+    for(int i = 0; keepRunning(); i = (i + 1) & (COUNT - 1)){
+        c[i] = a[i] * b[i];
+    }
+    use(c[COUNT / 2][3][2]);
+}
+
+RUN_BENCHMARK(BenchMatrix4Inverse)
+{
+    std::vector< Matrix4<Type> > a(COUNT), c(COUNT);
+    for(int i = 0; i < COUNT; i++) a[i] = randomMatrix4<Type>();
+
+    for(int i = 0; keepRunning(); i = (i + 1) & (COUNT - 1)){
+        c[i] = a[i].inverse();
+    }
+    use(c[COUNT / 2][3][2]);
+}
+
+RUN_BENCHMARK(BenchMatrix4Det)
+{
+    std::vector< Matrix4<Type> > a(COUNT);
+    std::vector<Type> c(COUNT);
+    for(int i = 0; i < COUNT; i++) a[i] = randomMatrix4<Type>();
+
+    for(int i = 0; keepRunning(); i = (i + 1) & (COUNT - 1)){
+        c[i] = a[i].det4();
+    }
+    use(c[COUNT / 2]);
+}
+
+RUN_BENCHMARK(BenchMatrix4MultVec)
+{
+    Matrix4<Type> m = randomMatrix4<Type>();
+    std::vector< Vec3<Type> > a(COUNT);
+    for(int i = 0; i < COUNT; i++){
+        a[i].setValue((Type)uniform(-1, 1), (Type)uniform(-1, 1), (Type)uniform(-1, 1));
+    }
+
+    Type sum = 0;
+    for(int i = 0; keepRunning(); i = (i + 1) & (COUNT - 1)){
+        Vec3<Type> v;
+        m.multVecMatrix(a[i], v);
+        sum += v[0];
+    }
+    use(sum);
+}
+
+RUN_BENCHMARK(BenchAffine3Mult)
+{
+    std::vector< Affine3<Type> > a(COUNT), b(COUNT), c(COUNT);
+    for(int i = 0; i < COUNT; i++){
+        a[i].setValue(randomMatrix4<Type>());
+        b[i].setValue(randomMatrix4<Type>());
+    }
+
+    for(int i = 0; keepRunning(); i = (i + 1) & (COUNT - 1)){
+        c[i] = a[i] * b[i];
+    }
+    use(c[COUNT / 2].getTranslation()[2]);
+}
+
+RUN_BENCHMARK(BenchAffine3Inverse)
+{
+    std::vector< Affine3<Type> > a(COUNT), c(COUNT);
+    for(int i = 0; i < COUNT; i++) a[i].setValue(randomMatrix4<Type>());
+
+    for(int i = 0; keepRunning(); i = (i + 1) & (COUNT - 1)){
+        c[i] = a[i].inverse();
+    }
+    use(c[COUNT / 2].getTranslation()[2]);
+}
+
+// reported per product
+RUN_BENCHMARK(BenchMatrix4MultiplyMany)
+{
+    std::vector< Matrix4<Type> > a(COUNT), b(COUNT), c(COUNT);
+    for(int i = 0; i < COUNT; i++){
+        a[i] = randomMatrix4<Type>();
+        b[i] = randomMatrix4<Type>();
+    }
+    setItems(COUNT);
+
+    while(keepRunning()){
+        Matrix4<Type>::multiplyMany(&a[0], &b[0], &c[0], COUNT);
+    }
+    use(c[COUNT / 2][3][2]);
+}
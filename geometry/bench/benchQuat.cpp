@@ -0,0 +1,50 @@
+#include <Benchmark.hpp>
+#include <gtl/quat.hpp>
+
+using namespace gtl;
+
+enum { COUNT = 1024 };
+
+template<typename Type>
+static Quat<Type> randomQuat()
+{
+    Vec3<Type> axis((Type)Benchmark::uniform(-1, 1), (Type)Benchmark::uniform(-1, 1), (Type)Benchmark::uniform(-1, 1));
+    axis.normalize();
+
+    return Quat<Type>(axis, (Type)Benchmark::uniform(0, 360));
+}
+
+RUN_BENCHMARK(BenchQuatSlerp)
+{
+    std::vector< Quat<Type> > a(COUNT), b(COUNT);
+    std::vector<Type> t(COUNT);
+    for(int i = 0; i < COUNT; i++){
+        a[i] = randomQuat<Type>();
+        b[i] = randomQuat<Type>();
+        t[i] = (Type)uniform(0, 1);
+    }
+
+    Type sum = 0;
+    for(int i = 0; keepRunning(); i = (i + 1) & (COUNT - 1)){
+        sum += Quat<Type>::slerp(a[i], b[i], t[i]).getValue()[0];
+    }
+    use(sum);
+}
+
+RUN_BENCHMARK(BenchQuatMultVec)
+{
+    std::vector< Quat<Type> > q(COUNT);
+    std::vector< Vec3<Type> > a(COUNT);
+    for(int i = 0; i < COUNT; i++){
+        q[i] = randomQuat<Type>();
+        a[i].setValue((Type)uniform(-1, 1), (Type)uniform(-1, 1), (Type)uniform(-1, 1));
+    }
+
+    Type sum = 0;
+    for(int i = 0; keepRunning(); i = (i + 1) & (COUNT - 1)){
+        Vec3<Type> v;
+        q[i].multVec(a[i], v);
+        sum += v[0];
+    }
+    use(sum);
+}
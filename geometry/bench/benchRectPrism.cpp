@@ -0,0 +1,69 @@
+#include <Benchmark.hpp>
+#include <gtl/rectprism.hpp>
+#include <gtl/matrix4.hpp>
+#include <gtl/quat.hpp>
+
+using namespace gtl;
+
+// counts the voxels of the runs produced by the voxelizer
+struct CountSink
+{
+    CountSink() : count(0) {}
+
+    void operator()(int, int, int k0, int k1){ count += k1 - k0 + 1; }
+
+    long count;
+};
+
+// a rotated box of 2 x 1 x 0.5
+template<typename Type>
+static void rotatedPrism(RectPrism<Type> & prism)
+{
+    Matrix4<Type> m;
+    Vec3<Type> axis(1, 2, 3);
+    axis.normalize();
+    m.setRotate(Quat<Type>(axis, 30));
+
+    Vec3<Type> pts[8];
+    for(int i = 0; i < 8; i++){
+        Vec3<Type> p((Type)(i & 1 ? 1.0 : -1.0), (Type)(i & 2 ? 0.5 : -0.5), (Type)(i & 4 ? 0.25 : -0.25));
+        m.multVecMatrix(p, pts[i]);
+    }
+    prism.setVertices(pts);
+}
+
+// reported per voxel
+RUN_BENCHMARK(BenchRectPrismVoxelize)
+{
+    RectPrism<Type> prism;
+    rotatedPrism(prism);
+
+    CountSink first;
+    prism.voxelize(0.02, first);
+    setItems((int)first.count);
+
+    long sum = 0;
+    while(keepRunning()){
+        CountSink sink;
+        prism.voxelize(0.02, sink);
+        sum += sink.count;
+    }
+    use((double)sum);
+}
+
+RUN_BENCHMARK(BenchRectPrismVoxelizeGrid)
+{
+    RectPrism<Type> prism;
+    rotatedPrism(prism);
+
+    BitGrid3 grid;
+    prism.voxelize(0.02, grid);
+    setItems((int)grid.count());
+
+    long sum = 0;
+    while(keepRunning()){
+        prism.voxelize(0.02, grid);
+        sum += grid.getSize()[0];
+    }
+    use((double)sum);
+}
@@ -0,0 +1,40 @@
+#include <Benchmark.hpp>
+#include <gtl/spatialhash.hpp>
+
+using namespace gtl;
+
+enum { PARTICLES = 16384 };
+
+// collision stage: move the particles a little and find the overlapping pairs,
+// compare with BenchSphereTreeOverlaps
+RUN_BENCHMARK(BenchSpatialHashOverlaps)
+{
+    std::vector< Sphere<Type> > spheres;
+    std::vector< Vec3<Type> > velocities;
+
+    for(int i = 0; i < PARTICLES; i++){
+        Vec3<Type> center((Type)Benchmark::uniform(0, 40), (Type)Benchmark::uniform(0, 40), (Type)Benchmark::uniform(0, 40));
+        spheres.push_back(Sphere<Type>(center, (Type)0.5));
+        velocities.push_back(Vec3<Type>((Type)Benchmark::uniform(-0.01, 0.01), (Type)Benchmark::uniform(-0.01, 0.01), (Type)Benchmark::uniform(-0.01, 0.01)));
+    }
+
+    SpatialHash<Type> hash;
+    for(int i = 0; i < PARTICLES; i++) hash.insert(spheres[i]);
+
+    std::vector< typename SpatialHash<Type>::Pair > pairs;
+
+    setItems(PARTICLES);
+
+    std::size_t sum = 0;
+    for(int step = 0; keepRunning(); step++){
+        const Type sign = (step & 64) ? (Type)-1 : (Type)1;
+
+        for(int i = 0; i < PARTICLES; i++){
+            spheres[i].setCenter(spheres[i].getCenter() + sign * velocities[i]);
+            hash.move(i, spheres[i]);
+        }
+        pairs.clear();
+        sum += hash.getOverlaps(pairs);
+    }
+    use((double)sum);
+}
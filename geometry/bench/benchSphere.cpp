@@ -0,0 +1,49 @@
+#include <Benchmark.hpp>
+#include <gtl/sphere.hpp>
+
+using namespace gtl;
+
+enum { POINTS = 100000 };
+
+template<typename Type>
+static void randomPoints(std::vector< Vec3<Type> > & points)
+{
+    for(int i = 0; i < POINTS; i++){
+        points.push_back(Vec3<Type>((Type)Benchmark::uniform(-1, 1), (Type)Benchmark::uniform(-2, 2), (Type)Benchmark::uniform(-3, 3)));
+    }
+}
+
+// exact smallest sphere
+RUN_BENCHMARK(BenchSphereCircumscribe)
+{
+    std::vector< Vec3<Type> > points;
+    randomPoints(points);
+
+    setItems(POINTS);
+
+    Sphere<Type> sphere;
+    double sum = 0.0;
+    while(keepRunning()){
+        sphere.circumscribe(points);
+        sum += sphere.getRadius();
+    }
+    use(sum);
+}
+
+// single pass approximation
+RUN_BENCHMARK(BenchSphereExtendBy)
+{
+    std::vector< Vec3<Type> > points;
+    randomPoints(points);
+
+    setItems(POINTS);
+
+    Sphere<Type> sphere;
+    double sum = 0.0;
+    while(keepRunning()){
+        sphere.makeEmpty();
+        sphere.extendBy(&points[0], points.size());
+        sum += sphere.getRadius();
+    }
+    use(sum);
+}
@@ -0,0 +1,78 @@
+#include <Benchmark.hpp>
+#include <gtl/spheretree.hpp>
+
+using namespace gtl;
+
+enum { COUNT = 1024, PARTICLES = 16384 };
+
+// particles of radius 0.5 in a box where each one overlaps a few others
+template<typename Type>
+static void randomParticles(std::vector< Sphere<Type> > & spheres)
+{
+    const double size = 40.0;
+
+    for(int i = 0; i < PARTICLES; i++){
+        Vec3<Type> center((Type)Benchmark::uniform(0, size), (Type)Benchmark::uniform(0, size), (Type)Benchmark::uniform(0, size));
+        spheres.push_back(Sphere<Type>(center, (Type)0.5));
+    }
+}
+
+// collision stage: refit the moving particles and find the overlapping pairs
+RUN_BENCHMARK(BenchSphereTreeOverlaps)
+{
+    std::vector< Sphere<Type> > spheres;
+    randomParticles(spheres);
+
+    SphereTree<Type> tree(spheres);
+    std::vector< std::pair<unsigned int, unsigned int> > pairs;
+
+    setItems(PARTICLES);
+
+    std::size_t sum = 0;
+    while(keepRunning()){
+        tree.refit(spheres);
+        pairs.clear();
+        sum += tree.getOverlaps(pairs);
+    }
+    use((double)sum);
+}
+
+RUN_BENCHMARK(BenchSphereTreeBuild)
+{
+    std::vector< Sphere<Type> > spheres;
+    randomParticles(spheres);
+
+    SphereTree<Type> tree;
+
+    setItems(PARTICLES);
+
+    std::size_t sum = 0;
+    while(keepRunning()){
+        tree.build(spheres);
+        sum += tree.getNumNodes();
+    }
+    use((double)sum);
+}
+
+RUN_BENCHMARK(BenchSphereTreeRay)
+{
+    std::vector< Sphere<Type> > spheres;
+    randomParticles(spheres);
+
+    SphereTree<Type> tree(spheres);
+
+    std::vector< Ray<Type> > rays;
+    for(int i = 0; i < COUNT; i++){
+        Vec3<Type> origin((Type)Benchmark::uniform(-10, 50), (Type)Benchmark::uniform(-10, 50), (Type)-10);
+        Vec3<Type> target((Type)Benchmark::uniform(0, 40), (Type)Benchmark::uniform(0, 40), (Type)40);
+        rays.push_back(Ray<Type>(origin, target - origin));
+    }
+
+    Type sum = 0;
+    for(int i = 0; keepRunning(); i = (i + 1) & (COUNT - 1)){
+        int sphere;
+        Type t;
+        if(tree.intersect(rays[i], sphere, t)) sum += t;
+    }
+    use(sum);
+}
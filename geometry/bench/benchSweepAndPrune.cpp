@@ -0,0 +1,76 @@
+#include <Benchmark.hpp>
+#include <gtl/sweepandprune.hpp>
+#include <gtl/spatialhash.hpp>
+
+using namespace gtl;
+
+enum { OBJECTS = 16384 };
+
+// thin sticks of random length along x, the grid cells follow the average length
+template<typename Type>
+static void randomSticks(std::vector< Box3<Type> > & boxes, std::vector< Vec3<Type> > & velocities)
+{
+    for(int i = 0; i < OBJECTS; i++){
+        Vec3<Type> lo((Type)Benchmark::uniform(0, 100), (Type)Benchmark::uniform(0, 100), (Type)Benchmark::uniform(0, 100));
+        Vec3<Type> size((Type)Benchmark::uniform(0, 8), (Type)0.2, (Type)0.2);
+        boxes.push_back(Box3<Type>(lo, lo + size));
+        velocities.push_back(Vec3<Type>((Type)Benchmark::uniform(-0.01, 0.01), (Type)Benchmark::uniform(-0.01, 0.01), (Type)Benchmark::uniform(-0.01, 0.01)));
+    }
+}
+
+// collision stage of moving sticks, compare with BenchSweepAndPruneHash
+RUN_BENCHMARK(BenchSweepAndPrune)
+{
+    std::vector< Box3<Type> > boxes;
+    std::vector< Vec3<Type> > velocities;
+    randomSticks(boxes, velocities);
+
+    SweepAndPrune<Type> sap;
+    for(int i = 0; i < OBJECTS; i++) sap.insert(boxes[i]);
+
+    std::vector< typename SweepAndPrune<Type>::Pair > pairs;
+
+    setItems(OBJECTS);
+
+    std::size_t sum = 0;
+    for(int step = 0; keepRunning(); step++){
+        const Type sign = (step & 64) ? (Type)-1 : (Type)1;
+
+        for(int i = 0; i < OBJECTS; i++){
+            const Vec3<Type> offset = sign * velocities[i];
+            boxes[i].setBounds(boxes[i].getMin() + offset, boxes[i].getMax() + offset);
+            sap.move(i, boxes[i]);
+        }
+        pairs.clear();
+        sum += sap.getOverlaps(pairs);
+    }
+    use((double)sum);
+}
+
+RUN_BENCHMARK(BenchSweepAndPruneHash)
+{
+    std::vector< Box3<Type> > boxes;
+    std::vector< Vec3<Type> > velocities;
+    randomSticks(boxes, velocities);
+
+    SpatialHash<Type> hash;
+    for(int i = 0; i < OBJECTS; i++) hash.insert(boxes[i]);
+
+    std::vector< typename SpatialHash<Type>::Pair > pairs;
+
+    setItems(OBJECTS);
+
+    std::size_t sum = 0;
+    for(int step = 0; keepRunning(); step++){
+        const Type sign = (step & 64) ? (Type)-1 : (Type)1;
+
+        for(int i = 0; i < OBJECTS; i++){
+            const Vec3<Type> offset = sign * velocities[i];
+            boxes[i].setBounds(boxes[i].getMin() + offset, boxes[i].getMax() + offset);
+            hash.move(i, boxes[i]);
+        }
+        pairs.clear();
+        sum += hash.getOverlaps(pairs);
+    }
+    use((double)sum);
+}
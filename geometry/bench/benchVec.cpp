@@ -0,0 +1,83 @@
+#include <Benchmark.hpp>
+#include <gtl/vec2.hpp>
+#include <gtl/vec3.hpp>
+#include <gtl/vec4.hpp>
+
+using namespace gtl;
+
+enum { COUNT = 1024 };
+
+RUN_BENCHMARK(BenchVec2Dot)
+{
+    std::vector< Vec2<Type> > a(COUNT), b(COUNT);
+    for(int i = 0; i < COUNT; i++){
+        a[i].setValue((Type)uniform(-1, 1), (Type)uniform(-1, 1));
+        b[i].setValue((Type)uniform(-1, 1), (Type)uniform(-1, 1));
+    }
+
+    Type sum = 0;
+    for(int i = 0; keepRunning(); i = (i + 1) & (COUNT - 1)){
+        sum += a[i].dot(b[i]);
+    }
+    use(sum);
+}
+
+RUN_BENCHMARK(BenchVec3Dot)
+{
+    std::vector< Vec3<Type> > a(COUNT), b(COUNT);
+    for(int i = 0; i < COUNT; i++){
+        a[i].setValue((Type)uniform(-1, 1), (Type)uniform(-1, 1), (Type)uniform(-1, 1));
+        b[i].setValue((Type)uniform(-1, 1), (Type)uniform(-1, 1), (Type)uniform(-1, 1));
+    }
+
+    Type sum = 0;
+    for(int i = 0; keepRunning(); i = (i + 1) & (COUNT - 1)){
+        sum += a[i].dot(b[i]);
+    }
+    use(sum);
+}
+
+RUN_BENCHMARK(BenchVec3Cross)
+{
+    std::vector< Vec3<Type> > a(COUNT), b(COUNT);
+    for(int i = 0; i < COUNT; i++){
+        a[i].setValue((Type)uniform(-1, 1), (Type)uniform(-1, 1), (Type)uniform(-1, 1));
+        b[i].setValue((Type)uniform(-1, 1), (Type)uniform(-1, 1), (Type)uniform(-1, 1));
+    }
+
+    Vec3<Type> sum(0, 0, 0);
+    for(int i = 0; keepRunning(); i = (i + 1) & (COUNT - 1)){
+        sum += a[i].cross(b[i]);
+    }
+    use(sum[0] + sum[1] + sum[2]);
+}
+
+RUN_BENCHMARK(BenchVec3Normalize)
+{
+    std::vector< Vec3<Type> > a(COUNT);
+    for(int i = 0; i < COUNT; i++){
+        a[i].setValue((Type)uniform(-1, 1), (Type)uniform(-1, 1), (Type)uniform(-1, 1));
+    }
+
+    Type sum = 0;
+    for(int i = 0; keepRunning(); i = (i + 1) & (COUNT - 1)){
+        Vec3<Type> v = a[i];
+        sum += v.normalize() + v[0];
+    }
+    use(sum);
+}
+
+RUN_BENCHMARK(BenchVec4Dot)
+{
+    std::vector< Vec4<Type> > a(COUNT), b(COUNT);
+    for(int i = 0; i < COUNT; i++){
+        a[i].setValue((Type)uniform(-1, 1), (Type)uniform(-1, 1), (Type)uniform(-1, 1), (Type)uniform(-1, 1));
+        b[i].setValue((Type)uniform(-1, 1), (Type)uniform(-1, 1), (Type)uniform(-1, 1), (Type)uniform(-1, 1));
+    }
+
+    Type sum = 0;
+    for(int i = 0; keepRunning(); i = (i + 1) & (COUNT - 1)){
+        sum += a[i].dot(b[i]);
+    }
+    use(sum);
+}
@@ -0,0 +1,21 @@
+#include <stdlib.h>
+#include <iostream>
+
+#include <Benchmark.hpp>
+
+using namespace std;
+
+// usage: bench [filter]
+// The timings are compared to baseline.txt when it exists and saved to bench.txt,
+// copy bench.txt over baseline.txt to track a new baseline.
+int main(int argc, char ** argv)
+{
+    BenchmarkManager benchMngr;
+
+    benchMngr.load("baseline.txt");
+    benchMngr.run(argc > 1 ? argv[1] : "");
+    benchMngr.print();
+    benchMngr.save("bench.txt");
+
+    return 0;
+}
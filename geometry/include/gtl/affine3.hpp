@@ -0,0 +1,310 @@
+/*
+_______________________________________________________________________
+__________________________ G E O M E T R Y ____________________________
+|
+| THIS FILE IS PART OF THE GEOMETRY TEMPLATE LIBRARY.
+| USE, DISTRIBUTION AND REPRODUCTION OF THIS LIBRARY SOURCE IS
+| GOVERNED BY A BSD-STYLE SOURCE LICENSE.
+| PLEASE READ THESE TERMS BEFORE DISTRIBUTING.
+_______________________________________________________________________
+_______________________________________________________________________
+*/
+
+#ifndef AFFINE3_H
+#define AFFINE3_H
+
+#include <gtl/gtl.hpp>
+#include <gtl/vec3.hpp>
+#include <gtl/matrix3.hpp>
+#include <gtl/matrix4.hpp>
+#include <gtl/quat.hpp>
+
+namespace gtl
+{
+    /*!
+    \class Affine3 Affine3.hpp geometry/Affine3.hpp
+    \brief Affine transformation made of a 3x3 linear part and a translation.
+    \ingroup base
+
+    The transformation follows the row vector convention of Matrix4: a point \a p is
+    mapped to p * L + t, where \a L is the linear part and \a t the translation, so that
+    the equivalent Matrix4 has \a L in its upper left 3x3 block and \a t in its last row.
+
+    Composing, inverting and transforming points skip the projective row and column of
+    Matrix4, and never divide by w.
+
+    \sa Matrix4, Matrix3
+    */
+    template<typename Type>
+    class Affine3
+    {
+    public:
+        //! The default constructor makes the identity transformation.
+        Affine3() : m_translation(0, 0, 0)
+        {
+        }
+
+        //! Constructs a transformation from its linear part and its translation.
+        Affine3(const Matrix3<Type> & a_linear, const Vec3<Type> & a_translation) : m_linear(a_linear), m_translation(a_translation)
+        {
+        }
+
+        //! Constructs a transformation from the affine matrix \a a_matrix. \sa setValue().
+        explicit Affine3(const Matrix4<Type> & a_matrix)
+        {
+            setValue(a_matrix);
+        }
+
+        //! Takes the upper left 3x3 block and the last row of \a a_matrix. The last column is assumed to be (0, 0, 0, 1), see Matrix4::isAffine().
+        void setValue(const Matrix4<Type> & a_matrix)
+        {
+            m_linear = Matrix3<Type>(a_matrix[0][0], a_matrix[0][1], a_matrix[0][2],
+                                     a_matrix[1][0], a_matrix[1][1], a_matrix[1][2],
+                                     a_matrix[2][0], a_matrix[2][1], a_matrix[2][2]);
+            m_translation.setValue(a_matrix[3][0], a_matrix[3][1], a_matrix[3][2]);
+        }
+
+        //! Return the equivalent 4x4 matrix.
+        Matrix4<Type> getMatrix() const
+        {
+            return Matrix4<Type>(m_linear[0][0], m_linear[0][1], m_linear[0][2], (Type)0.0,
+                                 m_linear[1][0], m_linear[1][1], m_linear[1][2], (Type)0.0,
+                                 m_linear[2][0], m_linear[2][1], m_linear[2][2], (Type)0.0,
+                                 m_translation[0], m_translation[1], m_translation[2], (Type)1.0);
+        }
+
+        //! Set the transformation to be the identity.
+        void makeIdentity()
+        {
+            m_linear.makeIdentity();
+            m_translation.setValue(0, 0, 0);
+        }
+
+        //! Check if the transformation is the identity.
+        bool isIdentity() const
+        {
+            return m_linear.isIdentity() && m_translation[0] == (Type)0.0 && m_translation[1] == (Type)0.0 && m_translation[2] == (Type)0.0;
+        }
+
+        //! Return the linear part.
+        const Matrix3<Type> & getLinear() const
+        {
+            return m_linear;
+        }
+
+        //! Set the linear part, the translation is kept.
+        void setLinear(const Matrix3<Type> & a_linear)
+        {
+            m_linear = a_linear;
+        }
+
+        //! Return the translation.
+        const Vec3<Type> & getTranslation() const
+        {
+            return m_translation;
+        }
+
+        //! Set the translation, the linear part is kept.
+        void setTranslation(const Vec3<Type> & a_translation)
+        {
+            m_translation = a_translation;
+        }
+
+        //! Make this transformation into a pure rotation.
+        void setRotate(const Quat<Type> & a_quat)
+        {
+            m_linear.setRotate(a_quat);
+            m_translation.setValue(0, 0, 0);
+        }
+
+        //! Make this transformation into a pure scaling.
+        void setScale(const Type s)
+        {
+            setScale(Vec3<Type>(s,s,s));
+        }
+
+        //! Make this transformation into a pure scaling.
+        void setScale(const Vec3<Type> & s)
+        {
+            m_linear.setScale(s);
+            m_translation.setValue(0, 0, 0);
+        }
+
+        //! Make this transformation into a pure translation.
+        void setTranslate(const Vec3<Type> & t)
+        {
+            m_linear.makeIdentity();
+            m_translation = t;
+        }
+
+        //! Returns the determinant of the linear part.
+        Type det() const
+        {
+            return m_linear.det();
+        }
+
+        //! Check if the linear part is orthonormal, i.e. the transformation is a rotation and a translation, within the given tolerance.
+        bool isRigid(Type a_tolerance=1E-4) const
+        {
+            Matrix3<Type> product = m_linear * Matrix3<Type>(m_linear).transpose();
+
+            return product.equals(Matrix3<Type>(), a_tolerance) && det() > 0;
+        }
+
+        //! Let this transformation be followed by \a a: right-multiply as with Matrix4::multRight(). Returns reference to self.
+        Affine3<Type> & multRight(const Affine3<Type> & a)
+        {
+            // (p L1 + t1) L2 + t2
+            Vec3<Type> translation;
+            a.m_linear.multVecMatrix(m_translation, translation);
+
+            m_translation = translation + a.m_translation;
+            m_linear.multRight(a.m_linear);
+
+            return *this;
+        }
+
+        //! Let this transformation be preceded by \a a: left-multiply as with Matrix4::multLeft(). Returns reference to self.
+        Affine3<Type> & multLeft(const Affine3<Type> & a)
+        {
+            // (p L2 + t2) L1 + t1
+            Vec3<Type> translation;
+            m_linear.multVecMatrix(a.m_translation, translation);
+
+            m_translation += translation;
+            m_linear = a.m_linear * m_linear;
+
+            return *this;
+        }
+
+        //! Invert the transformation, the linear part is inverted with its cofactors. \sa invertRigid().
+        Affine3<Type> & invert()
+        {
+            m_linear.invert();
+            m_linear.multVecMatrix(m_translation, m_translation);
+            m_translation *= (Type)-1.0;
+
+            return *this;
+        }
+
+        //! Invert a rigid transformation, whose linear part is a rotation and can be transposed instead of inverted. \sa isRigid().
+        Affine3<Type> & invertRigid()
+        {
+            m_linear.transpose();
+            m_linear.multVecMatrix(m_translation, m_translation);
+            m_translation *= (Type)-1.0;
+
+            return *this;
+        }
+
+        //! Return the inverse transformation. \sa invert().
+        Affine3<Type> inverse() const
+        {
+            Affine3<Type> affine(*this);
+
+            return affine.invert();
+        }
+
+        //! Return the inverse of a rigid transformation. \sa invertRigid().
+        Affine3<Type> inverseRigid() const
+        {
+            Affine3<Type> affine(*this);
+
+            return affine.invertRigid();
+        }
+
+        //! Transforms the point \a src, same as Matrix4::multVecMatrix() without the perspective divide.
+        void multVecMatrix(const Vec3<Type> & src, Vec3<Type> & dst) const
+        {
+            Type x = src[0]*m_linear[0][0] + src[1]*m_linear[1][0] + src[2]*m_linear[2][0] + m_translation[0];
+            Type y = src[0]*m_linear[0][1] + src[1]*m_linear[1][1] + src[2]*m_linear[2][1] + m_translation[1];
+            Type z = src[0]*m_linear[0][2] + src[1]*m_linear[1][2] + src[2]*m_linear[2][2] + m_translation[2];
+
+            dst.setValue(x, y, z);
+        }
+
+        //! Transforms the direction \a src, the translation is ignored.
+        void multDirMatrix(const Vec3<Type> & src, Vec3<Type> & dst) const
+        {
+            m_linear.multVecMatrix(src, dst);
+        }
+
+        /*! Transforms the normal \a src by the inverse transpose of the linear part, so that it stays
+        perpendicular to the transformed surface. The result is not normalized.
+        */
+        void multNormal(const Vec3<Type> & src, Vec3<Type> & dst) const
+        {
+            const Matrix3<Type> & m = m_linear;
+
+            // the inverse transpose is the cofactor matrix divided by the determinant
+            Type c00 = m[1][1]*m[2][2] - m[1][2]*m[2][1];
+            Type c01 = m[1][2]*m[2][0] - m[1][0]*m[2][2];
+            Type c02 = m[1][0]*m[2][1] - m[1][1]*m[2][0];
+            Type c10 = m[0][2]*m[2][1] - m[0][1]*m[2][2];
+            Type c11 = m[0][0]*m[2][2] - m[0][2]*m[2][0];
+            Type c12 = m[0][1]*m[2][0] - m[0][0]*m[2][1];
+            Type c20 = m[0][1]*m[1][2] - m[0][2]*m[1][1];
+            Type c21 = m[0][2]*m[1][0] - m[0][0]*m[1][2];
+            Type c22 = m[0][0]*m[1][1] - m[0][1]*m[1][0];
+
+            Type invdet = (Type)1.0 / (m[0][0]*c00 + m[0][1]*c01 + m[0][2]*c02);
+
+            dst.setValue((src[0]*c00 + src[1]*c10 + src[2]*c20) * invdet,
+                         (src[0]*c01 + src[1]*c11 + src[2]*c21) * invdet,
+                         (src[0]*c02 + src[1]*c12 + src[2]*c22) * invdet);
+        }
+
+        //! Transforms the \a n points of \a src and writes them to \a dst. \a src and \a dst may be the same array.
+        void transformPoints(const Vec3<Type> * src, Vec3<Type> * dst, std::size_t n) const
+        {
+            for(std::size_t i = 0; i < n; i++){
+                multVecMatrix(src[i], dst[i]);
+            }
+        }
+
+        //! Check if the \a a_affine transformation is equal to this one, within the given tolerance value.
+        bool equals(const Affine3<Type> & a_affine, Type a_tolerance=1E-2) const
+        {
+            return m_linear.equals(a_affine.m_linear, a_tolerance) && m_translation.equals(a_affine.m_translation, a_tolerance);
+        }
+
+        //! Right-multiply with the \a a_affine transformation. \sa multRight().
+        Affine3<Type> & operator *=(const Affine3<Type> & a_affine)
+        {
+            return multRight(a_affine);
+        }
+
+        //! Returns the transformation \a a1 followed by \a a2.
+        friend Affine3<Type> operator *(const Affine3<Type> & a1, const Affine3<Type> & a2)
+        {
+            Affine3<Type> a = a1;
+            a *= a2;
+            return a;
+        }
+
+        //! Compare transformations to see if they are equal. \sa equals().
+        friend bool operator ==(const Affine3<Type> & a1, const Affine3<Type> & a2)
+        {
+            return a1.m_linear == a2.m_linear && a1.m_translation == a2.m_translation;
+        }
+
+        friend bool operator !=(const Affine3<Type> & a1, const Affine3<Type> & a2)
+        {
+            return !(a1 == a2);
+        }
+
+        friend std::ostream & operator<<(std::ostream & os, const Affine3<Type> & affine)
+        {
+            return os << affine.m_linear << affine.m_translation << std::endl;
+        }
+
+    private:
+        Matrix3<Type> m_linear;
+        Vec3<Type>    m_translation;
+    };
+
+    typedef Affine3<float>  Affine3f;
+    typedef Affine3<double> Affine3d;
+} // namespace gtl
+
+#endif
@@ -0,0 +1,192 @@
+/*
+_______________________________________________________________________
+__________________________ G E O M E T R Y ____________________________
+|
+| THIS FILE IS PART OF THE GEOMETRY TEMPLATE LIBRARY.
+| USE, DISTRIBUTION AND REPRODUCTION OF THIS LIBRARY SOURCE IS
+| GOVERNED BY A BSD-STYLE SOURCE LICENSE.
+| PLEASE READ THESE TERMS BEFORE DISTRIBUTING.
+_______________________________________________________________________
+_______________________________________________________________________
+*/
+
+#ifndef BITGRID3_H
+#define BITGRID3_H
+
+#include <gtl/gtl.hpp>
+#include <gtl/vec3.hpp>
+
+namespace gtl
+{
+    /*!
+    \class BitGrid3 BitGrid3.hpp geometry/BitGrid3.hpp
+    \brief Dense 3D grid of voxels stored as one bit per voxel.
+    \ingroup base
+
+    The grid covers the voxel indices between getMin() and getMax(), inclusive.
+    Every row along z starts on a new word so that distinct rows can be written
+    concurrently. A grid can be used as the sink of RectPrism::voxelize().
+
+    \sa RectPrism
+    */
+    class BitGrid3
+    {
+    public:
+        //! The default constructor makes an empty grid.
+        BitGrid3() : m_min(0, 0, 0), m_size(0, 0, 0), m_row_words(0)
+        {
+        }
+
+        //! Constructs an empty grid covering the indices from \a a_min to \a a_max. \sa resize().
+        BitGrid3(const Vec3<int> & a_min, const Vec3<int> & a_max) : m_min(0, 0, 0), m_size(0, 0, 0), m_row_words(0)
+        {
+            resize(a_min, a_max);
+        }
+
+        //! Cover the indices from \a a_min to \a a_max, inclusive. All the voxels are cleared.
+        void resize(const Vec3<int> & a_min, const Vec3<int> & a_max)
+        {
+            m_min = a_min;
+            for(int c = 0; c < 3; c++){
+                m_size[c] = a_max[c] >= a_min[c] ? a_max[c] - a_min[c] + 1 : 0;
+            }
+            m_row_words = (m_size[2] + 31) / 32;
+
+            m_words.assign((std::size_t)m_size[0] * m_size[1] * m_row_words, 0u);
+        }
+
+        //! Clear all the voxels, the bounds are kept.
+        void clear()
+        {
+            std::fill(m_words.begin(), m_words.end(), 0u);
+        }
+
+        //! Return the lowest voxel index.
+        const Vec3<int> & getMin() const
+        {
+            return m_min;
+        }
+
+        //! Return the highest voxel index.
+        Vec3<int> getMax() const
+        {
+            return Vec3<int>(m_min[0] + m_size[0] - 1, m_min[1] + m_size[1] - 1, m_min[2] + m_size[2] - 1);
+        }
+
+        //! Return the number of voxels along each axis.
+        const Vec3<int> & getSize() const
+        {
+            return m_size;
+        }
+
+        //! Return true if the voxel (i,j,k) is set. The voxels outside of the grid are never set.
+        bool get(int i, int j, int k) const
+        {
+            if(!contains(i, j, k)) return false;
+
+            const int z = k - m_min[2];
+
+            return (m_words[row(i, j) + z / 32] >> (z % 32) & 1u) != 0;
+        }
+
+        //! Set the voxel (i,j,k), which must be inside of the grid.
+        void set(int i, int j, int k)
+        {
+            const int z = k - m_min[2];
+
+            m_words[row(i, j) + z / 32] |= 1u << (z % 32);
+        }
+
+        //! Unset the voxel (i,j,k), which must be inside of the grid.
+        void reset(int i, int j, int k)
+        {
+            const int z = k - m_min[2];
+
+            m_words[row(i, j) + z / 32] &= ~(1u << (z % 32));
+        }
+
+        //! Set the voxels (i,j,k) for k between \a k0 and \a k1, inclusive. The run is clipped to the grid.
+        void setRun(int i, int j, int k0, int k1)
+        {
+            if(i < m_min[0] || i >= m_min[0] + m_size[0] || j < m_min[1] || j >= m_min[1] + m_size[1]) return;
+
+            int z0 = std::max(k0 - m_min[2], 0);
+            int z1 = std::min(k1 - m_min[2], m_size[2] - 1);
+
+            if(z0 > z1) return;
+
+            unsigned int * words = &m_words[row(i, j)];
+            const int w0 = z0 / 32, w1 = z1 / 32;
+            const unsigned int first = ~0u << (z0 % 32);
+            const unsigned int last = ~0u >> (31 - z1 % 32);
+
+            if(w0 == w1){
+                words[w0] |= first & last;
+                return;
+            }
+
+            words[w0] |= first;
+            for(int w = w0 + 1; w < w1; w++) words[w] = ~0u;
+            words[w1] |= last;
+        }
+
+        //! Same as setRun(), so that the grid can be used as a voxelizer sink.
+        void operator()(int i, int j, int k0, int k1)
+        {
+            setRun(i, j, k0, k1);
+        }
+
+        //! Return the number of voxels which are set.
+        std::size_t count() const
+        {
+            std::size_t total = 0;
+
+            for(std::size_t w = 0; w < m_words.size(); w++){
+                unsigned int v = m_words[w];
+                v = v - ((v >> 1) & 0x55555555u);
+                v = (v & 0x33333333u) + ((v >> 2) & 0x33333333u);
+                total += (((v + (v >> 4)) & 0x0f0f0f0fu) * 0x01010101u) >> 24;
+            }
+            return total;
+        }
+
+        //! Append the indices of the voxels which are set to \a a_voxels, ordered by x, then y, then z.
+        void getVoxels(std::vector< Vec3<int> > & a_voxels) const
+        {
+            for(int x = 0; x < m_size[0]; x++){
+                for(int y = 0; y < m_size[1]; y++){
+                    const unsigned int * words = &m_words[((std::size_t)x * m_size[1] + y) * m_row_words];
+
+                    for(int w = 0; w < m_row_words; w++){
+                        for(unsigned int bits = words[w]; bits; bits &= bits - 1){
+                            int z = w * 32;
+                            while(!(bits >> (z - w * 32) & 1u)) z++;
+                            a_voxels.push_back(Vec3<int>(m_min[0] + x, m_min[1] + y, m_min[2] + z));
+                        }
+                    }
+                }
+            }
+        }
+
+    private:
+        Vec3<int>                 m_min;
+        Vec3<int>                 m_size;
+        int                       m_row_words;
+        std::vector<unsigned int> m_words;
+
+        bool contains(int i, int j, int k) const
+        {
+            return i >= m_min[0] && i < m_min[0] + m_size[0] &&
+                   j >= m_min[1] && j < m_min[1] + m_size[1] &&
+                   k >= m_min[2] && k < m_min[2] + m_size[2];
+        }
+
+        // Index of the first word of the row (i,j).
+        std::size_t row(int i, int j) const
+        {
+            return ((std::size_t)(i - m_min[0]) * m_size[1] + (j - m_min[1])) * m_row_words;
+        }
+    };
+} // namespace gtl
+
+#endif
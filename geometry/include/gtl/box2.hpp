@@ -24,6 +24,9 @@ namespace gtl
 
     This box class is used by many other classes.
 
+    Box2 has no virtual destructor, to stay a plain value of two vectors. It is not a
+    polymorphic base: a derived box must not be deleted through a pointer to Box2.
+
     \sa Box3
     */
     template<typename Type>
@@ -42,9 +45,6 @@ namespace gtl
             setBounds(a_min, a_max);
         }
 
-        //! Default destructor does nothing.
-        virtual ~Box2(){}
-
         //! Reset the boundaries of the box with the given corners.
         void setBounds(const Vec2<Type> & a_min, const Vec2<Type> & a_max)
         {
@@ -115,6 +115,54 @@ namespace gtl
             }
         }
 
+        //! Return the bounds of the \a n points, an empty box if there are none. \sa fromPoints(const Type *, std::size_t, std::size_t).
+        static Box2<Type> fromPoints(const Vec2<Type> * a_points, std::size_t n)
+        {
+            return fromPoints(n ? a_points[0].getValue() : NULL, n, sizeof(Vec2<Type>));
+        }
+
+        //! Return the bounds of the given points, an empty box if there are none.
+        static Box2<Type> fromPoints(const std::vector< Vec2<Type> > & a_points)
+        {
+            return fromPoints(a_points.empty() ? NULL : &a_points[0], a_points.size());
+        }
+
+        /*! Return the bounds of \a n points of two coordinates, the first one at \a a_coordinates
+        and each one \a a_stride bytes after the previous one, as in an interleaved vertex buffer.
+        The bounds are taken without branches, two points at once with SSE2 for floats, and large
+        arrays are split into blocks bounded in parallel with OpenMP.
+        */
+        static Box2<Type> fromPoints(const Type * a_coordinates, std::size_t n, std::size_t a_stride)
+        {
+            Box2<Type> box;
+
+            if(n == 0) return box;
+
+            const long num_blocks = (long)((n + BLOCK_SIZE - 1) / BLOCK_SIZE);
+
+            if(num_blocks == 1){
+                bounds(a_coordinates, n, a_stride, box.m_min, box.m_max);
+                return box;
+            }
+
+            const char * bytes = (const char *)a_coordinates;
+            std::vector< Box2<Type> > blocks(num_blocks);
+
+#ifdef _OPENMP
+            #pragma omp parallel for
+#endif
+            for(long b = 0; b < num_blocks; b++){
+                const std::size_t begin = (std::size_t)b * BLOCK_SIZE;
+
+                bounds((const Type *)(bytes + begin * a_stride), std::min<std::size_t>(BLOCK_SIZE, n - begin), a_stride, blocks[b].m_min, blocks[b].m_max);
+            }
+
+            for(long b = 0; b < num_blocks; b++){
+                box.extendBy(blocks[b]);
+            }
+            return box;
+        }
+
         //! Give the surface of the box
         Type getSurface() const
         {
@@ -154,11 +202,75 @@ namespace gtl
     private:
         Vec2<Type> m_min;
         Vec2<Type> m_max;
+
+        enum
+        {
+            BLOCK_SIZE = 65536  //!< points bounded by a thread at once in fromPoints()
+        };
+
+        template<typename T>
+        static void bounds(const T * a_coordinates, std::size_t n, std::size_t a_stride, Vec2<T> & a_min, Vec2<T> & a_max)
+        {
+            // separate variables, which the compiler keeps in registers
+            const char * bytes = (const char *)a_coordinates;
+            T lx = a_coordinates[0], ly = a_coordinates[1];
+            T hx = lx, hy = ly;
+
+            for(std::size_t i = 1; i < n; i++){
+                const T * p = (const T *)(bytes + i * a_stride);
+
+                lx = (p[0] < lx) ? p[0] : lx;
+                ly = (p[1] < ly) ? p[1] : ly;
+                hx = (p[0] > hx) ? p[0] : hx;
+                hy = (p[1] > hy) ? p[1] : hy;
+            }
+
+            a_min.setValue(lx, ly);
+            a_max.setValue(hx, hy);
+        }
+
+#ifdef GTL_SSE2
+        static void bounds(const float * a_coordinates, std::size_t n, std::size_t a_stride, Vec2<float> & a_min, Vec2<float> & a_max)
+        {
+            const char * bytes = (const char *)a_coordinates;
+
+            // two points in the low and high halves
+            const __m128 first = _mm_loadl_pi(_mm_setzero_ps(), (const __m64 *)a_coordinates);
+            __m128 lo = _mm_movelh_ps(first, first);
+            __m128 hi = lo;
+            std::size_t i = 0;
+
+            for(; i + 2 <= n; i += 2){
+                const __m128 v = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64 *)(bytes + i * a_stride)),
+                                              (const __m64 *)(bytes + (i + 1) * a_stride));
+
+                lo = _mm_min_ps(lo, v);
+                hi = _mm_max_ps(hi, v);
+            }
+
+            float l[4], h[4];
+            _mm_storeu_ps(l, lo);
+            _mm_storeu_ps(h, hi);
+
+            a_min.setValue(std::min(l[0], l[2]), std::min(l[1], l[3]));
+            a_max.setValue(std::max(h[0], h[2]), std::max(h[1], h[3]));
+
+            if(i < n){
+                const float * p = (const float *)(bytes + i * a_stride);
+
+                a_min.setValue(std::min(a_min[0], p[0]), std::min(a_min[1], p[1]));
+                a_max.setValue(std::max(a_max[0], p[0]), std::max(a_max[1], p[1]));
+            }
+        }
+#endif
     };
 
     typedef Box2<int>    Box2i;
     typedef Box2<float>  Box2f;
     typedef Box2<double> Box2d;
+
+    GTL_ASSERT_PACKED(Box2f, float, 4);
+    GTL_ASSERT_PACKED(Box2d, double, 4);
 } // namespace gtl
 
 #endif
@@ -15,9 +15,11 @@ _______________________________________________________________________
 
 #include <gtl/gtl.hpp>
 #include <gtl/vec3.hpp>
+#include <gtl/vec3array.hpp>
 #include <gtl/ray.hpp>
 #include <gtl/plane.hpp>
 #include <gtl/matrix4.hpp>
+#include <gtl/affine3.hpp>
 
 namespace gtl
 {
@@ -32,6 +34,9 @@ namespace gtl
 
     This box class is used by many other classes.
 
+    Box3 has no virtual destructor, to stay a plain value of two vectors. It is not a
+    polymorphic base: an XfBox3 must not be deleted through a pointer to Box3.
+
     \sa XfBox3
     */
     template<typename Type>
@@ -50,9 +55,6 @@ namespace gtl
             setBounds(a_min, a_max);
         }
 
-        //! Default destructor does nothing.
-        virtual ~Box3(){}
-
         //! Reset the boundaries of the box with the given corners.
         void setBounds(const Vec3<Type> & a_min, const Vec3<Type> & a_max)
         {
@@ -136,12 +138,20 @@ namespace gtl
             return (m_max[0] - m_min[0]) * (m_max[1] - m_min[1]) * (m_max[2] - m_min[2]);
         }
 
-        //! Transforms Box3 by matrix, enlarging Box3 to contain result.
+        /*! Transforms Box3 by matrix, enlarging Box3 to contain result.
+        Affine matrices take the center and extents path of transform(const Affine3<Type>&),
+        the 8 corners are only projected for perspective matrices.
+        */
         void transform(const Matrix4<Type> & m)
         {
             // a transformed empty box is still empty
             if(isEmpty()) return;
 
+            if(m.isAffine()){
+                transformExtents(m, Vec3<Type>(m[3][0], m[3][1], m[3][2]));
+                return;
+            }
+
             Vec3<Type> corners[8];
             corners[0]    = m_min;
             corners[1][0] = m_min[0]; corners[1][1] = m_max[1]; corners[1][2] = m_min[2];
@@ -161,6 +171,87 @@ namespace gtl
             setBounds(newbox.m_min, newbox.m_max);
         }
 
+        //! Transforms Box3 by the affine transformation \a a, enlarging Box3 to contain result.
+        void transform(const Affine3<Type> & a)
+        {
+            if(isEmpty()) return;
+
+            transformExtents(a.getLinear(), a.getTranslation());
+        }
+
+        /*! Computes out[i] = boxes[i] transformed by matrices[i] for the \a n boxes, as when refitting
+        the world bounds of many instances. \a out may be the same array as \a boxes.
+        */
+        static void transformMany(const Box3<Type> * boxes, const Matrix4<Type> * matrices, Box3<Type> * out, std::size_t n)
+        {
+            const long count = (long)n;
+
+#ifdef _OPENMP
+            #pragma omp parallel for if(count > 4096)
+#endif
+            for(long i = 0; i < count; i++){
+                Box3<Type> box(boxes[i]);
+                box.transform(matrices[i]);
+                out[i] = box;
+            }
+        }
+
+        //! Return the bounds of the \a n points, an empty box if there are none. \sa fromPoints(const Type *, std::size_t, std::size_t).
+        static Box3<Type> fromPoints(const Vec3<Type> * a_points, std::size_t n)
+        {
+            return fromPoints(n ? a_points[0].getValue() : NULL, n, sizeof(Vec3<Type>));
+        }
+
+        //! Return the bounds of the given points, an empty box if there are none.
+        static Box3<Type> fromPoints(const std::vector< Vec3<Type> > & a_points)
+        {
+            return fromPoints(a_points.empty() ? NULL : &a_points[0], a_points.size());
+        }
+
+        //! Return the bounds of the given points, an empty box if there are none.
+        static Box3<Type> fromPoints(const Vec3Array<Type> & a_points)
+        {
+            Box3<Type> box;
+            a_points.getBounds(box.m_min, box.m_max);
+            return box;
+        }
+
+        /*! Return the bounds of \a n points of three coordinates, the first one at \a a_coordinates
+        and each one \a a_stride bytes after the previous one, as the positions of an interleaved
+        vertex buffer. The bounds are taken without branches, four floats at once with SSE2, and
+        large arrays are split into blocks bounded in parallel with OpenMP.
+        */
+        static Box3<Type> fromPoints(const Type * a_coordinates, std::size_t n, std::size_t a_stride)
+        {
+            Box3<Type> box;
+
+            if(n == 0) return box;
+
+            const long num_blocks = (long)((n + BLOCK_SIZE - 1) / BLOCK_SIZE);
+
+            if(num_blocks == 1){
+                bounds(a_coordinates, n, a_stride, box.m_min, box.m_max);
+                return box;
+            }
+
+            const char * bytes = (const char *)a_coordinates;
+            std::vector< Box3<Type> > blocks(num_blocks);
+
+#ifdef _OPENMP
+            #pragma omp parallel for
+#endif
+            for(long b = 0; b < num_blocks; b++){
+                const std::size_t begin = (std::size_t)b * BLOCK_SIZE;
+
+                bounds((const Type *)(bytes + begin * a_stride), std::min<std::size_t>(BLOCK_SIZE, n - begin), a_stride, blocks[b].m_min, blocks[b].m_max);
+            }
+
+            for(long b = 0; b < num_blocks; b++){
+                box.extendBy(blocks[b]);
+            }
+            return box;
+        }
+
         //! Check if \a a_point lies within the boundaries of this box.
         bool intersect(const Vec3<Type> & a_point) const
         {
@@ -250,6 +341,96 @@ namespace gtl
         }
 
     private:
+        /* Arvo: the new box is centered on the transformed center, its half size along
+        each axis is the absolute value of the linear part applied to the half size.
+        Twice the center and twice the half size are used, which are exact for integer
+        boxes, and the new bounds are halved last: their doubles are even.
+        \a linear is a Matrix3 or the upper left block of a Matrix4.
+        */
+        template<typename Linear>
+        void transformExtents(const Linear & linear, const Vec3<Type> & translation)
+        {
+            const Vec3<Type> center = m_min + m_max;
+            const Vec3<Type> size = m_max - m_min;
+            Vec3<Type> newmin, newmax;
+
+            for(int j = 0; j < 3; j++){
+                const Type c = center[0] * linear[0][j] + center[1] * linear[1][j] + center[2] * linear[2][j] + translation[j] * 2;
+                const Type e = std::abs(linear[0][j]) * size[0] + std::abs(linear[1][j]) * size[1] + std::abs(linear[2][j]) * size[2];
+
+                newmin[j] = (c - e) / 2;
+                newmax[j] = (c + e) / 2;
+            }
+
+            setBounds(newmin, newmax);
+        }
+
+        enum
+        {
+            BLOCK_SIZE = 65536  //!< points bounded by a thread at once in fromPoints()
+        };
+
+        template<typename T>
+        static void bounds(const T * a_coordinates, std::size_t n, std::size_t a_stride, Vec3<T> & a_min, Vec3<T> & a_max)
+        {
+            // separate variables, which the compiler keeps in registers
+            const char * bytes = (const char *)a_coordinates;
+            T lx = a_coordinates[0], ly = a_coordinates[1], lz = a_coordinates[2];
+            T hx = lx, hy = ly, hz = lz;
+
+            for(std::size_t i = 1; i < n; i++){
+                const T * p = (const T *)(bytes + i * a_stride);
+
+                lx = (p[0] < lx) ? p[0] : lx;
+                ly = (p[1] < ly) ? p[1] : ly;
+                lz = (p[2] < lz) ? p[2] : lz;
+                hx = (p[0] > hx) ? p[0] : hx;
+                hy = (p[1] > hy) ? p[1] : hy;
+                hz = (p[2] > hz) ? p[2] : hz;
+            }
+
+            a_min.setValue(lx, ly, lz);
+            a_max.setValue(hx, hy, hz);
+        }
+
+#ifdef GTL_SSE2
+        static void bounds(const float * a_coordinates, std::size_t n, std::size_t a_stride, Vec3<float> & a_min, Vec3<float> & a_max)
+        {
+            const char * bytes = (const char *)a_coordinates;
+            const float * last = (const float *)(bytes + (n - 1) * a_stride);
+
+            // the last point is loaded without reading past its z
+            const __m128 end = _mm_movelh_ps(_mm_loadl_pi(_mm_setzero_ps(), (const __m64 *)last), _mm_load_ss(last + 2));
+            __m128 lo0 = end, hi0 = end, lo1 = end, hi1 = end;
+            std::size_t i = 0;
+
+            // the others with the float which follows, in the same vertex or the next one
+            for(; i + 2 < n; i += 2){
+                const __m128 v0 = _mm_loadu_ps((const float *)(bytes + i * a_stride));
+                const __m128 v1 = _mm_loadu_ps((const float *)(bytes + (i + 1) * a_stride));
+
+                lo0 = _mm_min_ps(lo0, v0);
+                hi0 = _mm_max_ps(hi0, v0);
+                lo1 = _mm_min_ps(lo1, v1);
+                hi1 = _mm_max_ps(hi1, v1);
+            }
+
+            if(i + 1 < n){
+                const __m128 v0 = _mm_loadu_ps((const float *)(bytes + i * a_stride));
+
+                lo0 = _mm_min_ps(lo0, v0);
+                hi0 = _mm_max_ps(hi0, v0);
+            }
+
+            float lo[4], hi[4];
+            _mm_storeu_ps(lo, _mm_min_ps(lo0, lo1));
+            _mm_storeu_ps(hi, _mm_max_ps(hi0, hi1));
+
+            a_min.setValue(lo[0], lo[1], lo[2]);
+            a_max.setValue(hi[0], hi[1], hi[2]);
+        }
+#endif
+
         Vec3<Type> m_min;
         Vec3<Type> m_max;
     };
@@ -257,6 +438,9 @@ namespace gtl
     typedef Box3<int>    Box3i;
     typedef Box3<float>  Box3f;
     typedef Box3<double> Box3d;
+
+    GTL_ASSERT_PACKED(Box3f, float, 6);
+    GTL_ASSERT_PACKED(Box3d, double, 6);
 } // namespace gtl
 
 #endif
@@ -0,0 +1,593 @@
+/*
+_______________________________________________________________________
+__________________________ G E O M E T R Y ____________________________
+|
+| THIS FILE IS PART OF THE GEOMETRY TEMPLATE LIBRARY.
+| USE, DISTRIBUTION AND REPRODUCTION OF THIS LIBRARY SOURCE IS
+| GOVERNED BY A BSD-STYLE SOURCE LICENSE.
+| PLEASE READ THESE TERMS BEFORE DISTRIBUTING.
+_______________________________________________________________________
+_______________________________________________________________________
+*/
+
+#ifndef BVH_H
+#define BVH_H
+
+#include <gtl/gtl.hpp>
+#include <gtl/vec3.hpp>
+#include <gtl/box3.hpp>
+#include <gtl/ray.hpp>
+#include <gtl/raypacket.hpp>
+
+namespace gtl
+{
+    /*!
+    \class Bvh Bvh.hpp geometry/Bvh.hpp
+    \brief Bounding volume hierarchy over a triangle soup.
+    \ingroup base
+
+    The tree is built top-down with a binned surface area heuristic and stored as a
+    flat depth-first array of nodes: the left child of an inner node directly follows it.
+    The triangles are copied in leaf order so that a leaf reads contiguous memory.
+    Subtrees are built in parallel when OpenMP is enabled.
+
+    \sa Box3, Ray
+    */
+    template<typename Type>
+    class Bvh
+    {
+    public:
+        //! The default constructor makes an empty hierarchy.
+        Bvh(){}
+
+        //! Build the hierarchy of a triangle soup. \sa build().
+        Bvh(const std::vector< Vec3<Type> > & a_vertices)
+        {
+            build(a_vertices);
+        }
+
+        //! Build the hierarchy of a triangle soup, every 3 consecutive vertices define a triangle.
+        void build(const std::vector< Vec3<Type> > & a_vertices)
+        {
+            if(a_vertices.size() < 3) clear();
+            else build(&a_vertices[0], a_vertices.size() / 3);
+        }
+
+        //! Build the hierarchy of \a a_num_triangles triangles, every 3 consecutive vertices define a triangle.
+        void build(const Vec3<Type> * a_vertices, std::size_t a_num_triangles)
+        {
+            clear();
+
+            if(a_num_triangles == 0) return;
+
+            std::vector<BuildRef> refs(a_num_triangles);
+
+            for(std::size_t i = 0; i < a_num_triangles; i++){
+                BuildRef & ref = refs[i];
+                ref.bounds.extendBy(a_vertices[3*i]);
+                ref.bounds.extendBy(a_vertices[3*i+1]);
+                ref.bounds.extendBy(a_vertices[3*i+2]);
+                ref.centroid = ref.bounds.getCenter();
+                ref.index = (unsigned int)i;
+            }
+
+            // split the top of the tree serially until there is enough subtrees to keep the threads busy
+            std::vector<Skeleton> skeleton;
+            std::vector<Task> tasks;
+
+            splitTop(refs, 0, (unsigned int)a_num_triangles, 0, skeleton, tasks);
+
+            std::vector< std::vector<Node> > subtrees(tasks.size());
+
+#ifdef _OPENMP
+            #pragma omp parallel for schedule(dynamic)
+#endif
+            for(int i = 0; i < (int)tasks.size(); i++){
+                buildRange(refs, tasks[i].begin, tasks[i].end, tasks[i].depth, subtrees[i]);
+            }
+
+            // stitch the skeleton and the subtrees in depth-first order
+            m_nodes.reserve(2 * a_num_triangles);
+            emit(skeleton, 0, subtrees);
+
+            m_vertices.resize(3 * a_num_triangles);
+            m_indices.resize(a_num_triangles);
+
+            for(std::size_t i = 0; i < a_num_triangles; i++){
+                const unsigned int t = refs[i].index;
+                m_vertices[3*i]   = a_vertices[3*t];
+                m_vertices[3*i+1] = a_vertices[3*t+1];
+                m_vertices[3*i+2] = a_vertices[3*t+2];
+                m_indices[i] = t;
+            }
+        }
+
+        //! Remove all the triangles.
+        void clear()
+        {
+            m_nodes.clear();
+            m_vertices.clear();
+            m_indices.clear();
+        }
+
+        //! Return the number of triangles.
+        std::size_t getNumTriangles() const
+        {
+            return m_indices.size();
+        }
+
+        //! Return the number of nodes.
+        std::size_t getNumNodes() const
+        {
+            return m_nodes.size();
+        }
+
+        //! Return the bounding box of all the triangles.
+        Box3<Type> getBounds() const
+        {
+            return m_nodes.empty() ? Box3<Type>() : m_nodes[0].bounds;
+        }
+
+        /*! Find the closest triangle hit by the ray.
+        Return true if there is an intersection. In that case \a a_triangle is the index of the triangle
+        in the soup and \a a_tuv is the vector returned by Ray::intersect(): t is the distance along the ray,
+        (u,v) the coordinates inside the triangle.
+        */
+        bool intersect(const Ray<Type> & a_ray, int & a_triangle, Vec3<Type> & a_tuv) const
+        {
+            if(m_nodes.empty()) return false;
+
+            const Vec3<Type> & origin = a_ray.getOrigin();
+            const Vec3<Type> invdir = inverse(a_ray.getDirection());
+
+            Type tbest = std::numeric_limits<Type>::max();
+            int best = -1;
+
+            unsigned int stack[MAX_DEPTH];
+            int top = 0;
+            unsigned int current = 0;
+            Type tnear;
+
+            if(!intersect(m_nodes[0].bounds, origin, invdir, tbest, tnear)) return false;
+
+            for(;;){
+                const Node & node = m_nodes[current];
+
+                if(node.count){
+                    for(unsigned int i = node.offset; i < node.offset + node.count; i++){
+                        Vec3<Type> tuv;
+                        if(a_ray.intersect(m_vertices[3*i], m_vertices[3*i+1], m_vertices[3*i+2], tuv) &&
+                           tuv[0] >= (Type)0 && tuv[0] < tbest){
+                            tbest = tuv[0];
+                            best = (int)i;
+                            a_tuv = tuv;
+                        }
+                    }
+                }else{
+                    // visit the nearest child first, keep the other one for later
+                    unsigned int left = current + 1;
+                    unsigned int right = node.offset;
+                    Type tleft, tright;
+                    bool hitleft = intersect(m_nodes[left].bounds, origin, invdir, tbest, tleft);
+                    bool hitright = intersect(m_nodes[right].bounds, origin, invdir, tbest, tright);
+
+                    if(hitleft && hitright){
+                        if(tright < tleft) std::swap(left, right);
+                        stack[top++] = right;
+                        current = left;
+                        continue;
+                    }
+                    if(hitleft){ current = left; continue; }
+                    if(hitright){ current = right; continue; }
+                }
+
+                // pop the next node which is still closer than the best hit
+                bool found = false;
+                while(top > 0){
+                    current = stack[--top];
+                    if(intersect(m_nodes[current].bounds, origin, invdir, tbest, tnear)){
+                        found = true;
+                        break;
+                    }
+                }
+                if(!found) break;
+            }
+
+            if(best < 0) return false;
+
+            a_triangle = (int)m_indices[best];
+
+            return true;
+        }
+
+        /*! Find the closest triangle hit by every active ray of \a a_packet.
+        Return the mask of the rays which hit. For these rays \a a_triangles is the index of the triangle
+        in the soup and \a a_t the distance along the ray. The nodes are visited once for the whole packet,
+        which pays off for coherent rays.
+        */
+        template<int N>
+        unsigned int intersect(const RayPacket<Type, N> & a_packet, int a_triangles[N], Type a_t[N]) const
+        {
+            if(m_nodes.empty()) return 0;
+
+            int best[N];
+
+            for(int i = 0; i < N; i++){
+                a_t[i] = std::numeric_limits<Type>::max();
+                best[i] = -1;
+            }
+
+            unsigned int stack[MAX_DEPTH + 1];
+            int top = 0;
+
+            stack[top++] = 0;
+
+            while(top > 0){
+                const unsigned int current = stack[--top];
+                const Node & node = m_nodes[current];
+
+                // the closest hits may have moved since the node was pushed
+                if(!a_packet.intersect(node.bounds, a_t)) continue;
+
+                if(node.count){
+                    for(unsigned int i = node.offset; i < node.offset + node.count; i++){
+                        Type t[N], u[N], v[N];
+                        const unsigned int mask = a_packet.intersect(m_vertices[3*i], m_vertices[3*i+1], m_vertices[3*i+2], t, u, v);
+
+                        if(!mask) continue;
+
+                        for(int r = 0; r < N; r++){
+                            if((mask >> r & 1u) && t[r] >= (Type)0 && t[r] < a_t[r]){
+                                a_t[r] = t[r];
+                                best[r] = (int)i;
+                            }
+                        }
+                    }
+                }else{
+                    stack[top++] = node.offset;
+                    stack[top++] = current + 1;
+                }
+            }
+
+            unsigned int hits = 0;
+
+            for(int i = 0; i < N; i++){
+                if(best[i] < 0) continue;
+                a_triangles[i] = (int)m_indices[best[i]];
+                hits |= 1u << i;
+            }
+            return hits;
+        }
+
+        //! Return true if the ray hits any triangle at a distance in [0, \a a_tmax].
+        bool intersectAny(const Ray<Type> & a_ray, Type a_tmax = std::numeric_limits<Type>::max()) const
+        {
+            if(m_nodes.empty()) return false;
+
+            const Vec3<Type> & origin = a_ray.getOrigin();
+            const Vec3<Type> invdir = inverse(a_ray.getDirection());
+
+            unsigned int stack[MAX_DEPTH + 1];
+            int top = 0;
+            Type tnear;
+
+            stack[top++] = 0;
+
+            while(top > 0){
+                const unsigned int current = stack[--top];
+                const Node & node = m_nodes[current];
+
+                if(!intersect(node.bounds, origin, invdir, a_tmax, tnear)) continue;
+
+                if(node.count){
+                    for(unsigned int i = node.offset; i < node.offset + node.count; i++){
+                        Vec3<Type> tuv;
+                        if(a_ray.intersect(m_vertices[3*i], m_vertices[3*i+1], m_vertices[3*i+2], tuv) &&
+                           tuv[0] >= (Type)0 && tuv[0] <= a_tmax){
+                            return true;
+                        }
+                    }
+                }else{
+                    stack[top++] = node.offset;
+                    stack[top++] = current + 1;
+                }
+            }
+
+            return false;
+        }
+
+    private:
+        // Flattened node. The left child of an inner node is the next node.
+        struct Node
+        {
+            Box3<Type>   bounds;
+            unsigned int offset; //!< first triangle of a leaf, right child of an inner node
+            unsigned int count;  //!< number of triangles of a leaf, 0 for an inner node
+        };
+
+        // Triangle reference used during the build.
+        struct BuildRef
+        {
+            Box3<Type>   bounds;
+            Vec3<Type>   centroid;
+            unsigned int index;
+        };
+
+        // Top of the tree built serially: either a split or a subtree task.
+        struct Skeleton
+        {
+            Box3<Type>   bounds;
+            int          task;  //!< subtree task index, -1 for a split
+            unsigned int right; //!< skeleton index of the right child of a split
+        };
+
+        struct Task
+        {
+            unsigned int begin;
+            unsigned int end;
+            int          depth;
+        };
+
+        // Below MEDIAN_DEPTH the nodes are split in two halves, which bounds the depth of the tree
+        // (and the traversal stacks) to MAX_DEPTH for up to 2^32 triangles.
+        enum { NUM_BINS = 12, MAX_LEAF_SIZE = 8, PARALLEL_DEPTH = 6, PARALLEL_SIZE = 4096,
+               MAX_DEPTH = 64, MEDIAN_DEPTH = 32 };
+
+        std::vector<Node>         m_nodes;    //!< Depth-first nodes, the root is the first one
+        std::vector< Vec3<Type> > m_vertices; //!< Triangle vertices in leaf order
+        std::vector<unsigned int> m_indices;  //!< Index in the soup of the triangles in leaf order
+
+        static Vec3<Type> inverse(const Vec3<Type> & a_dir)
+        {
+            return Vec3<Type>((Type)1 / a_dir[0], (Type)1 / a_dir[1], (Type)1 / a_dir[2]);
+        }
+
+        // Slab test against the segment [0, a_tmax] of the ray. \a a_tnear receives the entry distance.
+        static bool intersect(const Box3<Type> & a_box, const Vec3<Type> & a_origin, const Vec3<Type> & a_invdir,
+                              Type a_tmax, Type & a_tnear)
+        {
+            Type tmin = (Type)0;
+            Type tmax = a_tmax;
+
+            for(int i = 0; i < 3; i++){
+                Type t0 = (a_box.getMin()[i] - a_origin[i]) * a_invdir[i];
+                Type t1 = (a_box.getMax()[i] - a_origin[i]) * a_invdir[i];
+                if(t0 > t1) std::swap(t0, t1);
+                tmin = t0 > tmin ? t0 : tmin;
+                tmax = t1 < tmax ? t1 : tmax;
+            }
+
+            a_tnear = tmin;
+
+            return tmin <= tmax;
+        }
+
+        static Type area(const Box3<Type> & a_box)
+        {
+            if(a_box.isEmpty()) return (Type)0;
+
+            Vec3<Type> size = a_box.getSize();
+
+            return size[0] * size[1] + size[1] * size[2] + size[2] * size[0];
+        }
+
+        static Box3<Type> bounds(const std::vector<BuildRef> & refs, unsigned int begin, unsigned int end, Box3<Type> & centroids)
+        {
+            Box3<Type> box;
+            centroids.makeEmpty();
+
+            for(unsigned int i = begin; i < end; i++){
+                box.extendBy(refs[i].bounds);
+                centroids.extendBy(refs[i].centroid);
+            }
+
+            return box;
+        }
+
+        // Partition [begin, end) with the binned SAH. Returns the split position, or begin to make a leaf.
+        static unsigned int split(std::vector<BuildRef> & refs, unsigned int begin, unsigned int end, int depth,
+                                  const Box3<Type> & box, const Box3<Type> & centroids)
+        {
+            const unsigned int count = end - begin;
+
+            if(count <= 2) return begin;
+
+            Vec3<Type> extent = centroids.getSize();
+            int axis = 0;
+            if(extent[1] > extent[axis]) axis = 1;
+            if(extent[2] > extent[axis]) axis = 2;
+
+            if(depth >= MEDIAN_DEPTH){
+                if(count <= MAX_LEAF_SIZE) return begin;
+
+                std::nth_element(refs.begin() + begin, refs.begin() + begin + count / 2, refs.begin() + end, CentroidLess(axis));
+                return begin + count / 2;
+            }
+
+            // all the centroids at the same place, split in the middle
+            if(extent[axis] <= (Type)0){
+                return (count > MAX_LEAF_SIZE) ? begin + count / 2 : begin;
+            }
+
+            Box3<Type> binBounds[NUM_BINS];
+            unsigned int binCounts[NUM_BINS] = {0};
+
+            const Type lo = centroids.getMin()[axis];
+            const Type scale = (Type)NUM_BINS / extent[axis];
+
+            for(unsigned int i = begin; i < end; i++){
+                int b = binIndex(refs[i].centroid[axis], lo, scale);
+                binCounts[b]++;
+                binBounds[b].extendBy(refs[i].bounds);
+            }
+
+            // sweep from the right to get the cost of every right side
+            Type rightCost[NUM_BINS];
+            Box3<Type> acc;
+            unsigned int accCount = 0;
+
+            for(int b = NUM_BINS - 1; b > 0; b--){
+                acc.extendBy(binBounds[b]);
+                accCount += binCounts[b];
+                rightCost[b] = accCount * area(acc);
+            }
+
+            acc.makeEmpty();
+            accCount = 0;
+
+            Type bestCost = std::numeric_limits<Type>::max();
+            int bestBin = -1;
+
+            for(int b = 0; b < NUM_BINS - 1; b++){
+                acc.extendBy(binBounds[b]);
+                accCount += binCounts[b];
+
+                if(accCount == 0 || accCount == count) continue;
+
+                Type cost = accCount * area(acc) + rightCost[b + 1];
+                if(cost < bestCost){
+                    bestCost = cost;
+                    bestBin = b;
+                }
+            }
+
+            // compare with the cost of a leaf, with a traversal step worth one triangle test
+            const Type leafCost = count * area(box);
+
+            if(bestBin < 0 || (bestCost + area(box) >= leafCost && count <= MAX_LEAF_SIZE)){
+                return (count > MAX_LEAF_SIZE) ? begin + count / 2 : begin;
+            }
+
+            typename std::vector<BuildRef>::iterator middle =
+                std::partition(refs.begin() + begin, refs.begin() + end, BinPredicate(axis, lo, scale, bestBin));
+
+            return (unsigned int)(middle - refs.begin());
+        }
+
+        static int binIndex(Type a_value, Type a_lo, Type a_scale)
+        {
+            int b = (int)((a_value - a_lo) * a_scale);
+            return b < 0 ? 0 : (b >= NUM_BINS ? NUM_BINS - 1 : b);
+        }
+
+        struct CentroidLess
+        {
+            CentroidLess(int a) : axis(a) {}
+
+            bool operator()(const BuildRef & r1, const BuildRef & r2) const
+            {
+                return r1.centroid[axis] < r2.centroid[axis];
+            }
+
+            int axis;
+        };
+
+        struct BinPredicate
+        {
+            BinPredicate(int a, Type l, Type s, int b) : axis(a), lo(l), scale(s), bin(b) {}
+
+            bool operator()(const BuildRef & ref) const
+            {
+                return binIndex(ref.centroid[axis], lo, scale) <= bin;
+            }
+
+            int axis;
+            Type lo;
+            Type scale;
+            int bin;
+        };
+
+        // Build the subtree of [begin, end) in depth-first order, appending to \a nodes.
+        static void buildRange(std::vector<BuildRef> & refs, unsigned int begin, unsigned int end, int depth, std::vector<Node> & nodes)
+        {
+            Box3<Type> centroids;
+            Box3<Type> box = bounds(refs, begin, end, centroids);
+
+            const std::size_t index = nodes.size();
+            nodes.push_back(Node());
+            nodes[index].bounds = box;
+
+            unsigned int middle = split(refs, begin, end, depth, box, centroids);
+
+            if(middle == begin || middle == end){
+                nodes[index].offset = begin;
+                nodes[index].count = end - begin;
+                return;
+            }
+
+            buildRange(refs, begin, middle, depth + 1, nodes);
+
+            nodes[index].offset = (unsigned int)nodes.size();
+            nodes[index].count = 0;
+
+            buildRange(refs, middle, end, depth + 1, nodes);
+        }
+
+        static void splitTop(std::vector<BuildRef> & refs, unsigned int begin, unsigned int end, int depth,
+                             std::vector<Skeleton> & skeleton, std::vector<Task> & tasks)
+        {
+            Box3<Type> centroids;
+            Skeleton node;
+            node.bounds = bounds(refs, begin, end, centroids);
+            node.task = -1;
+            node.right = 0;
+
+            unsigned int middle = begin;
+
+            if(depth < PARALLEL_DEPTH && end - begin > PARALLEL_SIZE){
+                middle = split(refs, begin, end, depth, node.bounds, centroids);
+            }
+
+            const std::size_t index = skeleton.size();
+
+            if(middle == begin || middle == end){
+                Task task;
+                task.begin = begin;
+                task.end = end;
+                task.depth = depth;
+                node.task = (int)tasks.size();
+                tasks.push_back(task);
+                skeleton.push_back(node);
+                return;
+            }
+
+            skeleton.push_back(node);
+            splitTop(refs, begin, middle, depth + 1, skeleton, tasks);
+            skeleton[index].right = (unsigned int)skeleton.size();
+            splitTop(refs, middle, end, depth + 1, skeleton, tasks);
+        }
+
+        void emit(const std::vector<Skeleton> & skeleton, unsigned int index, const std::vector< std::vector<Node> > & subtrees)
+        {
+            const Skeleton & node = skeleton[index];
+
+            if(node.task >= 0){
+                // the subtree nodes refer to their own array, shift the inner node children
+                const std::vector<Node> & subtree = subtrees[node.task];
+                const unsigned int base = (unsigned int)m_nodes.size();
+
+                for(std::size_t i = 0; i < subtree.size(); i++){
+                    m_nodes.push_back(subtree[i]);
+                    if(subtree[i].count == 0) m_nodes.back().offset += base;
+                }
+                return;
+            }
+
+            const std::size_t current = m_nodes.size();
+            m_nodes.push_back(Node());
+            m_nodes[current].bounds = node.bounds;
+            m_nodes[current].count = 0;
+
+            emit(skeleton, index + 1, subtrees);
+
+            m_nodes[current].offset = (unsigned int)m_nodes.size();
+
+            emit(skeleton, node.right, subtrees);
+        }
+    };
+
+    typedef Bvh<float>  Bvhf;
+    typedef Bvh<double> Bvhd;
+} // namespace gtl
+
+#endif
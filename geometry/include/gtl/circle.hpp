@@ -42,12 +42,6 @@ namespace gtl
             setValue(a_center, a_radius);
         }
 
-        //! Constructs an instance with initial values from \a a_circle.
-        Circle(const Circle<Type> & a_circle)
-        {
-            setValue(a_circle.m_center, a_circle.m_radius);
-        }
-
         //! Construct a circle from 2 Points.
         Circle(const Vec2<Type> & p1, const Vec2<Type> & p2)
         {
@@ -61,9 +55,6 @@ namespace gtl
             assert(setValue(p1,p2,p3)&&"Circle::Circle2(p1, p2, p3): points are colinear!");
         }
 
-        //! Default destructor does nothing.
-        virtual ~Circle(){}
-
         //! Change the center and radius
         void setValue(const Vec2<Type> & a_center, Type a_radius)
         {
@@ -189,6 +180,9 @@ namespace gtl
     typedef Circle<int>    Circlei; 
     typedef Circle<float>  Circlef; 
     typedef Circle<double> Circled;
+
+    GTL_ASSERT_PACKED(Circlef, float, 3);
+    GTL_ASSERT_PACKED(Circled, double, 3);
 } // namespace gtl
 
 #endif
@@ -32,15 +32,6 @@ namespace gtl
             setValue(real, imaginary);
         }
 
-        //! Constructs an instance using values from a given complex instance
-        Complex(const Complex<Type> & c)
-        {
-            setValue(c.m_real, c.m_imag);
-        }
-
-        //! Default destructor does nothing.
-        virtual ~Complex(){}
-
         //! Set new real and imaginary values for the complex. Returns reference to self.
         Complex<Type> & setValue(Type real, Type imaginary)
         {
@@ -244,6 +235,9 @@ namespace gtl
     typedef Complex<int>    Complexi;
     typedef Complex<float>  Complexf;
     typedef Complex<double> Complexd;
+
+    GTL_ASSERT_PACKED(Complexf, float, 2);
+    GTL_ASSERT_PACKED(Complexd, double, 2);
 }
 
 
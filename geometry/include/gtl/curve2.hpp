@@ -41,7 +41,7 @@ namespace gtl
 		} INTERPOL_TYPES;
 
 		//! The default constructor makes a line segment with 2 points.
-		Curve2()
+		Curve2() : m_current_interpol(INTERPOL_LINEAR)
 		{
 			Vec2<Type> pts[2];
 
@@ -55,7 +55,7 @@ namespace gtl
 		}
 
 		//! Constructs a curve from the provided list of 2D points.
-		Curve2(const Vec2<Type> *pts, int num_points)
+		Curve2(const Vec2<Type> *pts, int num_points) : m_current_interpol(INTERPOL_LINEAR)
 		{
 			if (setPoints(pts, num_points) < 0)
 				Curve2();	// if setVertices fails, construct default polyhedron...
@@ -76,6 +76,9 @@ namespace gtl
 				case INTERPOL_LINEAR:
 					init_linear(PointSet2<Type>::getPointVector(), PointSet2<Type>::getNumPoints());
 					break;
+
+				default:
+					break;
 			}
 		}
 
@@ -128,22 +131,94 @@ namespace gtl
 		//! returns 0 on success, -1 on error.
 		int getPoint(Type x, Vec2<Type> &result) const
 		{
+			if (m_interpol_x.empty())
+				return -1;
+
 			result.x() = x;
+			result.y() = interpolate((double)x, locate((double)x));
 
-			switch(m_current_interpol)
+			return 0;
+		}
+
+		//! \brief Puts into "ys" the interpolated y values of the curve at the "n" positions "xs".
+		//!
+		//! The interval search starts from the previous one, so sorted positions are evaluated in O(n + number of points).
+		void getPoints(const Type *xs, Type *ys, std::size_t n) const
+		{
+			const std::size_t num = m_interpol_x.size();
+
+			if (m_current_interpol != INTERPOL_AKIMA || num < 2)
 			{
-				case INTERPOL_LINEAR:
-					result.y() = get_linear(x);
-					return 0;
+				Cursor cursor(*this);
 
-				case INTERPOL_AKIMA:
-					result.y() = get_akima(x);
-					return 0;
+				for (std::size_t i = 0; i < n; i++)
+					ys[i] = cursor.getY(xs[i]);
+
+				return;
+			}
+
+			// locate a chunk of positions, then evaluate all their polynomials at once
+			double x[EVAL_CHUNK], y[EVAL_CHUNK];
+			std::size_t segments[EVAL_CHUNK];
+			std::size_t hint = 1;
+
+			for (std::size_t first = 0; first < n; first += EVAL_CHUNK)
+			{
+				const std::size_t count = std::min(n - first, (std::size_t)EVAL_CHUNK);
+
+				for (std::size_t i = 0; i < count; i++)
+				{
+					x[i] = (double)xs[first + i];
+					hint = locate(x[i], hint);
+					segments[i] = std::min(hint, num - 1) - 1;
+				}
+
+				get_akima(x, segments, y, count);
+
+				for (std::size_t i = 0; i < count; i++)
+					ys[first + i] = (Type)y[i];
 			}
-			
-			return -1;
 		}
 
+		/*!
+		  \class Cursor curve2.hpp gtl/curve2.hpp
+		  \brief Evaluates a curve at successive x positions.
+
+		  The interval of the previous position is used as a hint to find the next one,
+		  which makes monotone sweeps cost O(1) per evaluation instead of O(log n).
+		  The curve must outlive the cursor and must not be changed while it is used.
+		  */
+		class Cursor
+		{
+		public:
+			//! Constructs a cursor at the start of \a curve.
+			Cursor(const Curve2<Type> &curve) : m_curve(curve), m_index(1)
+			{
+			}
+
+			//! Returns the interpolated y value of the curve at position x.
+			Type getY(Type x)
+			{
+				if (m_curve.m_interpol_x.empty())
+					return (Type)0;
+
+				m_index = m_curve.locate((double)x, m_index);
+
+				return m_curve.interpolate((double)x, m_index);
+			}
+
+			//! Puts into "result" the interpolated point of the curve at position x.
+			void getPoint(Type x, Vec2<Type> &result)
+			{
+				result.x() = x;
+				result.y() = getY(x);
+			}
+
+		private:
+			const Curve2<Type> &m_curve;
+			std::size_t m_index;
+		};
+
 		// ! \brief Establishes a chord along the curve starting a point "start_pt" of length "chord_len", and
 		// ! returns the end point of this chord in "end_pt".
 		// !
@@ -167,14 +242,13 @@ namespace gtl
 			}
 
 			// all seems good, now figure out the end_pt
-			Vec2<double> pt;
-			if (getPoint(start_pt.x() + chord_len, pt))
-				return -1;
+			Cursor cursor(*this);
+			Vec2<Type> pt;
+			cursor.getPoint(start_pt.x() + chord_len, pt);
 
 			while ((start_pt - pt).length() > chord_len && pt.x() > start_pt.x())
 			{
-				if (getPoint(pt.x() - precision, pt))
-					return -1;
+				cursor.getPoint(pt.x() - precision, pt);
 			}
 
 			pt.x() += precision;
@@ -184,52 +258,32 @@ namespace gtl
 			return 0;
 		}
 
-		//! \brief Goes through all the interpolated curve points by an x increment of "precision" until
-		//! it finds the point with the minimum y value.
-		void getMinY(Vec2<Type> &pt, Type precision) const
+		//! \brief Finds the point of the curve with the minimum y value, between the first and the last initial points.
+		//!
+		//! The extrema are computed exactly from the interpolation polynomial of every interval.
+		void getMinY(Vec2<Type> &pt) const
 		{
-			Vec2<Type> start_pt, end_pt;
-			Vec2<Type> min_pt;
-
-			start_pt = PointSet2<Type>::getMinX();
-			end_pt = PointSet2<Type>::getMaxX();
-
-			min_pt = start_pt;
-			for (Type x = start_pt.x() + precision; x <= end_pt.x(); x+=precision)
-			{
-				Vec2<Type> tmp_pt;
-				if (getPoint(x, tmp_pt) < 0)
-					continue;
-
-				if (tmp_pt.y() < min_pt.y())
-					min_pt = tmp_pt;
-			}
-
-			pt = min_pt;
+			getExtremum(pt, -1.0);
 		}
 
-		//! \brief Goes through all the interpolated curve points by an x increment of "precision" until
-		//! it finds the point with the maximum y value.
-		void getMaxY(Vec2<Type> &pt, Type precision) const
+		//! \brief Same as getMinY(pt), "precision" is not used anymore.
+		void getMinY(Vec2<Type> &pt, Type /*precision*/) const
 		{
-			Vec2<Type> start_pt, end_pt;
-			Vec2<Type> max_pt;
-
-			start_pt = PointSet2<Type>::getMinX();
-			end_pt = PointSet2<Type>::getMaxX();
-
-			max_pt = start_pt;
-			for (Type x = start_pt.x() + precision; x <= end_pt.x(); x+=precision)
-			{
-				Vec2<Type> tmp_pt;
-				if (getPoint(x, tmp_pt) < 0)
-					continue;
+			getMinY(pt);
+		}
 
-				if (tmp_pt.y() > max_pt.y())
-					max_pt = tmp_pt;
-			}
+		//! \brief Finds the point of the curve with the maximum y value, between the first and the last initial points.
+		//!
+		//! The extrema are computed exactly from the interpolation polynomial of every interval.
+		void getMaxY(Vec2<Type> &pt) const
+		{
+			getExtremum(pt, 1.0);
+		}
 
-			pt = max_pt;
+		//! \brief Same as getMaxY(pt), "precision" is not used anymore.
+		void getMaxY(Vec2<Type> &pt, Type /*precision*/) const
+		{
+			getMaxY(pt);
 		}
 
 		//! \brief Performs a rotation and re-interpolates from the new points
@@ -240,33 +294,76 @@ namespace gtl
 		}
 
 		//! \brief Finds all intersection points of the two curves, between x_start and x_end inclusively.
-		void findIntersections(Curve2<Type> seg, Type precision_x, Type precision_y, Type x_start, Type x_end)
+		//!
+		//! The knots of both curves split [x_start, x_end] in intervals where the difference of the curves
+		//! is a single polynomial, whose roots are solved for. Where the curves are equal on a whole interval,
+		//! only the start of the interval is reported.
+		void findIntersections(const Curve2<Type> &seg, Type x_start, Type x_end)
 		{
-			int intersect_pt_counter = 0;
 			m_intersect_points.clear();	// reset the list
 
-			// for all x values along the segment...
-			for (Type x = x_start; x <= x_end; x+=precision_x)
+			if (m_interpol_x.empty() || seg.m_interpol_x.empty() || x_start > x_end)
+				return;
+
+			// merged sweep over the knots of both curves
+			const double x_last = (double)x_end;
+			std::vector<double>::const_iterator k1 = std::upper_bound(m_interpol_x.begin(), m_interpol_x.end(), (double)x_start);
+			std::vector<double>::const_iterator k2 = std::upper_bound(seg.m_interpol_x.begin(), seg.m_interpol_x.end(), (double)x_start);
+			std::vector<double> roots;
+			double a = (double)x_start;
+
+			for (;;)
 			{
-				Vec2<Type> curve_pt;
-				Vec2<Type> seg_pt;
+				double b = x_last;
 
-				if (getPoint(x, curve_pt) < 0)
-					continue;
+				if (k1 != m_interpol_x.end() && *k1 < b)
+					b = *k1;
+				if (k2 != seg.m_interpol_x.end() && *k2 < b)
+					b = *k2;
 
-				if (seg.getPoint(x, seg_pt) < 0)
-					continue;
+				const bool last = !(b < x_last);
 
-				if (curve_pt.y() + precision_y >= seg_pt.y() &&
-				    curve_pt.y() - precision_y <= seg_pt.y())
-				{
-					m_intersect_points.push_back(seg_pt);
+				// difference of the two polynomials in terms of x - a
+				const double mid = 0.5 * (a + b);
+				double c1[4], c2[4], d[4];
+				double o1 = getPolynomial(mid, c1);
+				double o2 = seg.getPolynomial(mid, c2);
+
+				shiftPolynomial(c1, a - o1);
+				shiftPolynomial(c2, a - o2);
 
-					intersect_pt_counter++;
+				for (int c = 0; c < 4; c++)
+					d[c] = c1[c] - c2[c];
+
+				roots.clear();
+				solveCubic(d, b - a, last, std::abs(c1[0]) + std::abs(c2[0]), roots);
+
+				for (std::size_t r = 0; r < roots.size(); r++)
+				{
+					Vec2<Type> pt;
+					pt.x() = (Type)(a + roots[r]);
+					pt.y() = (Type)evalPolynomial(c2, roots[r]);
+					m_intersect_points.push_back(pt);
 				}
+
+				if (last)
+					break;
+
+				while (k1 != m_interpol_x.end() && !(*k1 > b))
+					++k1;
+				while (k2 != seg.m_interpol_x.end() && !(*k2 > b))
+					++k2;
+
+				a = b;
 			}
 		}
 
+		//! \brief Same as findIntersections(seg, x_start, x_end), the precisions are not used anymore.
+		void findIntersections(const Curve2<Type> &seg, Type /*precision_x*/, Type /*precision_y*/, Type x_start, Type x_end)
+		{
+			findIntersections(seg, x_start, x_end);
+		}
+
 		//! \brief Returns the number of intersection points found by findIntersections.
 		unsigned int getNumIntersectPoints() const
 		{
@@ -276,14 +373,16 @@ namespace gtl
 		//! \brief Returns a specific intersection point found by findIntersections.
 		//!
 		//! returns 0 on success, -1 on failure.
-		int getIntersectPoint(int pt_index, Vec2<double> &pt) const
+		int getIntersectPoint(int pt_index, Vec2<Type> &pt) const
 		{
-			if (pt_index >= (int)m_intersect_points.size())
+			if (pt_index < 0 || pt_index >= (int)m_intersect_points.size())
 			{
 				return -1;
 			}
 
 			pt = m_intersect_points[pt_index];
+
+			return 0;
 		}
 
 	private:
@@ -293,8 +392,9 @@ namespace gtl
 
 		std::vector<double> m_interpol_x;	// x values for the initial points
 		std::vector<double> m_interpol_y;	// y values for the initial points
-		std::vector<double> m_interpol_z;	// for akima interpolation only
-		std::vector<double> m_interpol_t;	// for akima interpolation only
+		std::vector<double> m_akima;		// for akima interpolation only: 4 polynomial coefficients per interval
+
+		enum { EVAL_CHUNK = 256 };			// number of positions located before being evaluated by getPoints
 
 		void init_linear(std::vector< Vec2<Type> > &pts, std::size_t num_points)
 		{
@@ -328,12 +428,9 @@ namespace gtl
 			
 		    m_interpol_y.clear();
 		    m_interpol_y.resize(num_points);
-			    
-		    m_interpol_z.clear();
-		    m_interpol_z.resize(num_points);
-			    
-		    m_interpol_t.clear();
-		    m_interpol_t.resize(num_points + 3);
+
+		    std::vector<double> interpol_z(num_points);	// slopes at the initial points
+		    std::vector<double> interpol_t(num_points + 3);	// slopes of the intervals, extended by 2 on both sides
 
 		    for (std::size_t i = 0; i < num_points; ++i)
 		    {
@@ -341,49 +438,341 @@ namespace gtl
 			    m_interpol_y[i] = pts[i].y();
 		    }
 
-		    for (int i = 0; i < num_points - 1; ++i)
+		    for (std::size_t i = 0; i + 1 < num_points; ++i)
 		    {
-			    m_interpol_t[i + 2] = (pts[i + 1].y() - pts[i].y()) / (pts[i + 1].x() - pts[i].x());
+			    interpol_t[i + 2] = (m_interpol_y[i + 1] - m_interpol_y[i]) / (m_interpol_x[i + 1] - m_interpol_x[i]);
 		    }
 
-		    m_interpol_t[1] = (2.0 * m_interpol_t[2]) - m_interpol_t[3];
-		    m_interpol_t[0] = (2.0 * m_interpol_t[1]) - m_interpol_t[2];
+		    interpol_t[1] = (2.0 * interpol_t[2]) - interpol_t[3];
+		    interpol_t[0] = (2.0 * interpol_t[1]) - interpol_t[2];
 
-		    m_interpol_t[num_points + 1] = (2.0 * m_interpol_t[num_points]) - m_interpol_t[num_points - 1];
-		    m_interpol_t[num_points + 2] = (2.0 * m_interpol_t[num_points + 1]) - m_interpol_t[num_points];
+		    interpol_t[num_points + 1] = (2.0 * interpol_t[num_points]) - interpol_t[num_points - 1];
+		    interpol_t[num_points + 2] = (2.0 * interpol_t[num_points + 1]) - interpol_t[num_points];
 
-		    for (int i = 0; i < num_points; ++i)
+		    for (std::size_t i = 0; i < num_points; ++i)
 		    {
-			    double left = fabs(m_interpol_t[i + 1] - m_interpol_t[i]);
-			    double right = fabs(m_interpol_t[i + 3] - m_interpol_t[i + 2]);
+			    double left = fabs(interpol_t[i + 1] - interpol_t[i]);
+			    double right = fabs(interpol_t[i + 3] - interpol_t[i + 2]);
 
 			    // check for division by zero
 			    if (left + right != 0.0)
 			    {
-				    m_interpol_z[i] = ((right * m_interpol_t[i + 1]) + (left * m_interpol_t[i + 2])) / (left + right);
+				    interpol_z[i] = ((right * interpol_t[i + 1]) + (left * interpol_t[i + 2])) / (left + right);
 			    } else {
 				    // special case
-				    m_interpol_z[i] = (m_interpol_t[i + 1] + m_interpol_t[i + 2]) / 2.0;
+				    interpol_z[i] = (interpol_t[i + 1] + interpol_t[i + 2]) / 2.0;
 			    }
 		    }
+
+		    // polynomial of every interval in terms of x - x[i], evaluated with the Horner scheme
+		    m_akima.resize(4 * (num_points - 1));
+
+		    for (std::size_t i = 0; i + 1 < num_points; ++i)
+		    {
+			    const double h = m_interpol_x[i + 1] - m_interpol_x[i];
+			    const double t = interpol_t[i + 2];
+			    double *c = &m_akima[4 * i];
+
+			    c[0] = m_interpol_y[i];
+			    c[1] = interpol_z[i];
+			    c[2] = (3.0 * t - 2.0 * interpol_z[i] - interpol_z[i + 1]) / h;
+			    c[3] = (interpol_z[i] + interpol_z[i + 1] - 2.0 * t) / (h * h);
+		    }
 		}
 
-		Type get_linear(Type x_pos) const
+		// Returns the index of the first initial point at or after x, searching from the second point: in [1, n].
+		std::size_t locate(double x) const
+		{
+			return std::lower_bound(m_interpol_x.begin() + 1, m_interpol_x.end(), x) - m_interpol_x.begin();
+		}
+
+		// Same as locate(x), starting the search from the index found for a previous position.
+		std::size_t locate(double x, std::size_t hint) const
+		{
+			const std::size_t n = m_interpol_x.size();
+
+			if (hint < 1 || hint > n)
+				return locate(x);
+
+			if (hint < n && x > m_interpol_x[hint])
+			{
+				// gallop forward, the index is in [lo, hi]
+				std::size_t lo = hint + 1, hi = lo, step = 1;
+
+				while (hi < n && x > m_interpol_x[hi])
+				{
+					lo = hi + 1;
+					step *= 2;
+					hi = lo + step;
+				}
+
+				if (hi > n)
+					hi = n;
+
+				return std::lower_bound(m_interpol_x.begin() + lo, m_interpol_x.begin() + hi, x) - m_interpol_x.begin();
+			}
+
+			if (hint > 1 && !(x > m_interpol_x[hint - 1]))
+			{
+				// gallop backward, the index is in [lo, hi]
+				std::size_t hi = hint - 1, step = 1;
+				std::size_t lo = hi > step ? hi - step : 1;
+
+				while (lo > 1 && !(x > m_interpol_x[lo - 1]))
+				{
+					hi = lo - 1;
+					step *= 2;
+					lo = hi > step ? hi - step : 1;
+				}
+
+				return std::lower_bound(m_interpol_x.begin() + lo, m_interpol_x.begin() + hi, x) - m_interpol_x.begin();
+			}
+
+			return hint;
+		}
+
+		// Interpolates at x, "index" being the result of locate(x).
+		Type interpolate(double x, std::size_t index) const
+		{
+			if (m_interpol_x.size() < 2)
+				return (Type)m_interpol_y[0];
+
+			switch(m_current_interpol)
+			{
+				case INTERPOL_AKIMA:
+					// extrapolate with the first and last intervals
+					return get_akima(x, std::min(index, m_interpol_x.size() - 1) - 1);
+
+				default:
+					return get_linear(x, index);
+			}
+		}
+
+		// Puts into c the polynomial of the interval i: y = c[0] + c[1] s + c[2] s^2 + c[3] s^3, s = x - x[i].
+		void getSegmentPolynomial(std::size_t i, double c[4]) const
+		{
+			if (m_current_interpol == INTERPOL_AKIMA)
+			{
+				std::copy(&m_akima[4 * i], &m_akima[4 * i] + 4, c);
+			} else {
+				c[0] = m_interpol_y[i];
+				c[1] = (m_interpol_y[i + 1] - m_interpol_y[i]) / (m_interpol_x[i + 1] - m_interpol_x[i]);
+				c[2] = 0.0;
+				c[3] = 0.0;
+			}
+		}
+
+		// Puts into c the polynomial used to interpolate at x, and returns its origin (see getSegmentPolynomial).
+		double getPolynomial(double x, double c[4]) const
+		{
+			const std::size_t n = m_interpol_x.size();
+			const std::size_t index = locate(x);
+
+			if (n < 2 || (m_current_interpol != INTERPOL_AKIMA && index >= n))
+			{
+				// constant: the single point, or the end of a linear curve
+				c[0] = m_interpol_y[index >= n ? n - 1 : 0];
+				c[1] = c[2] = c[3] = 0.0;
+
+				return m_interpol_x[n - 1];
+			}
+
+			const std::size_t i = std::min(index, n - 1) - 1;
+
+			getSegmentPolynomial(i, c);
+
+			return m_interpol_x[i];
+		}
+
+		static double evalPolynomial(const double c[4], double s)
+		{
+			return ((c[3] * s + c[2]) * s + c[1]) * s + c[0];
+		}
+
+		// Rewrites c in terms of s - delta.
+		static void shiftPolynomial(double c[4], double delta)
+		{
+			c[0] = evalPolynomial(c, delta);
+			c[1] = c[1] + (2.0 * c[2] + 3.0 * c[3] * delta) * delta;
+			c[2] = c[2] + 3.0 * c[3] * delta;
+		}
+
+		// Puts the real roots of a s^2 + b s + c into roots, sorted. Returns their number.
+		static int solveQuadratic(double a, double b, double c, double roots[2])
+		{
+			if (a == 0.0)
+			{
+				if (b == 0.0)
+					return 0;
+
+				roots[0] = -c / b;
+				return 1;
+			}
+
+			const double disc = b * b - 4.0 * a * c;
+
+			if (disc < 0.0)
+				return 0;
+
+			// avoids the cancellation of -b + sqrt(disc)
+			const double q = -0.5 * (b + (b < 0.0 ? -std::sqrt(disc) : std::sqrt(disc)));
+
+			if (q == 0.0)
+			{
+				roots[0] = 0.0;
+				return 1;
+			}
+
+			roots[0] = q / a;
+			roots[1] = c / q;
+
+			if (roots[0] > roots[1])
+				std::swap(roots[0], roots[1]);
+
+			return 2;
+		}
+
+		// Puts into s the points where the derivative of c vanishes inside (0, length), sorted. Returns their number.
+		static int getCriticalPoints(const double c[4], double length, double s[2])
+		{
+			double roots[2];
+			int n = solveQuadratic(3.0 * c[3], 2.0 * c[2], c[1], roots);
+			int count = 0;
+
+			for (int r = 0; r < n; r++)
+			{
+				if (roots[r] > 0.0 && roots[r] < length)
+					s[count++] = roots[r];
+			}
+
+			return count;
+		}
+
+		// Appends the roots of c inside [0, length), or [0, length] when include_end is set.
+		// The interval is split at the critical points, the roots of each monotone piece are bisected.
+		static void solveCubic(const double c[4], double length, bool include_end, double scale, std::vector<double> &roots)
+		{
+			const double tolerance = 1E-12 * (scale + 1.0);
+
+			if (std::abs(c[0]) <= tolerance && std::abs(c[1]) * length <= tolerance &&
+				std::abs(c[2]) * length * length <= tolerance && std::abs(c[3]) * length * length * length <= tolerance)
+			{
+				// the curves are equal on the interval
+				roots.push_back(0.0);
+				return;
+			}
+
+			double s[4], f[4];
+			int n = 0;
+
+			// an interval of zero length has its end on its start, which is sampled once
+			s[n++] = 0.0;
+
+			if (length > 0.0)
+			{
+				n += getCriticalPoints(c, length, s + n);
+				s[n++] = length;
+			}
+
+			for (int k = 0; k < n; k++)
+				f[k] = evalPolynomial(c, s[k]);
+
+			for (int k = 0; k < n; k++)
+			{
+				if (k > 0 && k == n - 1 && !include_end)
+					break;
+
+				// a root on a split point, or a double root touching zero at a critical point
+				if (f[k] == 0.0 || (k > 0 && k < n - 1 && std::abs(f[k]) <= tolerance))
+				{
+					roots.push_back(s[k]);
+					continue;
+				}
+
+				if (k == n - 1 || f[k + 1] == 0.0 || (f[k] < 0.0) == (f[k + 1] < 0.0))
+					continue;
+
+				double lo = s[k], hi = s[k + 1], flo = f[k];
+
+				for (int it = 0; it < 200; it++)
+				{
+					const double mid = 0.5 * (lo + hi);
+
+					if (!(mid > lo && mid < hi))
+						break;
+
+					const double fmid = evalPolynomial(c, mid);
+
+					if (fmid == 0.0)
+					{
+						lo = hi = mid;
+						break;
+					}
+
+					if ((fmid < 0.0) == (flo < 0.0))
+					{
+						lo = mid;
+						flo = fmid;
+					} else {
+						hi = mid;
+					}
+				}
+
+				roots.push_back(0.5 * (lo + hi));
+			}
+		}
+
+		// Finds the point with the lowest (sign < 0) or highest (sign > 0) y value.
+		void getExtremum(Vec2<Type> &pt, double sign) const
+		{
+			const std::size_t n = m_interpol_x.size();
+
+			if (n == 0)
+				return;
+
+			double best_x = m_interpol_x[0];
+			double best_y = m_interpol_y[0];
+
+			for (std::size_t i = 0; i + 1 < n; i++)
+			{
+				double c[4], s[4];
+				int count = 0;
+
+				getSegmentPolynomial(i, c);
+
+				count = getCriticalPoints(c, m_interpol_x[i + 1] - m_interpol_x[i], s);
+
+				for (int k = 0; k < count; k++)
+				{
+					const double y = evalPolynomial(c, s[k]);
+
+					if (sign * (y - best_y) > 0.0)
+					{
+						best_x = m_interpol_x[i] + s[k];
+						best_y = y;
+					}
+				}
+
+				if (sign * (m_interpol_y[i + 1] - best_y) > 0.0)
+				{
+					best_x = m_interpol_x[i + 1];
+					best_y = m_interpol_y[i + 1];
+				}
+			}
+
+			pt.x() = (Type)best_x;
+			pt.y() = (Type)best_y;
+		}
+
+		Type get_linear(double x, std::size_t i) const
 		{
-			int i = 1;
 			double a = 0.0;
 			double y = 0.0;
-			double x = (double)x_pos;
 
-			while (x > m_interpol_x[i])
-				i++;
-
-			if (i >= (int)PointSet2<Type>::getNumPoints())
+			if (i >= m_interpol_x.size())
 			{
 				// special case: we want the y of the last point
-				y = PointSet2<Type>::getMaxX().y();
-
-				return (Type)y;
+				return (Type)m_interpol_y.back();
 			}
 
 			a = (x - m_interpol_x[i - 1]) / (m_interpol_x[i] - m_interpol_x[i - 1]);
@@ -393,25 +782,44 @@ namespace gtl
 			return (Type)y;
 		}
 
-		Type get_akima(Type x_pos) const
+		Type get_akima(double x, std::size_t i) const
 		{
-			int i = 0;
-			double dist_left = 0.0;
-			double dist_right = 0.0;
-			double y = 0.0;
-			double x = (double)x_pos;
+			const double *c = &m_akima[4 * i];
+			const double s = x - m_interpol_x[i];
 
-			while (x > m_interpol_x[i + 1])
-				i++;
+			return (Type)(((c[3] * s + c[2]) * s + c[1]) * s + c[0]);
+		}
 
-			dist_right = m_interpol_x[i + 1] - m_interpol_x[i];
-			dist_left = x - m_interpol_x[i];
+		// Evaluates the akima polynomials of the intervals "segments" at the positions xs.
+		void get_akima(const double *xs, const std::size_t *segments, double *ys, std::size_t n) const
+		{
+			std::size_t i = 0;
 
-			y = m_interpol_y[i] + (m_interpol_z[i] * dist_left) + (3.0 * m_interpol_t[i + 2] - 2.0 * m_interpol_z[i] - m_interpol_z[i + 1])
-				* SQR(dist_left) / dist_right + (m_interpol_z[i] + m_interpol_z[i + 1] - 2.0 * m_interpol_t[i + 2]) 
-				* pow(dist_left, 3.0) / SQR(dist_right);
+#ifdef GTL_SSE2
+			// two positions per iteration, the coefficients of both intervals are transposed
+			for (; i + 2 <= n; i += 2)
+			{
+				const double *c0 = &m_akima[4 * segments[i]];
+				const double *c1 = &m_akima[4 * segments[i + 1]];
+				const __m128d lo0 = _mm_loadu_pd(c0), hi0 = _mm_loadu_pd(c0 + 2);
+				const __m128d lo1 = _mm_loadu_pd(c1), hi1 = _mm_loadu_pd(c1 + 2);
+				const __m128d s = _mm_sub_pd(_mm_loadu_pd(xs + i), _mm_set_pd(m_interpol_x[segments[i + 1]], m_interpol_x[segments[i]]));
+
+				__m128d y = _mm_unpackhi_pd(hi0, hi1);
+				y = _mm_add_pd(_mm_mul_pd(y, s), _mm_unpacklo_pd(hi0, hi1));
+				y = _mm_add_pd(_mm_mul_pd(y, s), _mm_unpackhi_pd(lo0, lo1));
+				y = _mm_add_pd(_mm_mul_pd(y, s), _mm_unpacklo_pd(lo0, lo1));
+
+				_mm_storeu_pd(ys + i, y);
+			}
+#endif
+			for (; i < n; i++)
+			{
+				const double *c = &m_akima[4 * segments[i]];
+				const double s = xs[i] - m_interpol_x[segments[i]];
 
-			return (Type)y;
+				ys[i] = ((c[3] * s + c[2]) * s + c[1]) * s + c[0];
+			}
 		}
 	};
 
@@ -0,0 +1,432 @@
+/*
+_______________________________________________________________________
+__________________________ G E O M E T R Y ____________________________
+|
+| THIS FILE IS PART OF THE GEOMETRY TEMPLATE LIBRARY.
+| USE, DISTRIBUTION AND REPRODUCTION OF THIS LIBRARY SOURCE IS
+| GOVERNED BY A BSD-STYLE SOURCE LICENSE.
+| PLEASE READ THESE TERMS BEFORE DISTRIBUTING.
+_______________________________________________________________________
+_______________________________________________________________________
+*/
+
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#include <gtl/gtl.hpp>
+#include <gtl/vec3.hpp>
+#include <gtl/matrix4.hpp>
+#include <gtl/plane.hpp>
+#include <gtl/box3.hpp>
+#include <gtl/sphere.hpp>
+
+namespace gtl
+{
+    /*!
+    \class Frustum Frustum.hpp geometry/Frustum.hpp
+    \brief Convex volume bounded by six planes, usually the view volume of a camera.
+    \ingroup base
+
+    The planes face inwards: a point is inside when it is in the half space of every plane,
+    see Plane::isInHalfSpace(). They are extracted from a view projection matrix, or set one
+    by one.
+
+    The boxes and spheres are classified as outside, intersecting or inside of the frustum,
+    one by one or by arrays. The array versions test four float objects at once with SSE2
+    when available, and split large arrays between threads when OpenMP is enabled. They can
+    keep for every object the plane which rejected it last, which is tested first the next
+    time, since an object outside of the view usually stays outside of the same plane.
+
+    \sa Plane, Box3, Sphere
+    */
+    template<typename Type>
+    class Frustum
+    {
+    public:
+        //! Index of the planes.
+        enum { LEFT_PLANE, RIGHT_PLANE, BOTTOM_PLANE, TOP_PLANE, NEAR_PLANE, FAR_PLANE, NUM_PLANES };
+
+        //! Classification of an object, as stored by cull().
+        enum Result { OUTSIDE = 0, INTERSECT = 1, INSIDE = 2 };
+
+        //! The default constructor makes the cube from -1 to 1, the clip volume of the identity matrix.
+        Frustum()
+        {
+            setValue(Matrix4<Type>());
+        }
+
+        //! Constructs the frustum of a view projection matrix. \sa setValue().
+        explicit Frustum(const Matrix4<Type> & a_matrix, bool a_zero_to_one = false)
+        {
+            setValue(a_matrix, a_zero_to_one);
+        }
+
+        //! Constructs a frustum from six planes facing inwards, in the order of the plane indices.
+        Frustum(const Plane<Type> a_planes[NUM_PLANES])
+        {
+            for(int p = 0; p < NUM_PLANES; p++) setPlane(p, a_planes[p]);
+        }
+
+        /*! Extract the planes of the matrix \a a_matrix, which maps points to clip coordinates with
+        Matrix4::multVecMatrix(), such as a view matrix multiplied on the right by a projection matrix.
+        The clip volume is -w <= x, y, z <= w, or 0 <= z <= w if \a a_zero_to_one is true.
+        */
+        void setValue(const Matrix4<Type> & a_matrix, bool a_zero_to_one = false)
+        {
+            // Gribb and Hartmann: a clip coordinate is the dot product of the point with a column
+            const Matrix4<Type> & m = a_matrix;
+            Plane<Type> plane;
+
+            for(int p = 0; p < NUM_PLANES; p++){
+                const int column = p / 2;
+                const Type sign = (p % 2) ? (Type)-1 : (Type)1;
+                const Type w = (p == NEAR_PLANE && a_zero_to_one) ? (Type)0 : (Type)1;
+
+                plane.setValue(w * m[0][3] + sign * m[0][column],
+                               w * m[1][3] + sign * m[1][column],
+                               w * m[2][3] + sign * m[2][column],
+                               w * m[3][3] + sign * m[3][column]);
+                setPlane(p, plane);
+            }
+        }
+
+        //! Set the plane \a a_index, whose normal faces the inside of the frustum.
+        void setPlane(int a_index, const Plane<Type> & a_plane)
+        {
+            const Vec3<Type> & normal = a_plane.getNormal();
+
+            m_planes[a_index] = a_plane;
+            m_nx[a_index] = normal[0];
+            m_ny[a_index] = normal[1];
+            m_nz[a_index] = normal[2];
+            m_ax[a_index] = std::abs(normal[0]);
+            m_ay[a_index] = std::abs(normal[1]);
+            m_az[a_index] = std::abs(normal[2]);
+            m_d[a_index] = a_plane.getDistanceFromOrigin();
+
+#ifdef GTL_SSE2
+            const Type values[7] = { m_nx[a_index], m_ny[a_index], m_nz[a_index], m_d[a_index], m_ax[a_index], m_ay[a_index], m_az[a_index] };
+
+            for(int v = 0; v < 7; v++){
+                for(int l = 0; l < 4; l++) m_lanes[a_index][v][l] = (float)values[v];
+            }
+#endif
+        }
+
+        //! Return the plane \a a_index.
+        const Plane<Type> & getPlane(int a_index) const
+        {
+            return m_planes[a_index];
+        }
+
+        //! Check if \a a_point is inside of the frustum, bounds included.
+        bool contains(const Vec3<Type> & a_point) const
+        {
+            for(int p = 0; p < NUM_PLANES; p++){
+                if(!m_planes[p].isInHalfSpace(a_point)) return false;
+            }
+            return true;
+        }
+
+        //! Classify \a a_box, an empty box is outside.
+        Result classify(const Box3<Type> & a_box) const
+        {
+            unsigned char hint = 0;
+
+            return classifyBox(a_box, hint);
+        }
+
+        //! Classify \a a_sphere.
+        Result classify(const Sphere<Type> & a_sphere) const
+        {
+            unsigned char hint = 0;
+
+            return classifySphere(a_sphere, hint);
+        }
+
+        /*! Classify the \a n boxes of \a a_boxes and store their Result in \a a_results.
+        If \a a_hints is not NULL, it holds for every box the index of the plane to test first,
+        and receives the plane which rejected the boxes found outside. The hints start at 0
+        and are kept from one frame to the next. Return the number of boxes which are not outside.
+        */
+        std::size_t cull(const Box3<Type> * a_boxes, std::size_t n, unsigned char * a_results, unsigned char * a_hints = NULL) const
+        {
+            return cullBlocks(a_boxes, n, a_results, a_hints);
+        }
+
+        //! Same as above for \a n spheres.
+        std::size_t cull(const Sphere<Type> * a_spheres, std::size_t n, unsigned char * a_results, unsigned char * a_hints = NULL) const
+        {
+            return cullBlocks(a_spheres, n, a_results, a_hints);
+        }
+
+        /*! Classify the boxes of \a a_boxes, \a a_results is resized to one Result per box. \a a_hints
+        is resized as well, its new entries are 0. Return the number of boxes which are not outside.
+        */
+        std::size_t cull(const std::vector< Box3<Type> > & a_boxes, std::vector<unsigned char> & a_results, std::vector<unsigned char> & a_hints) const
+        {
+            a_results.resize(a_boxes.size());
+            a_hints.resize(a_boxes.size(), 0);
+
+            return a_boxes.empty() ? 0 : cull(&a_boxes[0], a_boxes.size(), &a_results[0], &a_hints[0]);
+        }
+
+        //! Same as above for spheres.
+        std::size_t cull(const std::vector< Sphere<Type> > & a_spheres, std::vector<unsigned char> & a_results, std::vector<unsigned char> & a_hints) const
+        {
+            a_results.resize(a_spheres.size());
+            a_hints.resize(a_spheres.size(), 0);
+
+            return a_spheres.empty() ? 0 : cull(&a_spheres[0], a_spheres.size(), &a_results[0], &a_hints[0]);
+        }
+
+    private:
+        // Arrays are culled by blocks of BLOCK_SIZE objects, in parallel above PARALLEL_SIZE objects.
+        enum { BLOCK_SIZE = 4096, PARALLEL_SIZE = 65536 };
+
+        Plane<Type> m_planes[NUM_PLANES];
+
+        // the planes coordinate by coordinate, with the absolute values of the normals for the boxes
+        Type m_nx[NUM_PLANES], m_ny[NUM_PLANES], m_nz[NUM_PLANES];
+        Type m_ax[NUM_PLANES], m_ay[NUM_PLANES], m_az[NUM_PLANES];
+        Type m_d[NUM_PLANES];
+
+#ifdef GTL_SSE2
+        // the same values of the float planes repeated in four lanes, so that they are loaded without shuffles
+        float m_lanes[NUM_PLANES][7][4];
+#endif
+
+        template<typename Object>
+        std::size_t cullBlocks(const Object * a_objects, std::size_t n, unsigned char * a_results, unsigned char * a_hints) const
+        {
+            const long num_blocks = (long)((n + BLOCK_SIZE - 1) / BLOCK_SIZE);
+            long visible = 0;
+
+#ifdef _OPENMP
+            #pragma omp parallel for reduction(+:visible) if(n > PARALLEL_SIZE)
+#endif
+            for(long b = 0; b < num_blocks; b++){
+                const std::size_t begin = (std::size_t)b * BLOCK_SIZE;
+                const std::size_t count = std::min<std::size_t>(BLOCK_SIZE, n - begin);
+
+                visible += (long)cullRange(a_objects + begin, count, a_results + begin, a_hints ? a_hints + begin : NULL);
+            }
+
+            return (std::size_t)visible;
+        }
+
+        // Index of the plane to test first, from a hint which may be out of range.
+        static int firstPlane(unsigned char a_hint)
+        {
+            return a_hint < NUM_PLANES ? a_hint : 0;
+        }
+
+        /* A box is outside when its corner furthest along the normal of a plane is behind it, which is the
+        signed distance of its center plus its extent projected on the absolute normal.
+        */
+        Result classifyBox(const Box3<Type> & a_box, unsigned char & a_hint) const
+        {
+            if(a_box.isEmpty()) return OUTSIDE;
+
+            const Vec3<Type> center = (Type)0.5 * (a_box.getMin() + a_box.getMax());
+            const Vec3<Type> extent = (Type)0.5 * (a_box.getMax() - a_box.getMin());
+            const int first = firstPlane(a_hint);
+            Result result = INSIDE;
+
+            for(int k = 0; k < NUM_PLANES; k++){
+                const int p = (first + k) % NUM_PLANES;
+                const Type distance = m_nx[p] * center[0] + m_ny[p] * center[1] + m_nz[p] * center[2] - m_d[p];
+                const Type radius = m_ax[p] * extent[0] + m_ay[p] * extent[1] + m_az[p] * extent[2];
+
+                if(distance + radius < 0){
+                    a_hint = (unsigned char)p;
+                    return OUTSIDE;
+                }
+                if(distance - radius < 0) result = INTERSECT;
+            }
+            return result;
+        }
+
+        Result classifySphere(const Sphere<Type> & a_sphere, unsigned char & a_hint) const
+        {
+            if(a_sphere.isEmpty()) return OUTSIDE;
+
+            const Vec3<Type> & center = a_sphere.getCenter();
+            const Type radius = a_sphere.getRadius();
+            const int first = firstPlane(a_hint);
+            Result result = INSIDE;
+
+            for(int k = 0; k < NUM_PLANES; k++){
+                const int p = (first + k) % NUM_PLANES;
+                const Type distance = m_nx[p] * center[0] + m_ny[p] * center[1] + m_nz[p] * center[2] - m_d[p];
+
+                if(distance + radius < 0){
+                    a_hint = (unsigned char)p;
+                    return OUTSIDE;
+                }
+                if(distance - radius < 0) result = INTERSECT;
+            }
+            return result;
+        }
+
+        template<typename T>
+        std::size_t cullRange(const Box3<T> * a_boxes, std::size_t n, unsigned char * a_results, unsigned char * a_hints) const
+        {
+            std::size_t visible = 0;
+            unsigned char hint = 0;
+
+            for(std::size_t i = 0; i < n; i++){
+                unsigned char & h = a_hints ? a_hints[i] : hint;
+                a_results[i] = (unsigned char)classifyBox(a_boxes[i], h);
+                if(a_results[i] != OUTSIDE) visible++;
+            }
+            return visible;
+        }
+
+        template<typename T>
+        std::size_t cullRange(const Sphere<T> * a_spheres, std::size_t n, unsigned char * a_results, unsigned char * a_hints) const
+        {
+            std::size_t visible = 0;
+            unsigned char hint = 0;
+
+            for(std::size_t i = 0; i < n; i++){
+                unsigned char & h = a_hints ? a_hints[i] : hint;
+                a_results[i] = (unsigned char)classifySphere(a_spheres[i], h);
+                if(a_results[i] != OUTSIDE) visible++;
+            }
+            return visible;
+        }
+
+#ifdef GTL_SSE2
+        // Four boxes at once: the packed boxes are read as rows of floats and transposed.
+        std::size_t cullRange(const Box3<float> * a_boxes, std::size_t n, unsigned char * a_results, unsigned char * a_hints) const
+        {
+            const float * data = (const float *)a_boxes;
+            const __m128 half = _mm_set1_ps(0.5f);
+            std::size_t visible = 0;
+            std::size_t i = 0;
+
+            for(; i + 4 <= n; i += 4){
+                const float * p = data + 6 * i;
+
+                // (xmin, ymin, zmin, xmax) and (zmin, xmax, ymax, zmax) of every box
+                __m128 a0 = _mm_loadu_ps(p), a1 = _mm_loadu_ps(p + 6), a2 = _mm_loadu_ps(p + 12), a3 = _mm_loadu_ps(p + 18);
+                __m128 b0 = _mm_loadu_ps(p + 2), b1 = _mm_loadu_ps(p + 8), b2 = _mm_loadu_ps(p + 14), b3 = _mm_loadu_ps(p + 20);
+                _MM_TRANSPOSE4_PS(a0, a1, a2, a3);
+                _MM_TRANSPOSE4_PS(b0, b1, b2, b3);
+
+                const __m128 empty = _mm_or_ps(_mm_cmplt_ps(a3, a0), _mm_or_ps(_mm_cmplt_ps(b2, a1), _mm_cmplt_ps(b3, a2)));
+
+                const __m128 cx = _mm_mul_ps(_mm_add_ps(a0, a3), half);
+                const __m128 cy = _mm_mul_ps(_mm_add_ps(a1, b2), half);
+                const __m128 cz = _mm_mul_ps(_mm_add_ps(a2, b3), half);
+                const __m128 ex = _mm_mul_ps(_mm_sub_ps(a3, a0), half);
+                const __m128 ey = _mm_mul_ps(_mm_sub_ps(b2, a1), half);
+                const __m128 ez = _mm_mul_ps(_mm_sub_ps(b3, a2), half);
+
+                visible += classify4(true, cx, cy, cz, ex, ey, ez, _mm_setzero_ps(), empty, a_results + i, a_hints ? a_hints + i : NULL);
+            }
+
+            return visible + cullRange<float>(a_boxes + i, n - i, a_results + i, a_hints ? a_hints + i : NULL);
+        }
+
+        // Four spheres at once: every packed sphere is a row (x, y, z, radius). Empty spheres have a negative radius.
+        std::size_t cullRange(const Sphere<float> * a_spheres, std::size_t n, unsigned char * a_results, unsigned char * a_hints) const
+        {
+            const float * data = (const float *)a_spheres;
+            const __m128 zero = _mm_setzero_ps();
+            std::size_t visible = 0;
+            std::size_t i = 0;
+
+            for(; i + 4 <= n; i += 4){
+                const float * p = data + 4 * i;
+
+                __m128 cx = _mm_loadu_ps(p), cy = _mm_loadu_ps(p + 4), cz = _mm_loadu_ps(p + 8), r = _mm_loadu_ps(p + 12);
+                _MM_TRANSPOSE4_PS(cx, cy, cz, r);
+
+                visible += classify4(false, cx, cy, cz, zero, zero, zero, r, _mm_cmplt_ps(r, zero), a_results + i, a_hints ? a_hints + i : NULL);
+            }
+
+            return visible + cullRange<float>(a_spheres + i, n - i, a_results + i, a_hints ? a_hints + i : NULL);
+        }
+
+        /* Classify four boxes of centers (cx, cy, cz) and extents (ex, ey, ez) if \a a_box is true, or
+        four spheres of centers (cx, cy, cz) and radius r. The lanes of \a a_empty are outside. When the objects are all outside of their own
+        hinted plane the other planes are skipped, otherwise all the planes are tested without branches.
+        */
+        std::size_t classify4(bool a_box, __m128 cx, __m128 cy, __m128 cz, __m128 ex, __m128 ey, __m128 ez, __m128 r,
+                              __m128 a_empty, unsigned char * a_results, unsigned char * a_hints) const
+        {
+            const __m128 zero = _mm_setzero_ps();
+
+            if(a_hints){
+                const int h0 = firstPlane(a_hints[0]), h1 = firstPlane(a_hints[1]), h2 = firstPlane(a_hints[2]), h3 = firstPlane(a_hints[3]);
+
+                const __m128 distance = planeDistance(_mm_setr_ps(m_nx[h0], m_nx[h1], m_nx[h2], m_nx[h3]),
+                                                      _mm_setr_ps(m_ny[h0], m_ny[h1], m_ny[h2], m_ny[h3]),
+                                                      _mm_setr_ps(m_nz[h0], m_nz[h1], m_nz[h2], m_nz[h3]),
+                                                      _mm_setr_ps(m_d[h0], m_d[h1], m_d[h2], m_d[h3]), cx, cy, cz);
+                const __m128 radius = a_box ? planeRadius(_mm_setr_ps(m_ax[h0], m_ax[h1], m_ax[h2], m_ax[h3]),
+                                                          _mm_setr_ps(m_ay[h0], m_ay[h1], m_ay[h2], m_ay[h3]),
+                                                          _mm_setr_ps(m_az[h0], m_az[h1], m_az[h2], m_az[h3]), ex, ey, ez) : r;
+
+                if(_mm_movemask_ps(_mm_or_ps(a_empty, _mm_cmplt_ps(_mm_add_ps(distance, radius), zero))) == 0xf){
+                    // the hints are unchanged
+                    a_results[0] = a_results[1] = a_results[2] = a_results[3] = OUTSIDE;
+                    return 0;
+                }
+            }
+
+            __m128 outside = a_empty;
+            __m128 partial = zero;
+            __m128 rejecting = zero;
+
+            for(int p = 0; p < NUM_PLANES; p++){
+                const float (&lanes)[7][4] = m_lanes[p];
+                const __m128 distance = planeDistance(_mm_loadu_ps(lanes[0]), _mm_loadu_ps(lanes[1]), _mm_loadu_ps(lanes[2]), _mm_loadu_ps(lanes[3]), cx, cy, cz);
+                const __m128 radius = a_box ? planeRadius(_mm_loadu_ps(lanes[4]), _mm_loadu_ps(lanes[5]), _mm_loadu_ps(lanes[6]), ex, ey, ez) : r;
+
+                // the first plane which rejects a lane
+                const __m128 rejected = _mm_andnot_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), zero));
+                rejecting = _mm_or_ps(_mm_and_ps(rejected, _mm_set1_ps((float)p)), _mm_andnot_ps(rejected, rejecting));
+
+                outside = _mm_or_ps(outside, rejected);
+                partial = _mm_or_ps(partial, _mm_cmplt_ps(_mm_sub_ps(distance, radius), zero));
+            }
+
+            static const unsigned char results[4] = { INSIDE, OUTSIDE, INTERSECT, OUTSIDE };
+            static const unsigned char visible[16] = { 4, 3, 3, 2, 3, 2, 2, 1, 3, 2, 2, 1, 2, 1, 1, 0 };
+
+            const unsigned int out = (unsigned int)_mm_movemask_ps(outside);
+            const unsigned int part = (unsigned int)_mm_movemask_ps(partial);
+
+            for(int l = 0; l < 4; l++) a_results[l] = results[(out >> l & 1u) | (part >> l & 1u) << 1];
+
+            if(a_hints){
+                const unsigned int keep = ~out | (unsigned int)_mm_movemask_ps(a_empty);
+                float planes[4];
+                _mm_storeu_ps(planes, rejecting);
+
+                for(int l = 0; l < 4; l++) a_hints[l] = (keep >> l & 1u) ? a_hints[l] : (unsigned char)planes[l];
+            }
+
+            return visible[out];
+        }
+
+        static __m128 planeDistance(__m128 nx, __m128 ny, __m128 nz, __m128 d, __m128 cx, __m128 cy, __m128 cz)
+        {
+            return _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, cx), _mm_mul_ps(ny, cy)), _mm_mul_ps(nz, cz)), d);
+        }
+
+        static __m128 planeRadius(__m128 ax, __m128 ay, __m128 az, __m128 ex, __m128 ey, __m128 ez)
+        {
+            return _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, ex), _mm_mul_ps(ay, ey)), _mm_mul_ps(az, ez));
+        }
+#endif
+    };
+
+    typedef Frustum<float>  Frustumf;
+    typedef Frustum<double> Frustumd;
+} // namespace gtl
+
+#endif
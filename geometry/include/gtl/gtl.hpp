@@ -20,9 +20,59 @@ _______________________________________________________________________
 #include <limits>
 #include <vector>
 
+// SSE2 is used for the float bulk kernels when the compiler targets it
+// (/arch:SSE2 or x64 with MSVC, -msse2 with gcc). Define GTL_NO_SIMD to
+// force the portable code paths.
+#if !defined(GTL_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#   define GTL_SSE2
+#   include <emmintrin.h>
+#endif
+
+// AVX widens the double kernels to four lanes (/arch:AVX with MSVC, -mavx with gcc).
+#if defined(GTL_SSE2) && defined(__AVX__)
+#   define GTL_AVX
+#   include <immintrin.h>
+#endif
+
+// constexpr where the compiler supports it (C++11, or Visual C++ 2015).
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)
+#   define GTL_CONSTEXPR constexpr
+#else
+#   define GTL_CONSTEXPR
+#endif
+
+// constexpr for functions with loops, locals and assignments (C++14, or Visual C++ 2017),
+// which the constructors and the arithmetic of the vector, matrix and quaternion types need.
+// GTL_CONSTANT_EVALUATED() is true while such a function is evaluated at compile time, when
+// the SIMD kernels and the math library cannot be called, and false if the compiler cannot tell.
+#if (defined(__cpp_constexpr) && __cpp_constexpr >= 201304L) || (defined(_MSC_VER) && _MSC_VER >= 1910)
+#   define GTL_CONSTEXPR14 constexpr
+#   if defined(__has_builtin)
+#       if __has_builtin(__builtin_is_constant_evaluated)
+#           define GTL_HAS_CONSTANT_EVALUATED
+#       endif
+#   endif
+#   if (defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 9) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+#       define GTL_HAS_CONSTANT_EVALUATED
+#   endif
+#else
+#   define GTL_CONSTEXPR14
+#endif
+
+#ifdef GTL_HAS_CONSTANT_EVALUATED
+#   define GTL_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#else
+#   define GTL_CONSTANT_EVALUATED() false
+#endif
+
+// Visual C++ 2005 to 2013 warn that the arrays value initialized by the constructors
+// are zeroed, as the standard requires.
+#if defined(_MSC_VER) && _MSC_VER < 1900
+#   pragma warning(disable: 4351)
+#endif
+
 namespace gtl
 {
-#define SQR(x) pow((double)x, 2.0)
 
 #if defined(min) || defined(max)
 #   error Error: min or max are defined as preprocessor macros, probably in <windows.h>.  Define NOMINMAX macro before including any system headers!
@@ -38,6 +88,32 @@ namespace gtl
 #endif
 
 #define EPS std::numeric_limits<Type>::epsilon()
+
+// alignment in bytes of the bulk arrays (one cache line, wide enough for AVX-512)
+#define GTL_SIMD_ALIGNMENT 64
+
+// 64 bits unsigned integer, used for the voxel masks and the Morton keys
+#ifdef _MSC_VER
+typedef unsigned __int64   uint64;
+#else
+typedef unsigned long long uint64;
+#endif
+
+// Compile time check, usable at namespace or class scope.
+#define GTL_STATIC_ASSERT(exp, name) typedef char gtl_static_assert_##name[(exp) ? 1 : -1]
+
+//! Alignment in bytes of \a Type, as alignof() which C++98 lacks.
+template<typename Type>
+struct AlignmentOf
+{
+    struct Probe { char c; Type t; };
+    enum { value = sizeof(Probe) - sizeof(Type) };
+};
+
+// The value types hold exactly \a count scalars, without vtable nor padding, so that their
+// arrays can be copied with memcpy or mapped from memory.
+#define GTL_ASSERT_PACKED(Class, Scalar, count) \
+    GTL_STATIC_ASSERT(sizeof(Class) == (count) * sizeof(Scalar) && (int)AlignmentOf<Class>::value == (int)AlignmentOf<Scalar>::value, Class##_is_packed)
     
 //! Convert a_value from degrees to radians.
 template<typename Type>
@@ -83,6 +159,31 @@ inline Type sign(Type a)
     return (a >= (Type)0.0) ? (Type)1.0 : (Type)-1.0;
 }
 
+//! Returns \a a squared, computed in the type of \a a.
+template<typename Type>
+inline GTL_CONSTEXPR Type sqr(Type a)
+{
+    return a * a;
+}
+
+/*! Square root of \a a, which must not be negative. std::sqrt() is used at run time, and
+Newton iterations in double precision when evaluated at compile time.
+*/
+template<typename Type>
+inline GTL_CONSTEXPR14 Type squareRoot(Type a)
+{
+    if(GTL_CONSTANT_EVALUATED()){
+        if(a <= 0) return (Type)0;
+
+        // decreases monotonically from above the root, until rounding stops it
+        double x = a > 1 ? (double)a : 1.0;
+        for(double next = 0.5 * (x + a / x); next < x; next = 0.5 * (x + a / x)) x = next;
+
+        return (Type)x;
+    }
+    return (Type)std::sqrt(a);
+}
+
 template<typename Type>
 inline bool equals(const Type & a, const Type & b, Type eps = std::numeric_limits<Type>::epsilon())
 {
@@ -98,7 +199,7 @@ inline int nearestPowerOfTwo(int value)
 {
     int vlog = (int)(log((float)value)*1.4427f);
     
-	return (int)pow(2.f,(float)vlog);
+	return vlog < 0 ? 0 : 1 << vlog;
 }
 
 } // namespace gtl
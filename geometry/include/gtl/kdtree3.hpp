@@ -0,0 +1,396 @@
+/*
+_______________________________________________________________________
+__________________________ G E O M E T R Y ____________________________
+|
+| THIS FILE IS PART OF THE GEOMETRY TEMPLATE LIBRARY.
+| USE, DISTRIBUTION AND REPRODUCTION OF THIS LIBRARY SOURCE IS
+| GOVERNED BY A BSD-STYLE SOURCE LICENSE.
+| PLEASE READ THESE TERMS BEFORE DISTRIBUTING.
+_______________________________________________________________________
+_______________________________________________________________________
+*/
+
+#ifndef KDTREE3_H
+#define KDTREE3_H
+
+#include <gtl/gtl.hpp>
+#include <gtl/vec3.hpp>
+#include <gtl/box3.hpp>
+
+namespace gtl
+{
+    /*!
+    \class KdTree3 KdTree3.hpp geometry/KdTree3.hpp
+    \brief k-d tree over a point cloud, for nearest neighbour, radius and box queries.
+    \ingroup base
+
+    The tree is implicit: the points are reordered so that the subtree of a range of
+    points has its median point in the middle of the range, the points before it on the
+    lower side of the splitting plane and the points after it on the upper side. The only
+    other storage is the splitting axis of every median, one byte per point, and ranges
+    of a few points are scanned without splitting.
+
+    The tree is built by median splits along the widest axis. Subtrees are built, and
+    batches of queries are run, in parallel when OpenMP is enabled.
+
+    \sa Vec3, Box3, SphereTree
+    */
+    template<typename Type>
+    class KdTree3
+    {
+    public:
+        //! A point found by findNearest(), with its squared distance to the query point.
+        struct Neighbor
+        {
+            Type         sqr_distance;
+            unsigned int index;       //!< index of the point in the cloud
+
+            //! Order by distance.
+            bool operator <(const Neighbor & a_neighbor) const
+            {
+                return sqr_distance < a_neighbor.sqr_distance;
+            }
+        };
+
+        //! The default constructor makes an empty tree.
+        KdTree3(){}
+
+        //! Build the tree of a point cloud. \sa build().
+        KdTree3(const std::vector< Vec3<Type> > & a_points)
+        {
+            build(a_points);
+        }
+
+        //! Build the tree of a point cloud.
+        void build(const std::vector< Vec3<Type> > & a_points)
+        {
+            if(a_points.empty()) clear();
+            else build(&a_points[0], a_points.size());
+        }
+
+        //! Build the tree of the \a a_num_points points of \a a_points.
+        void build(const Vec3<Type> * a_points, std::size_t a_num_points)
+        {
+            m_indices.resize(a_num_points);
+            m_axes.assign(a_num_points, 0);
+
+            for(std::size_t i = 0; i < a_num_points; i++) m_indices[i] = (unsigned int)i;
+
+            // split the top of the tree serially until there are enough subtrees to keep the threads busy
+            std::vector< std::pair<unsigned int, unsigned int> > tasks;
+            splitTop(a_points, 0, (unsigned int)a_num_points, 0, tasks);
+
+#ifdef _OPENMP
+            #pragma omp parallel for schedule(dynamic) if(a_num_points > PARALLEL_SIZE)
+#endif
+            for(int i = 0; i < (int)tasks.size(); i++){
+                buildRange(a_points, tasks[i].first, tasks[i].second);
+            }
+
+            m_points.resize(a_num_points);
+            for(std::size_t i = 0; i < a_num_points; i++) m_points[i] = a_points[m_indices[i]];
+        }
+
+        //! Remove all the points.
+        void clear()
+        {
+            m_points.clear();
+            m_indices.clear();
+            m_axes.clear();
+        }
+
+        //! Return the number of points.
+        std::size_t size() const
+        {
+            return m_points.size();
+        }
+
+        /*! Find the \a k points closest to \a a_point and store them in \a a_neighbors, nearest first.
+        Fewer points are found if the cloud has fewer than \a k points. The memory of \a a_neighbors
+        is reused from one call to the next. Return the number of points found.
+        */
+        std::size_t findNearest(const Vec3<Type> & a_point, std::size_t k, std::vector<Neighbor> & a_neighbors) const
+        {
+            a_neighbors.clear();
+
+            if(k == 0 || m_points.empty()) return 0;
+
+            Type offsets[3] = {0, 0, 0};
+            nearest(a_point, std::min(k, m_points.size()), 0, (unsigned int)m_points.size(), offsets, (Type)0, a_neighbors);
+            std::sort_heap(a_neighbors.begin(), a_neighbors.end());
+
+            return a_neighbors.size();
+        }
+
+        /*! Find the point closest to \a a_point. Return the index of the point in the cloud, or -1 if the
+        tree is empty, and the squared distance in \a a_sqr_distance.
+        */
+        int findNearest(const Vec3<Type> & a_point, Type & a_sqr_distance) const
+        {
+            Neighbor neighbor;
+            neighbor.sqr_distance = std::numeric_limits<Type>::max();
+            neighbor.index = 0;
+
+            if(m_points.empty()) return -1;
+
+            nearest(a_point, 0, (unsigned int)m_points.size(), neighbor);
+            a_sqr_distance = neighbor.sqr_distance;
+
+            return (int)neighbor.index;
+        }
+
+        /*! Find the \a k nearest points of each of the \a a_num_queries points of \a a_queries. The indices
+        of the points of query \a q are stored nearest first in \a a_indices[q*k] to \a a_indices[q*k+k-1],
+        and their squared distances in \a a_sqr_distances if it is not NULL. If the cloud has fewer than
+        \a k points, the remaining indices are set to -1 and the distances to the largest value.
+        The queries are run in parallel when OpenMP is enabled.
+        */
+        void findNearest(const Vec3<Type> * a_queries, std::size_t a_num_queries, std::size_t k,
+                         int * a_indices, Type * a_sqr_distances = NULL) const
+        {
+#ifdef _OPENMP
+            #pragma omp parallel if(a_num_queries > 1024)
+#endif
+            {
+                std::vector<Neighbor> neighbors;
+                neighbors.reserve(k);
+
+#ifdef _OPENMP
+                #pragma omp for schedule(dynamic, 256)
+#endif
+                for(long q = 0; q < (long)a_num_queries; q++){
+                    const std::size_t found = findNearest(a_queries[q], k, neighbors);
+                    const std::size_t first = (std::size_t)q * k;
+
+                    for(std::size_t n = 0; n < k; n++){
+                        a_indices[first + n] = n < found ? (int)neighbors[n].index : -1;
+                        if(a_sqr_distances) a_sqr_distances[first + n] = n < found ? neighbors[n].sqr_distance : std::numeric_limits<Type>::max();
+                    }
+                }
+            }
+        }
+
+        //! Same as above for a vector of queries, \a a_indices and \a a_sqr_distances are resized to k entries per query.
+        void findNearest(const std::vector< Vec3<Type> > & a_queries, std::size_t k,
+                         std::vector<int> & a_indices, std::vector<Type> & a_sqr_distances) const
+        {
+            a_indices.resize(a_queries.size() * k);
+            a_sqr_distances.resize(a_queries.size() * k);
+
+            if(a_indices.empty()) return;
+
+            findNearest(&a_queries[0], a_queries.size(), k, &a_indices[0], &a_sqr_distances[0]);
+        }
+
+        //! Append to \a a_indices the index of every point within \a a_radius of \a a_point. Return the number of points found.
+        std::size_t findRadius(const Vec3<Type> & a_point, Type a_radius, std::vector<unsigned int> & a_indices) const
+        {
+            const std::size_t size = a_indices.size();
+
+            if(!m_points.empty()) radius(a_point, a_radius * a_radius, 0, (unsigned int)m_points.size(), a_indices);
+
+            return a_indices.size() - size;
+        }
+
+        //! Append to \a a_indices the index of every point inside of \a a_box, bounds included. Return the number of points found.
+        std::size_t findInBox(const Box3<Type> & a_box, std::vector<unsigned int> & a_indices) const
+        {
+            const std::size_t size = a_indices.size();
+
+            if(!m_points.empty()) range(a_box, 0, (unsigned int)m_points.size(), a_indices);
+
+            return a_indices.size() - size;
+        }
+
+    private:
+        // Ranges of up to LEAF_SIZE points are scanned. The top TASK_DEPTH levels are split before the parallel build.
+        enum { LEAF_SIZE = 16, TASK_DEPTH = 6, PARALLEL_SIZE = 16384 };
+
+        std::vector< Vec3<Type> >  m_points;  //!< Points in tree order
+        std::vector<unsigned int>  m_indices; //!< Index in the cloud of the points in tree order
+        std::vector<unsigned char> m_axes;    //!< Splitting axis of the median of every range
+
+        struct AxisLess
+        {
+            AxisLess(const Vec3<Type> * p, int a) : points(p), axis(a) {}
+
+            bool operator()(unsigned int i1, unsigned int i2) const
+            {
+                return points[i1][axis] < points[i2][axis];
+            }
+
+            const Vec3<Type> * points;
+            int axis;
+        };
+
+        // Move the median of [begin, end) along its widest axis to the middle of the range, return the middle.
+        unsigned int split(const Vec3<Type> * a_points, unsigned int begin, unsigned int end)
+        {
+            Box3<Type> bounds;
+            for(unsigned int i = begin; i < end; i++) bounds.extendBy(a_points[m_indices[i]]);
+
+            Vec3<Type> extent = bounds.getSize();
+            int axis = 0;
+            if(extent[1] > extent[axis]) axis = 1;
+            if(extent[2] > extent[axis]) axis = 2;
+
+            const unsigned int middle = begin + (end - begin) / 2;
+            std::nth_element(m_indices.begin() + begin, m_indices.begin() + middle, m_indices.begin() + end, AxisLess(a_points, axis));
+            m_axes[middle] = (unsigned char)axis;
+
+            return middle;
+        }
+
+        void splitTop(const Vec3<Type> * a_points, unsigned int begin, unsigned int end, int depth,
+                      std::vector< std::pair<unsigned int, unsigned int> > & tasks)
+        {
+            if(depth == TASK_DEPTH || end - begin <= LEAF_SIZE){
+                tasks.push_back(std::make_pair(begin, end));
+                return;
+            }
+
+            const unsigned int middle = split(a_points, begin, end);
+
+            splitTop(a_points, begin, middle, depth + 1, tasks);
+            splitTop(a_points, middle + 1, end, depth + 1, tasks);
+        }
+
+        void buildRange(const Vec3<Type> * a_points, unsigned int begin, unsigned int end)
+        {
+            if(end - begin <= LEAF_SIZE) return;
+
+            const unsigned int middle = split(a_points, begin, end);
+
+            buildRange(a_points, begin, middle);
+            buildRange(a_points, middle + 1, end);
+        }
+
+        /* Keep the k nearest points in the max-heap a_heap. a_offsets holds the distance along each axis
+        from the query to the region of the range, and a_sqr_distance their squared sum, which is a lower
+        bound of the distance to the points of the range.
+        */
+        void nearest(const Vec3<Type> & a_point, std::size_t k, unsigned int begin, unsigned int end,
+                     Type * a_offsets, Type a_sqr_distance, std::vector<Neighbor> & a_heap) const
+        {
+            if(end - begin <= LEAF_SIZE){
+                for(unsigned int i = begin; i < end; i++) push(a_point, k, i, a_heap);
+                return;
+            }
+
+            const unsigned int middle = begin + (end - begin) / 2;
+            const int axis = m_axes[middle];
+            const Type d = a_point[axis] - m_points[middle][axis];
+
+            push(a_point, k, middle, a_heap);
+
+            const unsigned int nbegin = d < 0 ? begin : middle + 1;
+            const unsigned int nend = d < 0 ? middle : end;
+            const unsigned int fbegin = d < 0 ? middle + 1 : begin;
+            const unsigned int fend = d < 0 ? end : middle;
+
+            // the side of the query first, the other side only if its region is closer than the k-th point
+            nearest(a_point, k, nbegin, nend, a_offsets, a_sqr_distance, a_heap);
+
+            const Type offset = a_offsets[axis];
+            const Type sqr_distance = a_sqr_distance - offset * offset + d * d;
+
+            if(a_heap.size() < k || sqr_distance < a_heap.front().sqr_distance){
+                a_offsets[axis] = d;
+                nearest(a_point, k, fbegin, fend, a_offsets, sqr_distance, a_heap);
+                a_offsets[axis] = offset;
+            }
+        }
+
+        void push(const Vec3<Type> & a_point, std::size_t k, unsigned int i, std::vector<Neighbor> & a_heap) const
+        {
+            const Type sqr_distance = (m_points[i] - a_point).sqrLength();
+
+            if(a_heap.size() == k){
+                if(!(sqr_distance < a_heap.front().sqr_distance)) return;
+                std::pop_heap(a_heap.begin(), a_heap.end());
+                a_heap.pop_back();
+            }
+
+            Neighbor neighbor;
+            neighbor.sqr_distance = sqr_distance;
+            neighbor.index = m_indices[i];
+            a_heap.push_back(neighbor);
+            std::push_heap(a_heap.begin(), a_heap.end());
+        }
+
+        // Single nearest point, without a heap.
+        void nearest(const Vec3<Type> & a_point, unsigned int begin, unsigned int end, Neighbor & a_best) const
+        {
+            if(end - begin <= LEAF_SIZE){
+                for(unsigned int i = begin; i < end; i++) closer(a_point, i, a_best);
+                return;
+            }
+
+            const unsigned int middle = begin + (end - begin) / 2;
+            const Type d = a_point[m_axes[middle]] - m_points[middle][m_axes[middle]];
+
+            closer(a_point, middle, a_best);
+
+            if(d < 0){
+                nearest(a_point, begin, middle, a_best);
+                if(d * d < a_best.sqr_distance) nearest(a_point, middle + 1, end, a_best);
+            }else{
+                nearest(a_point, middle + 1, end, a_best);
+                if(d * d < a_best.sqr_distance) nearest(a_point, begin, middle, a_best);
+            }
+        }
+
+        void closer(const Vec3<Type> & a_point, unsigned int i, Neighbor & a_best) const
+        {
+            const Type sqr_distance = (m_points[i] - a_point).sqrLength();
+
+            if(sqr_distance < a_best.sqr_distance){
+                a_best.sqr_distance = sqr_distance;
+                a_best.index = m_indices[i];
+            }
+        }
+
+        void radius(const Vec3<Type> & a_point, Type a_sqr_radius, unsigned int begin, unsigned int end, std::vector<unsigned int> & a_indices) const
+        {
+            if(end - begin <= LEAF_SIZE){
+                for(unsigned int i = begin; i < end; i++){
+                    if((m_points[i] - a_point).sqrLength() <= a_sqr_radius) a_indices.push_back(m_indices[i]);
+                }
+                return;
+            }
+
+            const unsigned int middle = begin + (end - begin) / 2;
+            const Type d = a_point[m_axes[middle]] - m_points[middle][m_axes[middle]];
+
+            if((m_points[middle] - a_point).sqrLength() <= a_sqr_radius) a_indices.push_back(m_indices[middle]);
+
+            if(d <= 0 || d * d <= a_sqr_radius) radius(a_point, a_sqr_radius, begin, middle, a_indices);
+            if(d >= 0 || d * d <= a_sqr_radius) radius(a_point, a_sqr_radius, middle + 1, end, a_indices);
+        }
+
+        void range(const Box3<Type> & a_box, unsigned int begin, unsigned int end, std::vector<unsigned int> & a_indices) const
+        {
+            if(end - begin <= LEAF_SIZE){
+                for(unsigned int i = begin; i < end; i++){
+                    if(a_box.intersect(m_points[i])) a_indices.push_back(m_indices[i]);
+                }
+                return;
+            }
+
+            const unsigned int middle = begin + (end - begin) / 2;
+            const int axis = m_axes[middle];
+            const Type split = m_points[middle][axis];
+
+            if(a_box.intersect(m_points[middle])) a_indices.push_back(m_indices[middle]);
+
+            // the points before the median are not above it along the axis, the points after it are not below
+            if(a_box.getMin()[axis] <= split) range(a_box, begin, middle, a_indices);
+            if(a_box.getMax()[axis] >= split) range(a_box, middle + 1, end, a_indices);
+        }
+    };
+
+    typedef KdTree3<float>  KdTree3f;
+    typedef KdTree3<double> KdTree3d;
+} // namespace gtl
+
+#endif
@@ -33,27 +33,21 @@ namespace gtl
     {
     public:
         //! The default constructor. The matrix will be identity.
-        Matrix3()
+        GTL_CONSTEXPR14 Matrix3() : m_data()
         {
             makeIdentity();
         }
 
         //! Constructs a matrix instance with the given initial elements.
-        Matrix3(const Type a11, const Type a12, const Type a13,
+        GTL_CONSTEXPR14 Matrix3(const Type a11, const Type a12, const Type a13,
             const Type a21, const Type a22, const Type a23,
-            const Type a31, const Type a32, const Type a33)
+            const Type a31, const Type a32, const Type a33) : m_data()
         {
             m_data[0][0] = a11; m_data[0][1] = a12; m_data[0][2] = a13;
             m_data[1][0] = a21; m_data[1][1] = a22; m_data[1][2] = a23;
             m_data[2][0] = a31; m_data[2][1] = a32; m_data[2][2] = a33;
         }
 
-        //! Constructs a matrix instance with the initial elements from the \a matrix argument.
-        Matrix3(const Matrix3<Type> & a_matrix)
-        {
-            *this = a_matrix;
-        }
-
         //! Create from Matrix4 excluding row and column k
         Matrix3(const Matrix4<Type> & a_matrix, int k)
         {
@@ -64,11 +58,8 @@ namespace gtl
             }
         }
 
-        //! Default destructor does nothing.
-        virtual ~Matrix3(){}
-
         //! Set the matrix to be the identity matrix. \sa isIdentity().
-        void makeIdentity()
+        GTL_CONSTEXPR14 void makeIdentity()
         {
             m_data[0][0]=m_data[1][1]=m_data[2][2]= (Type)1.0;
             m_data[0][1]=m_data[0][2]=m_data[1][0]= (Type)0.0;
@@ -76,7 +67,7 @@ namespace gtl
         }
 
         //! Check if matrix is identity. 
-        bool isIdentity() const
+        GTL_CONSTEXPR14 bool isIdentity() const
         {
             return ((m_data[0][0] == 1.0) && (m_data[0][1] == (Type)0.0) && (m_data[0][2] == (Type)0.0) &&
                 (m_data[1][0] == 0.0) && (m_data[1][1] == (Type)1.0) && (m_data[1][2] == (Type)0.0) &&
@@ -118,7 +109,7 @@ namespace gtl
         }
 
         //! Transpose the current matrix.
-        Matrix3<Type> & transpose()
+        GTL_CONSTEXPR14 Matrix3<Type> & transpose()
         {
             *this = Matrix3<Type>(m_data[0][0], m_data[1][0], m_data[2][0],
                 m_data[0][1], m_data[1][1], m_data[2][1],
@@ -127,7 +118,7 @@ namespace gtl
         }
 
         //! Returns the determinant of the matrix.
-        Type det() const
+        GTL_CONSTEXPR14 Type det() const
         {
             return (m_data[0][0]*m_data[1][1]*m_data[2][2] +
                 m_data[0][1]*m_data[1][2]*m_data[2][0] +
@@ -156,33 +147,17 @@ namespace gtl
         }
 
         //! Returns pointer to the 3 element array representing a matrix row. \a i should be within [0, 2].
-        Type * operator [](int i)
+        GTL_CONSTEXPR14 Type * operator [](int i)
         { 
             return m_data[i]; 
         }
 
         //! Returns pointer to the 3 element array representing a matrix row. \a i should be within [0, 2].
-        const Type * operator [](int i) const
+        GTL_CONSTEXPR14 const Type * operator [](int i) const
         { 
             return m_data[i]; 
         }
 
-        //! Assignment operator. Copies the elements from \a a_matrix to the matrix.
-        Matrix3<Type> & operator =(const Matrix3<Type> & m)
-        {
-            m_data[0][0] = m.m_data[0][0];
-            m_data[0][1] = m.m_data[0][1];
-            m_data[0][2] = m.m_data[0][2];
-            m_data[1][0] = m.m_data[1][0];
-            m_data[1][1] = m.m_data[1][1];
-            m_data[1][2] = m.m_data[1][2];
-            m_data[2][0] = m.m_data[2][0];
-            m_data[2][1] = m.m_data[2][1];
-            m_data[2][2] = m.m_data[2][2];
-
-            return *this;
-        }
-
         Matrix3<Type> & operator =(const Quat<Type> & a_quat)
         {
             setRotate(a_quat);
@@ -191,13 +166,13 @@ namespace gtl
         }
 
         //! Right-multiply with the \a a_matrix matrix. \sa multRight().
-        Matrix3<Type> & operator *=(const Matrix3<Type> & a_matrix)
+        GTL_CONSTEXPR14 Matrix3<Type> & operator *=(const Matrix3<Type> & a_matrix)
         {
             return multRight(a_matrix);
         }
 
         //! Multiplies matrix \a m1 with matrix \a m2 and returns the resultant matrix.
-        friend Matrix3<Type> operator *(const Matrix3<Type> & m1, const Matrix3<Type> & m2)
+        friend GTL_CONSTEXPR14 Matrix3<Type> operator *(const Matrix3<Type> & m1, const Matrix3<Type> & m2)
         { 
             Matrix3<Type> m = m1; 
             m *= m2; 
@@ -209,7 +184,7 @@ namespace gtl
 
         \sa equals().
         */
-        friend bool operator ==(const Matrix3<Type> & m1, const Matrix3<Type> & m2)
+        friend GTL_CONSTEXPR14 bool operator ==(const Matrix3<Type> & m1, const Matrix3<Type> & m2)
         {
             return (
                 m1.m_data[0][0] == m2.m_data[0][0] &&
@@ -227,7 +202,7 @@ namespace gtl
         }
 
 
-        friend bool operator !=(const Matrix3<Type> & m1, const Matrix3<Type> & m2)
+        friend GTL_CONSTEXPR14 bool operator !=(const Matrix3<Type> & m1, const Matrix3<Type> & m2)
         { 
             return !(m1 == m2);
         }
@@ -250,13 +225,13 @@ namespace gtl
         }
 
         //! Set matrix to be a pure scaling matrix. (no translation or rotation components)
-        void setScale(const Type s)
+        GTL_CONSTEXPR14 void setScale(const Type s)
         {
             setScale(Vec3<Type>(s,s,s));
         }
 
         //! Set matrix to be a pure scaling matrix. (no translation or rotation components)
-        void setScale(const Vec3<Type> & s)
+        GTL_CONSTEXPR14 void setScale(const Vec3<Type> & s)
         {
             makeIdentity();
             m_data[0][0] = s[0];
@@ -265,7 +240,7 @@ namespace gtl
         }
 
         //! Let this matrix be right-multiplied by m. Returns reference to self.
-        Matrix3<Type> & multRight(const Matrix3<Type> & m)
+        GTL_CONSTEXPR14 Matrix3<Type> & multRight(const Matrix3<Type> & m)
         {
             // Trivial cases
             if(m.isIdentity()) return *this;
@@ -286,7 +261,7 @@ namespace gtl
         }
 
         //! Multiplies matrix by given column vector, giving vector result. 
-        void multMatrixVec(const Vec3<Type> & src, Vec3<Type> & dst) const
+        GTL_CONSTEXPR14 void multMatrixVec(const Vec3<Type> & src, Vec3<Type> & dst) const
         {
             Type x = m_data[0][0]*src[0] + m_data[0][1]*src[1] + m_data[0][2]*src[2];
             Type y = m_data[1][0]*src[0] + m_data[1][1]*src[1] + m_data[1][2]*src[2];
@@ -296,7 +271,7 @@ namespace gtl
         }
 
         //! Multiplies given row vector by matrix, giving vector result. 
-        void multVecMatrix(const Vec3<Type> & src, Vec3<Type> & dst) const
+        GTL_CONSTEXPR14 void multVecMatrix(const Vec3<Type> & src, Vec3<Type> & dst) const
         {
             Type x = src[0]*m_data[0][0] + src[1]*m_data[1][0] + src[2]*m_data[2][0];
             Type y = src[0]*m_data[0][1] + src[1]*m_data[1][1] + src[2]*m_data[2][1];
@@ -319,6 +294,9 @@ namespace gtl
     typedef Matrix3<int>    Matrix3i;
     typedef Matrix3<float>  Matrix3f;
     typedef Matrix3<double> Matrix3d;
+
+    GTL_ASSERT_PACKED(Matrix3f, float, 9);
+    GTL_ASSERT_PACKED(Matrix3d, double, 9);
 } // namespace gtl
 
 #endif
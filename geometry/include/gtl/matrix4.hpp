@@ -15,6 +15,7 @@ _______________________________________________________________________
 
 #include <gtl/gtl.hpp>
 #include <gtl/vec3.hpp>
+#include <gtl/vec3array.hpp>
 #include <gtl/quat.hpp>
 
 namespace gtl
@@ -36,16 +37,16 @@ namespace gtl
     {
     public:
         //! The default constructor. The matrix will be identity.
-        Matrix4()
+        GTL_CONSTEXPR14 Matrix4() : m_data()
         {
             makeIdentity();
         }
 
         //! Constructs a matrix instance with the given initial elements.
-        Matrix4(const Type a11, const Type a12, const Type a13, const Type a14,
+        GTL_CONSTEXPR14 Matrix4(const Type a11, const Type a12, const Type a13, const Type a14,
             const Type a21, const Type a22, const Type a23, const Type a24,
             const Type a31, const Type a32, const Type a33, const Type a34,
-            const Type a41, const Type a42, const Type a43, const Type a44)
+            const Type a41, const Type a42, const Type a43, const Type a44) : m_data()
         {
             m_data[0][0] = a11; m_data[0][1] = a12; m_data[0][2] = a13; m_data[0][3] = a14;
             m_data[1][0] = a21; m_data[1][1] = a22; m_data[1][2] = a23; m_data[1][3] = a24;
@@ -53,17 +54,8 @@ namespace gtl
             m_data[3][0] = a41; m_data[3][1] = a42; m_data[3][2] = a43; m_data[3][3] = a44;
         }
 
-        //! Constructs a matrix instance with the initial elements from the \a matrix argument.
-        Matrix4(const Matrix4<Type> & a_matrix)
-        {
-            *this = a_matrix;
-        }
-
-        //! Default destructor does nothing.
-        virtual ~Matrix4(){}
-
         //! Set the matrix to be the identity matrix. \sa isIdentity().
-        void makeIdentity()
+        GTL_CONSTEXPR14 void makeIdentity()
         {
             m_data[0][0]=m_data[1][1]=m_data[2][2]=m_data[3][3] = (Type)1.0;
             m_data[0][1]=m_data[0][2]=m_data[0][3]=
@@ -73,7 +65,7 @@ namespace gtl
         }
 
         //! Check if matrix is identity. 
-        bool isIdentity() const
+        GTL_CONSTEXPR14 bool isIdentity() const
         {
             return ((m_data[0][0] == 1.0) && (m_data[0][1] == (Type)0.0) && (m_data[0][2] == (Type)0.0) && (m_data[0][3] == (Type)0.0) &&
                 (m_data[1][0] == 0.0) && (m_data[1][1] == (Type)1.0) && (m_data[1][2] == (Type)0.0) && (m_data[1][3] == (Type)0.0) &&
@@ -84,84 +76,7 @@ namespace gtl
         //! Inverse the current matrix.	
         Matrix4<Type> & invert()
         {
-            // inversion with Cramer's Rule.
-            Type tmp[12];
-            Type dst[16];
-
-            transpose();
-
-            //calculate pairs for first 8 elements (cofactor)
-            tmp[0]  = m_data[2][2] * m_data[3][3];
-            tmp[1]  = m_data[3][2] * m_data[2][3];
-            tmp[2]  = m_data[1][2] * m_data[3][3];
-            tmp[3]  = m_data[3][2] * m_data[1][3];
-            tmp[4]  = m_data[1][2] * m_data[2][3];
-            tmp[5]  = m_data[2][2] * m_data[1][3];
-            tmp[6]  = m_data[0][2] * m_data[3][3];
-            tmp[7]  = m_data[3][2] * m_data[0][3];
-            tmp[8]  = m_data[0][2] * m_data[2][3];
-            tmp[9]  = m_data[2][2] * m_data[0][3];
-            tmp[10] = m_data[0][2] * m_data[1][3];
-            tmp[11] = m_data[1][2] * m_data[0][3];
-
-            //calculate first 8 elements (cofactor)
-            dst[0]  = tmp[0]*m_data[1][1] + tmp[3]*m_data[2][1] + tmp[4]*m_data[3][1];
-            dst[0] -= tmp[1]*m_data[1][1] + tmp[2]*m_data[2][1] + tmp[5]*m_data[3][1];
-            dst[1]  = tmp[1]*m_data[0][1] + tmp[6]*m_data[2][1] + tmp[9]*m_data[3][1];
-            dst[1] -= tmp[0]*m_data[0][1] + tmp[7]*m_data[2][1] + tmp[8]*m_data[3][1];
-            dst[2]  = tmp[2]*m_data[0][1] + tmp[7]*m_data[1][1] + tmp[10]*m_data[3][1];
-            dst[2] -= tmp[3]*m_data[0][1] + tmp[6]*m_data[1][1] + tmp[11]*m_data[3][1];
-            dst[3]  = tmp[5]*m_data[0][1] + tmp[8]*m_data[1][1] + tmp[11]*m_data[2][1];
-            dst[3] -= tmp[4]*m_data[0][1] + tmp[9]*m_data[1][1] + tmp[10]*m_data[2][1];
-            dst[4]  = tmp[1]*m_data[1][0] + tmp[2]*m_data[2][0] + tmp[5]*m_data[3][0];
-            dst[4] -= tmp[0]*m_data[1][0] + tmp[3]*m_data[2][0] + tmp[4]*m_data[3][0];
-            dst[5]  = tmp[0]*m_data[0][0] + tmp[7]*m_data[2][0] + tmp[8]*m_data[3][0];
-            dst[5] -= tmp[1]*m_data[0][0] + tmp[6]*m_data[2][0] + tmp[9]*m_data[3][0];
-            dst[6]  = tmp[3]*m_data[0][0] + tmp[6]*m_data[1][0] + tmp[11]*m_data[3][0];
-            dst[6] -= tmp[2]*m_data[0][0] + tmp[7]*m_data[1][0] + tmp[10]*m_data[3][0];
-            dst[7]  = tmp[4]*m_data[0][0] + tmp[9]*m_data[1][0] + tmp[10]*m_data[2][0];
-            dst[7] -= tmp[5]*m_data[0][0] + tmp[8]*m_data[1][0] + tmp[11]*m_data[2][0];
-
-            //calculate pairs for second 8 elements (cofactors)
-            tmp[0]  = m_data[2][0]*m_data[3][1];
-            tmp[1]  = m_data[3][0]*m_data[2][1];
-            tmp[2]  = m_data[1][0]*m_data[3][1];
-            tmp[3]  = m_data[3][0]*m_data[1][1];
-            tmp[4]  = m_data[1][0]*m_data[2][1];
-            tmp[5]  = m_data[2][0]*m_data[1][1];
-            tmp[6]  = m_data[0][0]*m_data[3][1];
-            tmp[7]  = m_data[3][0]*m_data[0][1];
-            tmp[8]  = m_data[0][0]*m_data[2][1];
-            tmp[9]  = m_data[2][0]*m_data[0][1];
-            tmp[10] = m_data[0][0]*m_data[1][1];
-            tmp[11] = m_data[1][0]*m_data[0][1];
-
-            //calculate second 8 elements (cofactors)
-            dst[8]   = tmp[0]*m_data[1][3] + tmp[3]*m_data[2][3] + tmp[4]*m_data[3][3];
-            dst[8]  -= tmp[1]*m_data[1][3] + tmp[2]*m_data[2][3] + tmp[5]*m_data[3][3];
-            dst[9]   = tmp[1]*m_data[0][3] + tmp[6]*m_data[2][3] + tmp[9]*m_data[3][3];
-            dst[9]  -= tmp[0]*m_data[0][3] + tmp[7]*m_data[2][3] + tmp[8]*m_data[3][3];
-            dst[10]  = tmp[2]*m_data[0][3] + tmp[7]*m_data[1][3] + tmp[10]*m_data[3][3];
-            dst[10] -= tmp[3]*m_data[0][3] + tmp[6]*m_data[1][3] + tmp[11]*m_data[3][3];
-            dst[11]  = tmp[5]*m_data[0][3] + tmp[8]*m_data[1][3] + tmp[11]*m_data[2][3];
-            dst[11] -= tmp[4]*m_data[0][3] + tmp[9]*m_data[1][3] + tmp[10]*m_data[2][3];
-            dst[12]  = tmp[2]*m_data[2][2] + tmp[5]*m_data[3][2] + tmp[1]*m_data[1][2];
-            dst[12] -= tmp[4]*m_data[3][2] + tmp[0]*m_data[1][2] + tmp[3]*m_data[2][2];
-            dst[13]  = tmp[8]*m_data[3][2] + tmp[0]*m_data[0][2] + tmp[7]*m_data[2][2];
-            dst[13] -= tmp[6]*m_data[2][2] + tmp[9]*m_data[3][2] + tmp[1]*m_data[0][2];
-            dst[14]  = tmp[6]*m_data[1][2] + tmp[11]*m_data[3][2] + tmp[3]*m_data[0][2];
-            dst[14] -= tmp[10]*m_data[3][2] + tmp[2]*m_data[0][2] + tmp[7]*m_data[1][2];
-            dst[15]  = tmp[10]*m_data[2][2] + tmp[4]*m_data[0][2] + tmp[9]*m_data[1][2];
-            dst[15] -= tmp[8]*m_data[1][2] + tmp[11]*m_data[2][2] + tmp[5]*m_data[0][2];
-
-            //calculate determinant
-            Type det = (Type)1.0 / (m_data[0][0]*dst[0] + m_data[1][0]*dst[1] + m_data[2][0]*dst[2] + m_data[3][0]*dst[3]);
-
-            //calculate matrix inverse
-            m_data[0][0] = dst[0] * det; m_data[0][1] = dst[4] * det; m_data[0][2] = dst[8] * det; m_data[0][3] = dst[12] * det;
-            m_data[1][0] = dst[1] * det; m_data[1][1] = dst[5] * det; m_data[1][2] = dst[9] * det; m_data[1][3] = dst[13] * det;
-            m_data[2][0] = dst[2] * det; m_data[2][1] = dst[6] * det; m_data[2][2] = dst[10] * det; m_data[2][3] = dst[14] * det;
-            m_data[3][0] = dst[3] * det; m_data[3][1] = dst[7] * det; m_data[3][2] = dst[11] * det; m_data[3][3] = dst[15] * det;
+            invert(m_data);
 
             return *this;
         }
@@ -176,17 +91,22 @@ namespace gtl
         }
 
         //! Transpose the current matrix.
-        Matrix4<Type> & transpose()
+        GTL_CONSTEXPR14 Matrix4<Type> & transpose()
         {
-            *this = Matrix4<Type>(m_data[0][0], m_data[1][0], m_data[2][0], m_data[3][0],
-                m_data[0][1], m_data[1][1], m_data[2][1], m_data[3][1],
-                m_data[0][2], m_data[1][2], m_data[2][2], m_data[3][2],
-                m_data[0][3], m_data[1][3], m_data[2][3], m_data[3][3]);
+            if(GTL_CONSTANT_EVALUATED()) transpose<Type>(m_data);
+            else transpose(m_data);
             return *this;
         }
 
+        //! Check if the matrix is affine, i.e. its last column is (0, 0, 0, 1) and points need no perspective divide.
+        GTL_CONSTEXPR14 bool isAffine() const
+        {
+            return (m_data[0][3] == (Type)0.0 && m_data[1][3] == (Type)0.0 &&
+                    m_data[2][3] == (Type)0.0 && m_data[3][3] == (Type)1.0);
+        }
+
         //! Returns the determinant of the 3x3 submatrix specified by the row and column indices.
-        Type det3(int r1, int r2, int r3, int c1, int c2, int c3) const
+        GTL_CONSTEXPR14 Type det3(int r1, int r2, int r3, int c1, int c2, int c3) const
         {
             // More or less directly from "Advanced Engineering Mathematics"
             // (E. Kreyszig), 6th edition.
@@ -208,7 +128,7 @@ namespace gtl
         }
 
         //! Returns the determinant of the upper left 3x3 submatrix.
-        Type det3() const
+        GTL_CONSTEXPR14 Type det3() const
         {
             return this->det3(0, 1, 2, 0, 1, 2);
         }
@@ -216,12 +136,7 @@ namespace gtl
         //! Returns the determinant of the matrix.
         Type det4() const
         {
-            Type det = 0.0;
-            det += m_data[0][0] * det3(1, 2, 3, 1, 2, 3);
-            det -= m_data[1][0] * det3(0, 2, 3, 1, 2, 3);
-            det += m_data[2][0] * det3(0, 1, 3, 1, 2, 3);
-            det -= m_data[3][0] * det3(0, 1, 2, 1, 2, 3);
-            return det;
+            return determinant(m_data);
         }
 
         //! Check if the \a a_matrix matrix is equal to this one, within the given tolerance value.
@@ -243,40 +158,17 @@ namespace gtl
         }
 
         //! Returns pointer to the 4 element array representing a matrix row. \a i should be within [0, 3].
-        Type * operator [](int i)
+        GTL_CONSTEXPR14 Type * operator [](int i)
         { 
             return m_data[i]; 
         }
 
         //! Returns pointer to the 4 element array representing a matrix row. \a i should be within [0, 3].
-        const Type * operator [](int i) const
+        GTL_CONSTEXPR14 const Type * operator [](int i) const
         { 
             return m_data[i]; 
         }
 
-        //! Assignment operator. Copies the elements from \a a_matrix to the matrix.
-        Matrix4<Type> & operator =(const Matrix4<Type> & m)
-        {
-            m_data[0][0] = m.m_data[0][0];
-            m_data[0][1] = m.m_data[0][1];
-            m_data[0][2] = m.m_data[0][2];
-            m_data[0][3] = m.m_data[0][3];
-            m_data[1][0] = m.m_data[1][0];
-            m_data[1][1] = m.m_data[1][1];
-            m_data[1][2] = m.m_data[1][2];
-            m_data[1][3] = m.m_data[1][3];
-            m_data[2][0] = m.m_data[2][0];
-            m_data[2][1] = m.m_data[2][1];
-            m_data[2][2] = m.m_data[2][2];
-            m_data[2][3] = m.m_data[2][3];
-            m_data[3][0] = m.m_data[3][0];
-            m_data[3][1] = m.m_data[3][1];
-            m_data[3][2] = m.m_data[3][2];
-            m_data[3][3] = m.m_data[3][3];
-
-            return *this;
-        }
-
         Matrix4<Type> & operator =(const Quat<Type> & a_quat)
         {
             setRotate(a_quat);
@@ -285,13 +177,13 @@ namespace gtl
         }
 
         //! Right-multiply with the \a a_matrix matrix. \sa multRight().
-        Matrix4<Type> & operator *=(const Matrix4<Type> & a_matrix)
+        GTL_CONSTEXPR14 Matrix4<Type> & operator *=(const Matrix4<Type> & a_matrix)
         {
             return multRight(a_matrix);
         }
 
         //! Multiplies matrix \a m1 with matrix \a m2 and returns the resultant matrix.
-        friend Matrix4<Type> operator *(const Matrix4<Type> & m1, const Matrix4<Type> & m2)
+        friend GTL_CONSTEXPR14 Matrix4<Type> operator *(const Matrix4<Type> & m1, const Matrix4<Type> & m2)
         { 
             Matrix4<Type> m = m1; 
             m *= m2; 
@@ -303,7 +195,7 @@ namespace gtl
 
         \sa equals().
         */
-        friend bool operator ==(const Matrix4<Type> & m1, const Matrix4<Type> & m2)
+        friend GTL_CONSTEXPR14 bool operator ==(const Matrix4<Type> & m1, const Matrix4<Type> & m2)
         {
             return (
                 m1.m_data[0][0] == m2.m_data[0][0] &&
@@ -329,7 +221,7 @@ namespace gtl
         }
 
 
-        friend bool operator !=(const Matrix4<Type> & m1, const Matrix4<Type> & m2)
+        friend GTL_CONSTEXPR14 bool operator !=(const Matrix4<Type> & m1, const Matrix4<Type> & m2)
         { 
             return !(m1 == m2);
         }
@@ -340,13 +232,13 @@ namespace gtl
         }
 
         //! Set matrix to be a pure scaling matrix. (no translation or rotation components)
-        void setScale(const Type s)
+        GTL_CONSTEXPR14 void setScale(const Type s)
         {
             setScale(Vec3<Type>(s,s,s));
         }
 
         //! Set matrix to be a pure scaling matrix. (no translation or rotation components)
-        void setScale(const Vec3<Type> & s)
+        GTL_CONSTEXPR14 void setScale(const Vec3<Type> & s)
         {
             makeIdentity();
             m_data[0][0] = s[0];
@@ -355,7 +247,7 @@ namespace gtl
         }
 
         //! Make this matrix into a pure translation matrix. (no scale or rotation components)
-        void setTranslate(const Vec3<Type> & t)
+        GTL_CONSTEXPR14 void setTranslate(const Vec3<Type> & t)
         {
             makeIdentity();
             m_data[3][0] = t[0];
@@ -364,65 +256,43 @@ namespace gtl
         }
 
         //! Let this matrix be right-multiplied by m. Returns reference to self.
-        Matrix4<Type> & multRight(const Matrix4<Type> & m)
-        {
-            // Trivial cases
-            if(m.isIdentity()) return *this;
-            else if(isIdentity()) return (*this = m);
-
-            Matrix4<Type> tmp;
-
-            tmp[0][0] = m_data[0][0]*m.m_data[0][0] + m_data[0][1]*m.m_data[1][0] + m_data[0][2]*m.m_data[2][0] + m_data[0][3]*m.m_data[3][0];
-            tmp[0][1] = m_data[0][0]*m.m_data[0][1] + m_data[0][1]*m.m_data[1][1] + m_data[0][2]*m.m_data[2][1] + m_data[0][3]*m.m_data[3][1];
-            tmp[0][2] = m_data[0][0]*m.m_data[0][2] + m_data[0][1]*m.m_data[1][2] + m_data[0][2]*m.m_data[2][2] + m_data[0][3]*m.m_data[3][2];
-            tmp[0][3] = m_data[0][0]*m.m_data[0][3] + m_data[0][1]*m.m_data[1][3] + m_data[0][2]*m.m_data[2][3] + m_data[0][3]*m.m_data[3][3];
-            tmp[1][0] = m_data[1][0]*m.m_data[0][0] + m_data[1][1]*m.m_data[1][0] + m_data[1][2]*m.m_data[2][0] + m_data[1][3]*m.m_data[3][0];
-            tmp[1][1] = m_data[1][0]*m.m_data[0][1] + m_data[1][1]*m.m_data[1][1] + m_data[1][2]*m.m_data[2][1] + m_data[1][3]*m.m_data[3][1];
-            tmp[1][2] = m_data[1][0]*m.m_data[0][2] + m_data[1][1]*m.m_data[1][2] + m_data[1][2]*m.m_data[2][2] + m_data[1][3]*m.m_data[3][2];
-            tmp[1][3] = m_data[1][0]*m.m_data[0][3] + m_data[1][1]*m.m_data[1][3] + m_data[1][2]*m.m_data[2][3] + m_data[1][3]*m.m_data[3][3];
-            tmp[2][0] = m_data[2][0]*m.m_data[0][0] + m_data[2][1]*m.m_data[1][0] + m_data[2][2]*m.m_data[2][0] + m_data[2][3]*m.m_data[3][0];
-            tmp[2][1] = m_data[2][0]*m.m_data[0][1] + m_data[2][1]*m.m_data[1][1] + m_data[2][2]*m.m_data[2][1] + m_data[2][3]*m.m_data[3][1];
-            tmp[2][2] = m_data[2][0]*m.m_data[0][2] + m_data[2][1]*m.m_data[1][2] + m_data[2][2]*m.m_data[2][2] + m_data[2][3]*m.m_data[3][2];
-            tmp[2][3] = m_data[2][0]*m.m_data[0][3] + m_data[2][1]*m.m_data[1][3] + m_data[2][2]*m.m_data[2][3] + m_data[2][3]*m.m_data[3][3];
-            tmp[3][0] = m_data[3][0]*m.m_data[0][0] + m_data[3][1]*m.m_data[1][0] + m_data[3][2]*m.m_data[2][0] + m_data[3][3]*m.m_data[3][0];
-            tmp[3][1] = m_data[3][0]*m.m_data[0][1] + m_data[3][1]*m.m_data[1][1] + m_data[3][2]*m.m_data[2][1] + m_data[3][3]*m.m_data[3][1];
-            tmp[3][2] = m_data[3][0]*m.m_data[0][2] + m_data[3][1]*m.m_data[1][2] + m_data[3][2]*m.m_data[2][2] + m_data[3][3]*m.m_data[3][2];
-            tmp[3][3] = m_data[3][0]*m.m_data[0][3] + m_data[3][1]*m.m_data[1][3] + m_data[3][2]*m.m_data[2][3] + m_data[3][3]*m.m_data[3][3];
-
-            return (*this = tmp);
+        GTL_CONSTEXPR14 Matrix4<Type> & multRight(const Matrix4<Type> & m)
+        {
+            if(GTL_CONSTANT_EVALUATED()) setProductConstant(m_data, m.m_data);
+            else setProduct(m_data, m.m_data);
+
+            return *this;
         }
 
         //! Let this matrix be left-multiplied by m. Returns reference to self.
-        Matrix4<Type> & multLeft(const Matrix4<Type> & m)
-        {
-            // Trivial cases
-            if(m.isIdentity()) return *this;
-            else if(isIdentity())	return (*this = m);
-
-            Matrix4<Type> tmp;
-
-            tmp[0][0] = m.m_data[0][0]*m_data[0][0] + m.m_data[0][1]*m_data[1][0] + m.m_data[0][2]*m_data[2][0] + m.m_data[0][3]*m_data[3][0];
-            tmp[0][1] = m.m_data[0][0]*m_data[0][1] + m.m_data[0][1]*m_data[1][1] + m.m_data[0][2]*m_data[2][1] + m.m_data[0][3]*m_data[3][1];
-            tmp[0][2] = m.m_data[0][0]*m_data[0][2] + m.m_data[0][1]*m_data[1][2] + m.m_data[0][2]*m_data[2][2] + m.m_data[0][3]*m_data[3][2];
-            tmp[0][3] = m.m_data[0][0]*m_data[0][3] + m.m_data[0][1]*m_data[1][3] + m.m_data[0][2]*m_data[2][3] + m.m_data[0][3]*m_data[3][3];
-            tmp[1][0] = m.m_data[1][0]*m_data[0][0] + m.m_data[1][1]*m_data[1][0] + m.m_data[1][2]*m_data[2][0] + m.m_data[1][3]*m_data[3][0];
-            tmp[1][1] = m.m_data[1][0]*m_data[0][1] + m.m_data[1][1]*m_data[1][1] + m.m_data[1][2]*m_data[2][1] + m.m_data[1][3]*m_data[3][1];
-            tmp[1][2] = m.m_data[1][0]*m_data[0][2] + m.m_data[1][1]*m_data[1][2] + m.m_data[1][2]*m_data[2][2] + m.m_data[1][3]*m_data[3][2];
-            tmp[1][3] = m.m_data[1][0]*m_data[0][3] + m.m_data[1][1]*m_data[1][3] + m.m_data[1][2]*m_data[2][3] + m.m_data[1][3]*m_data[3][3];
-            tmp[2][0] = m.m_data[2][0]*m_data[0][0] + m.m_data[2][1]*m_data[1][0] + m.m_data[2][2]*m_data[2][0] + m.m_data[2][3]*m_data[3][0];
-            tmp[2][1] = m.m_data[2][0]*m_data[0][1] + m.m_data[2][1]*m_data[1][1] + m.m_data[2][2]*m_data[2][1] + m.m_data[2][3]*m_data[3][1];
-            tmp[2][2] = m.m_data[2][0]*m_data[0][2] + m.m_data[2][1]*m_data[1][2] + m.m_data[2][2]*m_data[2][2] + m.m_data[2][3]*m_data[3][2];
-            tmp[2][3] = m.m_data[2][0]*m_data[0][3] + m.m_data[2][1]*m_data[1][3] + m.m_data[2][2]*m_data[2][3] + m.m_data[2][3]*m_data[3][3];
-            tmp[3][0] = m.m_data[3][0]*m_data[0][0] + m.m_data[3][1]*m_data[1][0] + m.m_data[3][2]*m_data[2][0] + m.m_data[3][3]*m_data[3][0];
-            tmp[3][1] = m.m_data[3][0]*m_data[0][1] + m.m_data[3][1]*m_data[1][1] + m.m_data[3][2]*m_data[2][1] + m.m_data[3][3]*m_data[3][1];
-            tmp[3][2] = m.m_data[3][0]*m_data[0][2] + m.m_data[3][1]*m_data[1][2] + m.m_data[3][2]*m_data[2][2] + m.m_data[3][3]*m_data[3][2];
-            tmp[3][3] = m.m_data[3][0]*m_data[0][3] + m.m_data[3][1]*m_data[1][3] + m.m_data[3][2]*m_data[2][3] + m.m_data[3][3]*m_data[3][3];
-
-            return (*this = tmp);
+        GTL_CONSTEXPR14 Matrix4<Type> & multLeft(const Matrix4<Type> & m)
+        {
+            if(GTL_CONSTANT_EVALUATED()) setProductConstant(m.m_data, m_data);
+            else setProduct(m.m_data, m_data);
+
+            return *this;
+        }
+
+        /*! Computes out[i] = a[i] * b[i] for the \a n pairs of matrices, as when composing the
+        transformations of many nodes. \a out may be the same array as \a a or \a b.
+        */
+        static void multiplyMany(const Matrix4<Type> * a, const Matrix4<Type> * b, Matrix4<Type> * out, std::size_t n)
+        {
+            const long count = (long)n;
+
+#ifdef _OPENMP
+            #pragma omp parallel for if(count > 4096)
+#endif
+            for(long i = 0; i < count; i++){
+                Type tmp[4][4];
+
+                multiply(a[i].m_data, b[i].m_data, tmp);
+                copy(tmp, out[i].m_data);
+            }
         }
 
         //! Multiplies matrix by given column vector, giving vector result. 
-        void multMatrixVec(const Vec3<Type> & src, Vec3<Type> & dst) const
+        GTL_CONSTEXPR14 void multMatrixVec(const Vec3<Type> & src, Vec3<Type> & dst) const
         {
             Type x = m_data[0][0]*src[0] + m_data[0][1]*src[1] + m_data[0][2]*src[2] + m_data[0][3];
             Type y = m_data[1][0]*src[0] + m_data[1][1]*src[1] + m_data[1][2]*src[2] + m_data[1][3];
@@ -433,7 +303,7 @@ namespace gtl
         }
 
         //! Multiplies given row vector by matrix, giving vector result. 
-        void multVecMatrix(const Vec3<Type> & src, Vec3<Type> & dst) const
+        GTL_CONSTEXPR14 void multVecMatrix(const Vec3<Type> & src, Vec3<Type> & dst) const
         {
             Type x = src[0]*m_data[0][0] + src[1]*m_data[1][0] + src[2]*m_data[2][0] + m_data[3][0];
             Type y = src[0]*m_data[0][1] + src[1]*m_data[1][1] + src[2]*m_data[2][1] + m_data[3][1];
@@ -447,13 +317,75 @@ namespace gtl
         src is assumed to be a direction vector, so translation part of matrix is ignored. 
         Note: if you wish to transform surface points and normals by a matrix, call multVecMatrix() for the points and call multDirMatrix() on the inverse transpose of the matrix for the normals.
         */
-        void multDirMatrix(const Vec3<Type> & src, Vec3<Type> & dst) const
+        GTL_CONSTEXPR14 void multDirMatrix(const Vec3<Type> & src, Vec3<Type> & dst) const
         {
             dst.setValue(src[0]*m_data[0][0] + src[1]*m_data[1][0] + src[2]*m_data[2][0],
                 src[0]*m_data[0][1] + src[1]*m_data[1][1] + src[2]*m_data[2][1],
                 src[0]*m_data[0][2] + src[1]*m_data[1][2] + src[2]*m_data[2][2]);
         }
 
+        /*! Multiplies the \a n row vectors of \a src by the matrix, like multVecMatrix(), and writes them to \a dst.
+        The matrix is checked once for being affine, in which case the perspective divide is skipped.
+        \a src and \a dst may be the same array.
+        */
+        void transformPoints(const Vec3<Type> * src, Vec3<Type> * dst, std::size_t n) const
+        {
+            const Type m00 = m_data[0][0], m01 = m_data[0][1], m02 = m_data[0][2];
+            const Type m10 = m_data[1][0], m11 = m_data[1][1], m12 = m_data[1][2];
+            const Type m20 = m_data[2][0], m21 = m_data[2][1], m22 = m_data[2][2];
+            const Type m30 = m_data[3][0], m31 = m_data[3][1], m32 = m_data[3][2];
+
+            if(isAffine()){
+                for(std::size_t i = 0; i < n; i++){
+                    const Type x = src[i][0], y = src[i][1], z = src[i][2];
+                    dst[i].setValue(x*m00 + y*m10 + z*m20 + m30,
+                                    x*m01 + y*m11 + z*m21 + m31,
+                                    x*m02 + y*m12 + z*m22 + m32);
+                }
+            }else{
+                const Type m03 = m_data[0][3], m13 = m_data[1][3], m23 = m_data[2][3], m33 = m_data[3][3];
+
+                for(std::size_t i = 0; i < n; i++){
+                    const Type x = src[i][0], y = src[i][1], z = src[i][2];
+                    const Type w = x*m03 + y*m13 + z*m23 + m33;
+                    dst[i].setValue((x*m00 + y*m10 + z*m20 + m30) / w,
+                                    (x*m01 + y*m11 + z*m21 + m31) / w,
+                                    (x*m02 + y*m12 + z*m22 + m32) / w);
+                }
+            }
+        }
+
+        //! Multiplies the \a n direction vectors of \a src by the matrix, like multDirMatrix(), and writes them to \a dst.
+        void transformDirections(const Vec3<Type> * src, Vec3<Type> * dst, std::size_t n) const
+        {
+            const Type m00 = m_data[0][0], m01 = m_data[0][1], m02 = m_data[0][2];
+            const Type m10 = m_data[1][0], m11 = m_data[1][1], m12 = m_data[1][2];
+            const Type m20 = m_data[2][0], m21 = m_data[2][1], m22 = m_data[2][2];
+
+            for(std::size_t i = 0; i < n; i++){
+                const Type x = src[i][0], y = src[i][1], z = src[i][2];
+                dst[i].setValue(x*m00 + y*m10 + z*m20,
+                                x*m01 + y*m11 + z*m21,
+                                x*m02 + y*m12 + z*m22);
+            }
+        }
+
+        //! Multiplies the row vectors of \a src by the matrix and writes them to \a dst, which is resized. \a src and \a dst may be the same array.
+        void transformPoints(const Vec3Array<Type> & src, Vec3Array<Type> & dst) const
+        {
+            dst.resize(src.size());
+
+            transformStreams(src.x(), src.y(), src.z(), dst.x(), dst.y(), dst.z(), src.size(), true);
+        }
+
+        //! Multiplies the direction vectors of \a src by the matrix and writes them to \a dst, which is resized.
+        void transformDirections(const Vec3Array<Type> & src, Vec3Array<Type> & dst) const
+        {
+            dst.resize(src.size());
+
+            transformStreams(src.x(), src.y(), src.z(), dst.x(), dst.y(), dst.z(), src.size(), false);
+        }
+
         friend std::ostream & operator<<(std::ostream & os, const Matrix4<Type> & mat)
         { 
             for(unsigned int i=0; i<4; i++){
@@ -463,11 +395,514 @@ namespace gtl
         }
     private:
         Type m_data[4][4];
+
+        static GTL_CONSTEXPR14 void copy(const Type src[4][4], Type dst[4][4])
+        {
+            for(int i = 0; i < 4; i++){
+                for(int j = 0; j < 4; j++) dst[i][j] = src[i][j];
+            }
+        }
+
+        // Sets this matrix to a * b, a or b may be this matrix.
+        void setProduct(const Type a[4][4], const Type b[4][4])
+        {
+            Type tmp[4][4];
+
+            multiply(a, b, tmp);
+            copy(tmp, m_data);
+        }
+
+        // Same as setProduct() with the generic kernel, which can be evaluated at compile time.
+        GTL_CONSTEXPR14 void setProductConstant(const Type a[4][4], const Type b[4][4])
+        {
+            Type tmp[4][4] = {};
+
+            multiply<Type>(a, b, tmp);
+            copy(tmp, m_data);
+        }
+
+        // r = a * b, r must not be a or b. The generic kernels can be evaluated at compile time.
+        template<typename T>
+        static GTL_CONSTEXPR14 void multiply(const T a[4][4], const T b[4][4], T r[4][4])
+        {
+            for(int i = 0; i < 4; i++){
+                for(int j = 0; j < 4; j++){
+                    r[i][j] = a[i][0]*b[0][j] + a[i][1]*b[1][j] + a[i][2]*b[2][j] + a[i][3]*b[3][j];
+                }
+            }
+        }
+
+        template<typename T>
+        static GTL_CONSTEXPR14 void transpose(T m[4][4])
+        {
+            for(int i = 0; i < 4; i++){
+                for(int j = i + 1; j < 4; j++){
+                    T t = m[i][j]; m[i][j] = m[j][i]; m[j][i] = t;
+                }
+            }
+        }
+
+        // Laplace expansion along the first two rows, with 2x2 minors.
+        template<typename T>
+        static T determinant(const T m[4][4])
+        {
+            const T s0 = m[0][0]*m[1][1] - m[1][0]*m[0][1];
+            const T s1 = m[0][0]*m[1][2] - m[1][0]*m[0][2];
+            const T s2 = m[0][0]*m[1][3] - m[1][0]*m[0][3];
+            const T s3 = m[0][1]*m[1][2] - m[1][1]*m[0][2];
+            const T s4 = m[0][1]*m[1][3] - m[1][1]*m[0][3];
+            const T s5 = m[0][2]*m[1][3] - m[1][2]*m[0][3];
+
+            const T c5 = m[2][2]*m[3][3] - m[3][2]*m[2][3];
+            const T c4 = m[2][1]*m[3][3] - m[3][1]*m[2][3];
+            const T c3 = m[2][1]*m[3][2] - m[3][1]*m[2][2];
+            const T c2 = m[2][0]*m[3][3] - m[3][0]*m[2][3];
+            const T c1 = m[2][0]*m[3][2] - m[3][0]*m[2][2];
+            const T c0 = m[2][0]*m[3][1] - m[3][0]*m[2][1];
+
+            return s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0;
+        }
+
+        // Inverts m in place with Cramer's rule.
+        template<typename T>
+        static void invert(T m[4][4])
+        {
+            // inversion with Cramer's Rule.
+            T tmp[12];
+            T dst[16];
+
+            transpose(m);
+
+            //calculate pairs for first 8 elements (cofactor)
+            tmp[0]  = m[2][2] * m[3][3];
+            tmp[1]  = m[3][2] * m[2][3];
+            tmp[2]  = m[1][2] * m[3][3];
+            tmp[3]  = m[3][2] * m[1][3];
+            tmp[4]  = m[1][2] * m[2][3];
+            tmp[5]  = m[2][2] * m[1][3];
+            tmp[6]  = m[0][2] * m[3][3];
+            tmp[7]  = m[3][2] * m[0][3];
+            tmp[8]  = m[0][2] * m[2][3];
+            tmp[9]  = m[2][2] * m[0][3];
+            tmp[10] = m[0][2] * m[1][3];
+            tmp[11] = m[1][2] * m[0][3];
+
+            //calculate first 8 elements (cofactor)
+            dst[0]  = tmp[0]*m[1][1] + tmp[3]*m[2][1] + tmp[4]*m[3][1];
+            dst[0] -= tmp[1]*m[1][1] + tmp[2]*m[2][1] + tmp[5]*m[3][1];
+            dst[1]  = tmp[1]*m[0][1] + tmp[6]*m[2][1] + tmp[9]*m[3][1];
+            dst[1] -= tmp[0]*m[0][1] + tmp[7]*m[2][1] + tmp[8]*m[3][1];
+            dst[2]  = tmp[2]*m[0][1] + tmp[7]*m[1][1] + tmp[10]*m[3][1];
+            dst[2] -= tmp[3]*m[0][1] + tmp[6]*m[1][1] + tmp[11]*m[3][1];
+            dst[3]  = tmp[5]*m[0][1] + tmp[8]*m[1][1] + tmp[11]*m[2][1];
+            dst[3] -= tmp[4]*m[0][1] + tmp[9]*m[1][1] + tmp[10]*m[2][1];
+            dst[4]  = tmp[1]*m[1][0] + tmp[2]*m[2][0] + tmp[5]*m[3][0];
+            dst[4] -= tmp[0]*m[1][0] + tmp[3]*m[2][0] + tmp[4]*m[3][0];
+            dst[5]  = tmp[0]*m[0][0] + tmp[7]*m[2][0] + tmp[8]*m[3][0];
+            dst[5] -= tmp[1]*m[0][0] + tmp[6]*m[2][0] + tmp[9]*m[3][0];
+            dst[6]  = tmp[3]*m[0][0] + tmp[6]*m[1][0] + tmp[11]*m[3][0];
+            dst[6] -= tmp[2]*m[0][0] + tmp[7]*m[1][0] + tmp[10]*m[3][0];
+            dst[7]  = tmp[4]*m[0][0] + tmp[9]*m[1][0] + tmp[10]*m[2][0];
+            dst[7] -= tmp[5]*m[0][0] + tmp[8]*m[1][0] + tmp[11]*m[2][0];
+
+            //calculate pairs for second 8 elements (cofactors)
+            tmp[0]  = m[2][0]*m[3][1];
+            tmp[1]  = m[3][0]*m[2][1];
+            tmp[2]  = m[1][0]*m[3][1];
+            tmp[3]  = m[3][0]*m[1][1];
+            tmp[4]  = m[1][0]*m[2][1];
+            tmp[5]  = m[2][0]*m[1][1];
+            tmp[6]  = m[0][0]*m[3][1];
+            tmp[7]  = m[3][0]*m[0][1];
+            tmp[8]  = m[0][0]*m[2][1];
+            tmp[9]  = m[2][0]*m[0][1];
+            tmp[10] = m[0][0]*m[1][1];
+            tmp[11] = m[1][0]*m[0][1];
+
+            //calculate second 8 elements (cofactors)
+            dst[8]   = tmp[0]*m[1][3] + tmp[3]*m[2][3] + tmp[4]*m[3][3];
+            dst[8]  -= tmp[1]*m[1][3] + tmp[2]*m[2][3] + tmp[5]*m[3][3];
+            dst[9]   = tmp[1]*m[0][3] + tmp[6]*m[2][3] + tmp[9]*m[3][3];
+            dst[9]  -= tmp[0]*m[0][3] + tmp[7]*m[2][3] + tmp[8]*m[3][3];
+            dst[10]  = tmp[2]*m[0][3] + tmp[7]*m[1][3] + tmp[10]*m[3][3];
+            dst[10] -= tmp[3]*m[0][3] + tmp[6]*m[1][3] + tmp[11]*m[3][3];
+            dst[11]  = tmp[5]*m[0][3] + tmp[8]*m[1][3] + tmp[11]*m[2][3];
+            dst[11] -= tmp[4]*m[0][3] + tmp[9]*m[1][3] + tmp[10]*m[2][3];
+            dst[12]  = tmp[2]*m[2][2] + tmp[5]*m[3][2] + tmp[1]*m[1][2];
+            dst[12] -= tmp[4]*m[3][2] + tmp[0]*m[1][2] + tmp[3]*m[2][2];
+            dst[13]  = tmp[8]*m[3][2] + tmp[0]*m[0][2] + tmp[7]*m[2][2];
+            dst[13] -= tmp[6]*m[2][2] + tmp[9]*m[3][2] + tmp[1]*m[0][2];
+            dst[14]  = tmp[6]*m[1][2] + tmp[11]*m[3][2] + tmp[3]*m[0][2];
+            dst[14] -= tmp[10]*m[3][2] + tmp[2]*m[0][2] + tmp[7]*m[1][2];
+            dst[15]  = tmp[10]*m[2][2] + tmp[4]*m[0][2] + tmp[9]*m[1][2];
+            dst[15] -= tmp[8]*m[1][2] + tmp[11]*m[2][2] + tmp[5]*m[0][2];
+
+            //calculate determinant
+            T det = (T)1.0 / (m[0][0]*dst[0] + m[1][0]*dst[1] + m[2][0]*dst[2] + m[3][0]*dst[3]);
+
+            //calculate matrix inverse
+            m[0][0] = dst[0] * det; m[0][1] = dst[4] * det; m[0][2] = dst[8] * det; m[0][3] = dst[12] * det;
+            m[1][0] = dst[1] * det; m[1][1] = dst[5] * det; m[1][2] = dst[9] * det; m[1][3] = dst[13] * det;
+            m[2][0] = dst[2] * det; m[2][1] = dst[6] * det; m[2][2] = dst[10] * det; m[2][3] = dst[14] * det;
+            m[3][0] = dst[3] * det; m[3][1] = dst[7] * det; m[3][2] = dst[11] * det; m[3][3] = dst[15] * det;
+        }
+
+#ifdef GTL_SSE2
+        // SSE versions for float, one row per register.
+        static void multiply(const float a[4][4], const float b[4][4], float r[4][4])
+        {
+            const __m128 b0 = _mm_loadu_ps(b[0]), b1 = _mm_loadu_ps(b[1]), b2 = _mm_loadu_ps(b[2]), b3 = _mm_loadu_ps(b[3]);
+
+            for(int i = 0; i < 4; i++){
+                __m128 row = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(a[i][0]), b0), _mm_mul_ps(_mm_set1_ps(a[i][1]), b1));
+                row = _mm_add_ps(row, _mm_add_ps(_mm_mul_ps(_mm_set1_ps(a[i][2]), b2), _mm_mul_ps(_mm_set1_ps(a[i][3]), b3)));
+                _mm_storeu_ps(r[i], row);
+            }
+        }
+
+        static void transpose(float m[4][4])
+        {
+            __m128 r0 = _mm_loadu_ps(m[0]), r1 = _mm_loadu_ps(m[1]), r2 = _mm_loadu_ps(m[2]), r3 = _mm_loadu_ps(m[3]);
+
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+            _mm_storeu_ps(m[0], r0);
+            _mm_storeu_ps(m[1], r1);
+            _mm_storeu_ps(m[2], r2);
+            _mm_storeu_ps(m[3], r3);
+        }
+
+        // Loads the matrix transposed, with the two middle rows swapped as Cramer's rule below expects them.
+        static void loadCramer(const float m[4][4], __m128 & row0, __m128 & row1, __m128 & row2, __m128 & row3)
+        {
+            const float * src = m[0];
+            __m128 tmp = _mm_setzero_ps();
+
+            row1 = _mm_setzero_ps();
+            row3 = _mm_setzero_ps();
+
+            tmp  = _mm_loadh_pi(_mm_loadl_pi(tmp, (const __m64*)(src)), (const __m64*)(src + 4));
+            row1 = _mm_loadh_pi(_mm_loadl_pi(row1, (const __m64*)(src + 8)), (const __m64*)(src + 12));
+            row0 = _mm_shuffle_ps(tmp, row1, 0x88);
+            row1 = _mm_shuffle_ps(row1, tmp, 0xDD);
+            tmp  = _mm_loadh_pi(_mm_loadl_pi(tmp, (const __m64*)(src + 2)), (const __m64*)(src + 6));
+            row3 = _mm_loadh_pi(_mm_loadl_pi(row3, (const __m64*)(src + 10)), (const __m64*)(src + 14));
+            row2 = _mm_shuffle_ps(tmp, row3, 0x88);
+            row3 = _mm_shuffle_ps(row3, tmp, 0xDD);
+        }
+
+        // Only the cofactors of the first row are needed for the determinant.
+        static float determinant(const float m[4][4])
+        {
+            __m128 row0, row1, row2, row3, tmp, minor0, det;
+
+            loadCramer(m, row0, row1, row2, row3);
+
+            tmp    = _mm_mul_ps(row2, row3);
+            tmp    = _mm_shuffle_ps(tmp, tmp, 0xB1);
+            minor0 = _mm_mul_ps(row1, tmp);
+            tmp    = _mm_shuffle_ps(tmp, tmp, 0x4E);
+            minor0 = _mm_sub_ps(_mm_mul_ps(row1, tmp), minor0);
+
+            tmp    = _mm_mul_ps(row1, row2);
+            tmp    = _mm_shuffle_ps(tmp, tmp, 0xB1);
+            minor0 = _mm_add_ps(_mm_mul_ps(row3, tmp), minor0);
+            tmp    = _mm_shuffle_ps(tmp, tmp, 0x4E);
+            minor0 = _mm_sub_ps(minor0, _mm_mul_ps(row3, tmp));
+
+            tmp    = _mm_mul_ps(_mm_shuffle_ps(row1, row1, 0x4E), row3);
+            tmp    = _mm_shuffle_ps(tmp, tmp, 0xB1);
+            row2   = _mm_shuffle_ps(row2, row2, 0x4E);
+            minor0 = _mm_add_ps(_mm_mul_ps(row2, tmp), minor0);
+            tmp    = _mm_shuffle_ps(tmp, tmp, 0x4E);
+            minor0 = _mm_sub_ps(minor0, _mm_mul_ps(row2, tmp));
+
+            det = _mm_mul_ps(row0, minor0);
+            det = _mm_add_ps(_mm_shuffle_ps(det, det, 0x4E), det);
+            det = _mm_add_ss(_mm_shuffle_ps(det, det, 0xB1), det);
+
+            return _mm_cvtss_f32(det);
+        }
+
+        // Cramer's rule on the transposed matrix, after "Streaming SIMD Extensions - Inverse of 4x4 Matrix" (Intel AP-928).
+        static void invert(float m[4][4])
+        {
+            __m128 row0, row1, row2, row3, tmp, minor0, minor1, minor2, minor3, det;
+
+            loadCramer(m, row0, row1, row2, row3);
+
+            tmp    = _mm_mul_ps(row2, row3);
+            tmp    = _mm_shuffle_ps(tmp, tmp, 0xB1);
+            minor0 = _mm_mul_ps(row1, tmp);
+            minor1 = _mm_mul_ps(row0, tmp);
+            tmp    = _mm_shuffle_ps(tmp, tmp, 0x4E);
+            minor0 = _mm_sub_ps(_mm_mul_ps(row1, tmp), minor0);
+            minor1 = _mm_sub_ps(_mm_mul_ps(row0, tmp), minor1);
+            minor1 = _mm_shuffle_ps(minor1, minor1, 0x4E);
+
+            tmp    = _mm_mul_ps(row1, row2);
+            tmp    = _mm_shuffle_ps(tmp, tmp, 0xB1);
+            minor0 = _mm_add_ps(_mm_mul_ps(row3, tmp), minor0);
+            minor3 = _mm_mul_ps(row0, tmp);
+            tmp    = _mm_shuffle_ps(tmp, tmp, 0x4E);
+            minor0 = _mm_sub_ps(minor0, _mm_mul_ps(row3, tmp));
+            minor3 = _mm_sub_ps(_mm_mul_ps(row0, tmp), minor3);
+            minor3 = _mm_shuffle_ps(minor3, minor3, 0x4E);
+
+            tmp    = _mm_mul_ps(_mm_shuffle_ps(row1, row1, 0x4E), row3);
+            tmp    = _mm_shuffle_ps(tmp, tmp, 0xB1);
+            row2   = _mm_shuffle_ps(row2, row2, 0x4E);
+            minor0 = _mm_add_ps(_mm_mul_ps(row2, tmp), minor0);
+            minor2 = _mm_mul_ps(row0, tmp);
+            tmp    = _mm_shuffle_ps(tmp, tmp, 0x4E);
+            minor0 = _mm_sub_ps(minor0, _mm_mul_ps(row2, tmp));
+            minor2 = _mm_sub_ps(_mm_mul_ps(row0, tmp), minor2);
+            minor2 = _mm_shuffle_ps(minor2, minor2, 0x4E);
+
+            tmp    = _mm_mul_ps(row0, row1);
+            tmp    = _mm_shuffle_ps(tmp, tmp, 0xB1);
+            minor2 = _mm_add_ps(_mm_mul_ps(row3, tmp), minor2);
+            minor3 = _mm_sub_ps(_mm_mul_ps(row2, tmp), minor3);
+            tmp    = _mm_shuffle_ps(tmp, tmp, 0x4E);
+            minor2 = _mm_sub_ps(_mm_mul_ps(row3, tmp), minor2);
+            minor3 = _mm_sub_ps(minor3, _mm_mul_ps(row2, tmp));
+
+            tmp    = _mm_mul_ps(row0, row3);
+            tmp    = _mm_shuffle_ps(tmp, tmp, 0xB1);
+            minor1 = _mm_sub_ps(minor1, _mm_mul_ps(row2, tmp));
+            minor2 = _mm_add_ps(_mm_mul_ps(row1, tmp), minor2);
+            tmp    = _mm_shuffle_ps(tmp, tmp, 0x4E);
+            minor1 = _mm_add_ps(_mm_mul_ps(row2, tmp), minor1);
+            minor2 = _mm_sub_ps(minor2, _mm_mul_ps(row1, tmp));
+
+            tmp    = _mm_mul_ps(row0, row2);
+            tmp    = _mm_shuffle_ps(tmp, tmp, 0xB1);
+            minor1 = _mm_add_ps(_mm_mul_ps(row3, tmp), minor1);
+            minor3 = _mm_sub_ps(minor3, _mm_mul_ps(row1, tmp));
+            tmp    = _mm_shuffle_ps(tmp, tmp, 0x4E);
+            minor1 = _mm_sub_ps(minor1, _mm_mul_ps(row3, tmp));
+            minor3 = _mm_add_ps(_mm_mul_ps(row1, tmp), minor3);
+
+            det = _mm_mul_ps(row0, minor0);
+            det = _mm_add_ps(_mm_shuffle_ps(det, det, 0x4E), det);
+            det = _mm_add_ss(_mm_shuffle_ps(det, det, 0xB1), det);
+            det = _mm_div_ps(_mm_set1_ps(1.0f), _mm_shuffle_ps(det, det, 0x00));
+
+            _mm_storeu_ps(m[0], _mm_mul_ps(det, minor0));
+            _mm_storeu_ps(m[1], _mm_mul_ps(det, minor1));
+            _mm_storeu_ps(m[2], _mm_mul_ps(det, minor2));
+            _mm_storeu_ps(m[3], _mm_mul_ps(det, minor3));
+        }
+
+        // Double rows take one AVX register, or two SSE2 registers.
+        static void multiply(const double a[4][4], const double b[4][4], double r[4][4])
+        {
+#ifdef GTL_AVX
+            const __m256d b0 = _mm256_loadu_pd(b[0]), b1 = _mm256_loadu_pd(b[1]), b2 = _mm256_loadu_pd(b[2]), b3 = _mm256_loadu_pd(b[3]);
+
+            for(int i = 0; i < 4; i++){
+                __m256d row = _mm256_add_pd(_mm256_mul_pd(_mm256_set1_pd(a[i][0]), b0), _mm256_mul_pd(_mm256_set1_pd(a[i][1]), b1));
+                row = _mm256_add_pd(row, _mm256_add_pd(_mm256_mul_pd(_mm256_set1_pd(a[i][2]), b2), _mm256_mul_pd(_mm256_set1_pd(a[i][3]), b3)));
+                _mm256_storeu_pd(r[i], row);
+            }
+#else
+            for(int h = 0; h < 4; h += 2){
+                const __m128d b0 = _mm_loadu_pd(b[0] + h), b1 = _mm_loadu_pd(b[1] + h), b2 = _mm_loadu_pd(b[2] + h), b3 = _mm_loadu_pd(b[3] + h);
+
+                for(int i = 0; i < 4; i++){
+                    __m128d row = _mm_add_pd(_mm_mul_pd(_mm_set1_pd(a[i][0]), b0), _mm_mul_pd(_mm_set1_pd(a[i][1]), b1));
+                    row = _mm_add_pd(row, _mm_add_pd(_mm_mul_pd(_mm_set1_pd(a[i][2]), b2), _mm_mul_pd(_mm_set1_pd(a[i][3]), b3)));
+                    _mm_storeu_pd(r[i] + h, row);
+                }
+            }
+#endif
+        }
+
+#ifdef GTL_AVX
+        // Loads the columns of m, and the 2x2 minors of columns a and b as m[a] where the
+        // lanes hold the minor of rows 2 and 3 twice, then the minor of rows 0 and 1 twice.
+        static void loadMinors(const double m[4][4], __m256d col[4], __m256d minor[6])
+        {
+            const __m256d r0 = _mm256_loadu_pd(m[0]), r1 = _mm256_loadu_pd(m[1]), r2 = _mm256_loadu_pd(m[2]), r3 = _mm256_loadu_pd(m[3]);
+            const __m256d t0 = _mm256_unpacklo_pd(r0, r1), t1 = _mm256_unpackhi_pd(r0, r1);
+            const __m256d t2 = _mm256_unpacklo_pd(r2, r3), t3 = _mm256_unpackhi_pd(r2, r3);
+            __m256d top[4], bottom[4];
+
+            col[0] = _mm256_permute2f128_pd(t0, t2, 0x20);
+            col[1] = _mm256_permute2f128_pd(t1, t3, 0x20);
+            col[2] = _mm256_permute2f128_pd(t0, t2, 0x31);
+            col[3] = _mm256_permute2f128_pd(t1, t3, 0x31);
+
+            for(int c = 0; c < 4; c++){
+                const __m256d swapped = _mm256_permute2f128_pd(col[c], col[c], 0x01);
+                top[c] = _mm256_permute_pd(swapped, 0x0);
+                bottom[c] = _mm256_permute_pd(swapped, 0xF);
+            }
+
+            // the same pairs of columns as the portable kernels: 01, 02, 03, 12, 13, 23
+            static const int pairs[6][2] = { {0, 1}, {0, 2}, {0, 3}, {1, 2}, {1, 3}, {2, 3} };
+
+            for(int p = 0; p < 6; p++){
+                const int a = pairs[p][0], b = pairs[p][1];
+                minor[p] = _mm256_sub_pd(_mm256_mul_pd(top[a], bottom[b]), _mm256_mul_pd(top[b], bottom[a]));
+            }
+        }
+
+        // The determinant of the minors in all the lanes.
+        static __m256d determinant(const __m256d minor[6])
+        {
+            __m256d det = _mm256_mul_pd(minor[0], _mm256_permute2f128_pd(minor[5], minor[5], 0x01));
+            det = _mm256_sub_pd(det, _mm256_mul_pd(minor[1], _mm256_permute2f128_pd(minor[4], minor[4], 0x01)));
+            det = _mm256_add_pd(det, _mm256_mul_pd(minor[2], _mm256_permute2f128_pd(minor[3], minor[3], 0x01)));
+
+            return _mm256_add_pd(det, _mm256_permute2f128_pd(det, det, 0x01));
+        }
+
+        // AVX versions for double, with the 2x2 minors of the portable determinant.
+        static double determinant(const double m[4][4])
+        {
+            // the rows 0 and 1 in the low lanes, the rows 2 and 3 in the high lanes
+            const __m256d l0 = _mm256_insertf128_pd(_mm256_castpd128_pd256(_mm_loadu_pd(m[0])), _mm_loadu_pd(m[2]), 1);
+            const __m256d l1 = _mm256_insertf128_pd(_mm256_castpd128_pd256(_mm_loadu_pd(m[1])), _mm_loadu_pd(m[3]), 1);
+            const __m256d h0 = _mm256_insertf128_pd(_mm256_castpd128_pd256(_mm_loadu_pd(m[0] + 2)), _mm_loadu_pd(m[2] + 2), 1);
+            const __m256d h1 = _mm256_insertf128_pd(_mm256_castpd128_pd256(_mm_loadu_pd(m[1] + 2)), _mm_loadu_pd(m[3] + 2), 1);
+
+            // s0 s5 | c0 c5, s1 s4 | c1 c4 and s2 s3 | c2 c3
+            const __m256d m05 = _mm256_hsub_pd(_mm256_mul_pd(l0, _mm256_permute_pd(l1, 0x5)), _mm256_mul_pd(h0, _mm256_permute_pd(h1, 0x5)));
+            const __m256d m14 = _mm256_sub_pd(_mm256_mul_pd(l0, h1), _mm256_mul_pd(l1, h0));
+            const __m256d m23 = _mm256_sub_pd(_mm256_mul_pd(l0, _mm256_permute_pd(h1, 0x5)), _mm256_mul_pd(l1, _mm256_permute_pd(h0, 0x5)));
+
+            // s0 c5 + s5 c0 - s1 c4 - s4 c1 + s2 c3 + s3 c2
+            const __m128d c05 = _mm256_extractf128_pd(m05, 1), c14 = _mm256_extractf128_pd(m14, 1), c23 = _mm256_extractf128_pd(m23, 1);
+            __m128d det = _mm_mul_pd(_mm256_castpd256_pd128(m05), _mm_shuffle_pd(c05, c05, 0x1));
+            det = _mm_sub_pd(det, _mm_mul_pd(_mm256_castpd256_pd128(m14), _mm_shuffle_pd(c14, c14, 0x1)));
+            det = _mm_add_pd(det, _mm_mul_pd(_mm256_castpd256_pd128(m23), _mm_shuffle_pd(c23, c23, 0x1)));
+
+            return _mm_cvtsd_f64(_mm_add_sd(det, _mm_unpackhi_pd(det, det)));
+        }
+
+        static void invert(double m[4][4])
+        {
+            __m256d col[4], minor[6];
+
+            loadMinors(m, col, minor);
+
+            // the columns with the rows swapped by pairs and every other sign flipped
+            const __m256d sign = _mm256_set_pd(-0.0, 0.0, -0.0, 0.0);
+            __m256d c[4];
+
+            for(int j = 0; j < 4; j++) c[j] = _mm256_xor_pd(_mm256_permute_pd(col[j], 0x5), sign);
+
+            const __m256d det = determinant(minor);
+            __m256d row;
+
+            row = _mm256_add_pd(_mm256_sub_pd(_mm256_mul_pd(c[1], minor[5]), _mm256_mul_pd(c[2], minor[4])), _mm256_mul_pd(c[3], minor[3]));
+            _mm256_storeu_pd(m[0], _mm256_div_pd(row, det));
+
+            row = _mm256_sub_pd(_mm256_sub_pd(_mm256_mul_pd(c[2], minor[2]), _mm256_mul_pd(c[0], minor[5])), _mm256_mul_pd(c[3], minor[1]));
+            _mm256_storeu_pd(m[1], _mm256_div_pd(row, det));
+
+            row = _mm256_add_pd(_mm256_sub_pd(_mm256_mul_pd(c[0], minor[4]), _mm256_mul_pd(c[1], minor[2])), _mm256_mul_pd(c[3], minor[0]));
+            _mm256_storeu_pd(m[2], _mm256_div_pd(row, det));
+
+            row = _mm256_sub_pd(_mm256_sub_pd(_mm256_mul_pd(c[1], minor[1]), _mm256_mul_pd(c[0], minor[3])), _mm256_mul_pd(c[2], minor[0]));
+            _mm256_storeu_pd(m[3], _mm256_div_pd(row, det));
+        }
+#endif
+#endif
+
+        // Transforms structure of arrays streams, as points or as directions.
+        template<typename T>
+        void transformStreams(const T * sx, const T * sy, const T * sz, T * dx, T * dy, T * dz, std::size_t n, bool points) const
+        {
+            const T m00 = m_data[0][0], m01 = m_data[0][1], m02 = m_data[0][2];
+            const T m10 = m_data[1][0], m11 = m_data[1][1], m12 = m_data[1][2];
+            const T m20 = m_data[2][0], m21 = m_data[2][1], m22 = m_data[2][2];
+
+            if(!points){
+                for(std::size_t i = 0; i < n; i++){
+                    const T x = sx[i], y = sy[i], z = sz[i];
+                    dx[i] = x*m00 + y*m10 + z*m20;
+                    dy[i] = x*m01 + y*m11 + z*m21;
+                    dz[i] = x*m02 + y*m12 + z*m22;
+                }
+                return;
+            }
+
+            const T m30 = m_data[3][0], m31 = m_data[3][1], m32 = m_data[3][2];
+
+            if(isAffine()){
+                for(std::size_t i = 0; i < n; i++){
+                    const T x = sx[i], y = sy[i], z = sz[i];
+                    dx[i] = x*m00 + y*m10 + z*m20 + m30;
+                    dy[i] = x*m01 + y*m11 + z*m21 + m31;
+                    dz[i] = x*m02 + y*m12 + z*m22 + m32;
+                }
+            }else{
+                const T m03 = m_data[0][3], m13 = m_data[1][3], m23 = m_data[2][3], m33 = m_data[3][3];
+
+                for(std::size_t i = 0; i < n; i++){
+                    const T x = sx[i], y = sy[i], z = sz[i];
+                    const T w = x*m03 + y*m13 + z*m23 + m33;
+                    dx[i] = (x*m00 + y*m10 + z*m20 + m30) / w;
+                    dy[i] = (x*m01 + y*m11 + z*m21 + m31) / w;
+                    dz[i] = (x*m02 + y*m12 + z*m22 + m32) / w;
+                }
+            }
+        }
+
+#ifdef GTL_SSE2
+        // SSE2 version for float, four points per iteration. The streams are aligned.
+        void transformStreams(const float * sx, const float * sy, const float * sz, float * dx, float * dy, float * dz, std::size_t n, bool points) const
+        {
+            const bool affine = !points || isAffine();
+            __m128 m[4][4];
+
+            for(int r = 0; r < 4; r++){
+                for(int c = 0; c < 4; c++) m[r][c] = _mm_set1_ps(m_data[r][c]);
+            }
+
+            std::size_t i = 0;
+
+            for(; i + 4 <= n; i += 4){
+                const __m128 x = _mm_load_ps(sx + i);
+                const __m128 y = _mm_load_ps(sy + i);
+                const __m128 z = _mm_load_ps(sz + i);
+
+                __m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m[0][0]), _mm_mul_ps(y, m[1][0])), _mm_mul_ps(z, m[2][0]));
+                __m128 ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m[0][1]), _mm_mul_ps(y, m[1][1])), _mm_mul_ps(z, m[2][1]));
+                __m128 rz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m[0][2]), _mm_mul_ps(y, m[1][2])), _mm_mul_ps(z, m[2][2]));
+
+                if(points){
+                    rx = _mm_add_ps(rx, m[3][0]);
+                    ry = _mm_add_ps(ry, m[3][1]);
+                    rz = _mm_add_ps(rz, m[3][2]);
+
+                    if(!affine){
+                        __m128 w = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m[0][3]), _mm_mul_ps(y, m[1][3])), _mm_add_ps(_mm_mul_ps(z, m[2][3]), m[3][3]));
+                        rx = _mm_div_ps(rx, w);
+                        ry = _mm_div_ps(ry, w);
+                        rz = _mm_div_ps(rz, w);
+                    }
+                }
+
+                _mm_store_ps(dx + i, rx);
+                _mm_store_ps(dy + i, ry);
+                _mm_store_ps(dz + i, rz);
+            }
+
+            // remaining points
+            if(i < n) transformStreams<float>(sx + i, sy + i, sz + i, dx + i, dy + i, dz + i, n - i, points);
+        }
+#endif
     };
 
     typedef Matrix4<int>    Matrix4i;
     typedef Matrix4<float>  Matrix4f;
     typedef Matrix4<double> Matrix4d;
+
+    GTL_ASSERT_PACKED(Matrix4f, float, 16);
+    GTL_ASSERT_PACKED(Matrix4d, double, 16);
 } // namespace gtl
 
 #endif
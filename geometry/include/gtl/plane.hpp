@@ -17,6 +17,8 @@ _______________________________________________________________________
 #include <gtl/vec3.hpp>
 #include <gtl/ray.hpp>
 #include <gtl/matrix4.hpp>
+#include <gtl/affine3.hpp>
+#include <gtl/transform.hpp>
 
 namespace gtl
 {
@@ -91,9 +93,6 @@ namespace gtl
             m_distance = -refpt.dot(m_normal) / (m_normal.length() * points.size());
         }
 
-        //! Default destructor does nothing.
-        virtual ~Plane(){}
-
         //! Set the Plane normal. \sa getNormal().
         void setNormal(const Vec3<Type> & a_normal)
         { 
@@ -112,13 +111,13 @@ namespace gtl
             m_distance = a_distance; 
         }
 
-        //! Set the plane equation. ( ax + by + cz + w = 0 )
+        //! Set the plane equation. ( ax + by + cz + w = 0 ) The equation is scaled so that the normal has unit length.
         void setValue(Type a, Type b, Type c, Type w)
         {
             m_normal.setValue(a,b,c);
-            m_normal.normalize();
+            Type length = m_normal.normalize();
 
-            m_distance = -w;
+            m_distance = length > (Type)0.0 ? -w / length : -w;
         }
 
         //! Return distance from coordinate system origin to the plane. \sa setDistance(Type a_distance).
@@ -142,21 +141,40 @@ namespace gtl
         //! Transform the plane by the given matrix.
         void transform(const Matrix4<Type> & a_matrix)
         {
-            // Find the point on the plane along the normal from the origin
-            Vec3<Type> point = m_distance * m_normal;
-
-            // Transform the plane normal by the matrix to get the new normal.
             // Use the inverse transpose of the matrix so that normals are not scaled incorrectly.
             Matrix4<Type> invTran = a_matrix.inverse().transpose();
-            invTran.multDirMatrix(m_normal, m_normal);
+
+            transform(a_matrix, invTran);
+        }
+
+        //! Transform the plane by the given transformation, which keeps its inverse transpose.
+        void transform(const Transform<Type> & a_transform)
+        {
+            transform(a_transform.getMatrix(), a_transform.getInverseTranspose());
+        }
+
+        //! Computes out[i] = planes[i] transformed by \a a_transform for the \a n planes, inverting it once. \a out may be the same array as \a planes.
+        static void transformMany(const Plane<Type> * planes, const Transform<Type> & a_transform, Plane<Type> * out, std::size_t n)
+        {
+            const Matrix4<Type> & matrix = a_transform.getMatrix();
+            const Matrix4<Type> & invTran = a_transform.getInverseTranspose();
+
+            for(std::size_t i = 0; i < n; i++){
+                out[i] = planes[i];
+                out[i].transform(matrix, invTran);
+            }
+        }
+
+        //! Transform the plane by the given affine transformation, without inverting a 4x4 matrix.
+        void transform(const Affine3<Type> & a_affine)
+        {
+            Vec3<Type> point = m_distance * m_normal;
+
+            a_affine.multNormal(m_normal, m_normal);
             m_normal.normalize();
 
-            // Transform the point by the matrix
-            a_matrix.multVecMatrix(point, point);
+            a_affine.multVecMatrix(point, point);
 
-            // The new distance is the projected distance of the vector to the
-            // transformed point onto the (unit) transformed normal. This is
-            // just a dot product.
             m_distance = point.dot(m_normal);
         }
 
@@ -279,11 +297,33 @@ namespace gtl
     private:
         Vec3<Type> m_normal;	//!< The normal to the plane
         Type m_distance;		//!< The distance from the origin
+
+        // Transform by a_matrix, whose inverse transpose is a_inverse_transpose.
+        void transform(const Matrix4<Type> & a_matrix, const Matrix4<Type> & a_inverse_transpose)
+        {
+            // Find the point on the plane along the normal from the origin
+            Vec3<Type> point = m_distance * m_normal;
+
+            // Transform the plane normal by the inverse transpose to get the new normal.
+            a_inverse_transpose.multDirMatrix(m_normal, m_normal);
+            m_normal.normalize();
+
+            // Transform the point by the matrix
+            a_matrix.multVecMatrix(point, point);
+
+            // The new distance is the projected distance of the vector to the
+            // transformed point onto the (unit) transformed normal. This is
+            // just a dot product.
+            m_distance = point.dot(m_normal);
+        }
     };
 
     typedef Plane<int>    Planei;
     typedef Plane<float>  Planef;
     typedef Plane<double> Planed;
+
+    GTL_ASSERT_PACKED(Planef, float, 4);
+    GTL_ASSERT_PACKED(Planed, double, 4);
 } // namespace gtl
 
 #endif
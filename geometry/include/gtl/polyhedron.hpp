@@ -17,6 +17,9 @@ _______________________________________________________________________
 #include <gtl/vec3.hpp>
 #include <gtl/ray.hpp>
 #include <gtl/matrix3.hpp>
+#include <gtl/bitgrid3.hpp>
+#include <vector>
+#include <algorithm>
 
 namespace gtl
 {
@@ -34,16 +37,12 @@ namespace gtl
         //! The default constructor makes a tetrahedron.
         Polyhedron()
         {
-			Vec3<Type> pts[4];
+			// constant initialized, i.e. read-only data, when the constructors of Vec3 are constexpr
+			static const Vec3<Type> pts[4] = { Vec3<Type>(-1, -1, 0), Vec3<Type>(1, -1, 0), Vec3<Type>(0, 1, 0), Vec3<Type>(0, 0, 1) };
 
 			m_vertices = NULL;
 			m_num_vertices = 0;
 
-			pts[0].setValue(-1, -1, 0);
-			pts[1].setValue(1, -1, 0);
-			pts[2].setValue(0, 1, 0);
-			pts[3].setValue(0, 0, 1);
-
 			setVertices(pts, 4);
         }
 
@@ -115,9 +114,9 @@ namespace gtl
 			q[3] = sin(angle / 2.0) * axis.z();
 
 			// And now the rotation matrix
-			Matrix3<Type> matrix(SQR(q[0]) + SQR(q[1]) - SQR(q[2]) - SQR(q[3]),		2 * (q[1] * q[2] - q[0] * q[3]),				2 * (q[1] * q[3] + q[0] * q[2]),
-								2 * (q[2] * q[1] + q[0] * q[3]),					SQR(q[0]) - SQR(q[1]) + SQR(q[2]) - SQR(q[3]),	2 * (q[2] * q[3] - q[0] * q[1]),
-								2 * (q[3] * q[1] - q[0] * q[2]),					2 * (q[3] * q[2] + q[0] * q[1]),				SQR(q[0]) - SQR(q[1]) - SQR(q[2]) + SQR(q[3]));
+			Matrix3<Type> matrix(sqr(q[0]) + sqr(q[1]) - sqr(q[2]) - sqr(q[3]),		2 * (q[1] * q[2] - q[0] * q[3]),				2 * (q[1] * q[3] + q[0] * q[2]),
+								2 * (q[2] * q[1] + q[0] * q[3]),					sqr(q[0]) - sqr(q[1]) + sqr(q[2]) - sqr(q[3]),	2 * (q[2] * q[3] - q[0] * q[1]),
+								2 * (q[3] * q[1] - q[0] * q[2]),					2 * (q[3] * q[2] + q[0] * q[1]),				sqr(q[0]) - sqr(q[1]) - sqr(q[2]) + sqr(q[3]));
 
 			// Perform the actual rotation on all vertices
 			for (int v = 0; v < m_num_vertices; v++)
@@ -130,9 +129,356 @@ namespace gtl
 			}
 		}
 
+		/*! Stream the voxels of size \a resolution whose center lies inside the convex hull of the vertices to \a sink.
+			The voxel (i,j,k) is centered at (i,j,k)*resolution. A center on a face is inside when the face looks
+			towards -x (or -y, then -z), so an axis aligned box [a, b) holds the centers from a up to before b,
+			as in the original sampling of RectPrism. The sink is called as sink(i, j, k0, k1)
+			for every run of voxels (i,j,k0) to (i,j,k1), ordered by i, then j. The rows are computed
+			in parallel, the sink is always called from the calling thread.
+		*/
+		template<typename Sink>
+		void voxelize(double resolution, Sink & sink) const
+		{
+			std::vector<Halfspace> halfspaces;
+			Vec3<int> imin, imax;
+
+			if (!getVoxelBounds(resolution, halfspaces, imin, imax))
+				return;
+
+			const int block = std::min(imax[0] - imin[0] + 1, (int)VOXEL_BLOCK);
+			std::vector< std::vector<int> > runs(block);
+
+			for (int first = imin[0]; first <= imax[0]; first += block)
+			{
+				const int count = std::min(block, imax[0] - first + 1);
+
+#ifdef _OPENMP
+				#pragma omp parallel for schedule(dynamic)
+#endif
+				for (int s = 0; s < count; s++)
+				{
+					int k0, k1;
+
+					runs[s].clear();
+					for (int j = imin[1]; j <= imax[1]; j++)
+					{
+						if (getRow(halfspaces, resolution, first + s, j, imin[2], imax[2], k0, k1))
+						{
+							runs[s].push_back(j);
+							runs[s].push_back(k0);
+							runs[s].push_back(k1);
+						}
+					}
+				}
+
+				for (int s = 0; s < count; s++)
+				{
+					for (std::size_t r = 0; r < runs[s].size(); r += 3)
+						sink(first + s, runs[s][r], runs[s][r + 1], runs[s][r + 2]);
+				}
+			}
+		}
+
+		//! Fill \a grid with the voxels of size \a resolution whose center lies inside the convex hull of the vertices, as voxelize() with a sink. The grid is resized to the bounds of the polyhedron.
+		void voxelize(double resolution, BitGrid3 & grid) const
+		{
+			std::vector<Halfspace> halfspaces;
+			Vec3<int> imin, imax;
+
+			if (!getVoxelBounds(resolution, halfspaces, imin, imax))
+			{
+				grid.resize(Vec3<int>(0, 0, 0), Vec3<int>(-1, -1, -1));
+				return;
+			}
+
+			grid.resize(imin, imax);
+
+			// every row of the grid has its own words, the slices can be written concurrently
+#ifdef _OPENMP
+			#pragma omp parallel for schedule(dynamic)
+#endif
+			for (int i = imin[0]; i <= imax[0]; i++)
+			{
+				int k0, k1;
+
+				for (int j = imin[1]; j <= imax[1]; j++)
+				{
+					if (getRow(halfspaces, resolution, i, j, imin[2], imax[2], k0, k1))
+						grid.setRun(i, j, k0, k1);
+				}
+			}
+		}
+
     protected:
         Vec3<Type> *m_vertices;
 		int			m_num_vertices;
+
+		enum { VOXEL_BLOCK = 64 };	// number of slices computed in parallel before being streamed
+
+		// The points p with normal.p <= distance.
+		struct Halfspace
+		{
+			Halfspace(const Vec3<double> & a_normal, double a_distance) : normal(a_normal), distance(a_distance) {}
+
+			Vec3<double> normal;
+			double distance;
+		};
+
+		// A triangle of the convex hull, counterclockwise seen from outside.
+		struct HullFace
+		{
+			int v[3];
+			Vec3<double> normal;
+			double distance;
+		};
+
+		HullFace makeHullFace(int a, int b, int c) const
+		{
+			HullFace face;
+
+			face.v[0] = a;
+			face.v[1] = b;
+			face.v[2] = c;
+			face.normal = (getCorner(b) - getCorner(a)).cross(getCorner(c) - getCorner(a));
+			face.normal.normalize();
+			face.distance = face.normal.dot(getCorner(a));
+
+			return face;
+		}
+
+		static bool lessHalfspace(const Halfspace & h1, const Halfspace & h2)
+		{
+			for (int c = 0; c < 3; c++)
+			{
+				if (h1.normal[c] != h2.normal[c])
+					return h1.normal[c] < h2.normal[c];
+			}
+			return h1.distance < h2.distance;
+		}
+
+		Vec3<double> getCorner(int index) const
+		{
+			const Vec3<Type> & v = m_vertices[index];
+
+			return Vec3<double>((double)v.x(), (double)v.y(), (double)v.z());
+		}
+
+		/*! Compute the faces of the convex hull of the vertices, with unit normals. Return false if the hull is flat.
+			The hull grows from a tetrahedron, each vertex outside replacing the faces it sees by a cone to their horizon.
+			This takes O(n f) for n vertices and f faces on the hull, O(n^2) at worst.
+		*/
+		virtual bool getHalfspaces(std::vector<Halfspace> & halfspaces) const
+		{
+			halfspaces.clear();
+
+			if (m_num_vertices < MIN_VERTICES)
+				return false;
+
+			const Vec3<double> origin = getCorner(0);
+			double extent = 0.0;
+
+			for (int v = 1; v < m_num_vertices; v++)
+				extent = std::max(extent, (getCorner(v) - origin).length());
+
+			const double tolerance = 1E-9 * extent;
+
+			// the first tetrahedron: the farthest vertex from the origin, from their line, and from their plane
+			int first[4] = { 0, 0, 0, 0 };
+			double farthest[3] = { 0.0, 0.0, 0.0 };
+			Vec3<double> axis, normal;
+
+			for (int v = 1; v < m_num_vertices; v++)
+			{
+				double d = (getCorner(v) - origin).length();
+
+				if (d > farthest[0]) { farthest[0] = d; first[1] = v; }
+			}
+
+			axis = (getCorner(first[1]) - origin) / std::max(farthest[0], tolerance);
+
+			for (int v = 1; v < m_num_vertices; v++)
+			{
+				Vec3<double> w = getCorner(v) - origin;
+				double d = (w - axis * w.dot(axis)).length();
+
+				if (d > farthest[1]) { farthest[1] = d; first[2] = v; }
+			}
+
+			normal = axis.cross(getCorner(first[2]) - origin);
+			normal.normalize();
+
+			for (int v = 1; v < m_num_vertices; v++)
+			{
+				double d = std::abs(normal.dot(getCorner(v) - origin));
+
+				if (d > farthest[2]) { farthest[2] = d; first[3] = v; }
+			}
+
+			if (farthest[0] <= tolerance || farthest[1] <= tolerance || farthest[2] <= tolerance)
+				return false;
+
+			// the faces are kept counterclockwise seen from outside
+			std::vector<HullFace> faces;
+			const Vec3<double> inside = (origin + getCorner(first[1]) + getCorner(first[2]) + getCorner(first[3])) * 0.25;
+
+			for (int f = 0; f < 4; f++)
+			{
+				HullFace face = makeHullFace(first[(f + 1) % 4], first[(f + 2) % 4], first[(f + 3) % 4]);
+
+				if (face.normal.dot(inside) > face.distance)
+					face = makeHullFace(face.v[0], face.v[2], face.v[1]);
+
+				faces.push_back(face);
+			}
+
+			std::vector<int> visible;
+			std::vector<int> horizon;
+
+			for (int p = 1; p < m_num_vertices; p++)
+			{
+				const Vec3<double> point = getCorner(p);
+
+				visible.clear();
+
+				for (std::size_t f = 0; f < faces.size(); f++)
+				{
+					if (faces[f].normal.dot(point) - faces[f].distance > tolerance)
+						visible.push_back((int)f);
+				}
+
+				if (visible.empty())
+					continue;
+
+				// the horizon is made of the edges of the visible faces whose other face is hidden
+				horizon.clear();
+
+				for (std::size_t f = 0; f < visible.size(); f++)
+				{
+					const int * v = faces[visible[f]].v;
+
+					for (int e = 0; e < 3; e++)
+					{
+						const int a = v[e], b = v[(e + 1) % 3];
+						bool shared = false;
+
+						for (std::size_t g = 0; g < visible.size() && !shared; g++)
+						{
+							const int * w = faces[visible[g]].v;
+
+							shared = (w[0] == b && w[1] == a) || (w[1] == b && w[2] == a) || (w[2] == b && w[0] == a);
+						}
+
+						if (!shared)
+						{
+							horizon.push_back(a);
+							horizon.push_back(b);
+						}
+					}
+				}
+
+				for (std::size_t f = visible.size(); f-- > 0; )
+				{
+					faces[visible[f]] = faces.back();
+					faces.pop_back();
+				}
+
+				for (std::size_t e = 0; e < horizon.size(); e += 2)
+					faces.push_back(makeHullFace(horizon[e], horizon[e + 1], p));
+			}
+
+			// the triangles of a polygonal face have the same plane and mostly sort next to each other, a duplicate left only costs time
+			for (std::size_t f = 0; f < faces.size(); f++)
+				halfspaces.push_back(Halfspace(faces[f].normal, faces[f].distance));
+
+			std::sort(halfspaces.begin(), halfspaces.end(), lessHalfspace);
+
+			std::size_t count = 0;
+
+			for (std::size_t h = 0; h < halfspaces.size(); h++)
+			{
+				if (count == 0 || halfspaces[count - 1].normal.dot(halfspaces[h].normal) <= 1.0 - 1E-9 ||
+					std::abs(halfspaces[count - 1].distance - halfspaces[h].distance) > tolerance)
+				{
+					halfspaces[count++] = halfspaces[h];
+				}
+			}
+
+			halfspaces.erase(halfspaces.begin() + count, halfspaces.end());
+
+			return halfspaces.size() >= 4;	// a closed hull has at least 4 faces
+		}
+
+		// Compute the halfspaces and the range of voxel indices covering the polyhedron.
+		bool getVoxelBounds(double resolution, std::vector<Halfspace> & halfspaces, Vec3<int> & imin, Vec3<int> & imax) const
+		{
+			if (resolution <= 0.0 || !getHalfspaces(halfspaces))
+				return false;
+
+			Vec3<double> bmin = getCorner(0), bmax = getCorner(0);
+
+			for (int v = 1; v < m_num_vertices; v++)
+			{
+				Vec3<double> p = getCorner(v);
+
+				for (int c = 0; c < 3; c++)
+				{
+					bmin[c] = std::min(bmin[c], p[c]);
+					bmax[c] = std::max(bmax[c], p[c]);
+				}
+			}
+
+			for (int c = 0; c < 3; c++)
+			{
+				imin[c] = (int)std::floor(bmin[c] / resolution);
+				imax[c] = (int)std::ceil(bmax[c] / resolution);
+			}
+
+			// the faces looking towards -x, -y or -z keep the centers lying on them, the others drop them
+			const double tolerance = 1E-9 * (bmax - bmin).length();
+
+			for (std::size_t h = 0; h < halfspaces.size(); h++)
+			{
+				const Vec3<double> & normal = halfspaces[h].normal;
+				int c = 0;
+
+				while (c < 2 && std::abs(normal[c]) <= 1E-9)
+					c++;
+
+				halfspaces[h].distance += normal[c] < 0.0 ? tolerance : -tolerance;
+			}
+
+			return true;
+		}
+
+		// Compute the run of voxels (i,j,k0) to (i,j,k1) inside all the halfspaces. Return false if the row is empty.
+		static bool getRow(const std::vector<Halfspace> & halfspaces, double resolution, int i, int j, int kmin, int kmax, int & k0, int & k1)
+		{
+			const double x = i * resolution;
+			const double y = j * resolution;
+			double zlo = kmin * resolution;
+			double zhi = kmax * resolution;
+
+			for (std::size_t h = 0; h < halfspaces.size(); h++)
+			{
+				const Vec3<double> & normal = halfspaces[h].normal;
+				const double rest = halfspaces[h].distance - normal[0] * x - normal[1] * y;
+
+				if (normal[2] > 0.0)
+					zhi = std::min(zhi, rest / normal[2]);
+				else if (normal[2] < 0.0)
+					zlo = std::max(zlo, rest / normal[2]);
+				else if (rest < 0.0)
+					return false;
+			}
+
+			if (zlo > zhi)
+				return false;
+
+			k0 = (int)std::ceil(zlo / resolution);
+			k1 = (int)std::floor(zhi / resolution);
+
+			return k0 <= k1;
+		}
     };
 
     typedef Polyhedron<int>    Polyhedroni;
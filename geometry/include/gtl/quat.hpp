@@ -39,9 +39,8 @@ namespace gtl
     {
     public:
         //! The default constructor just initializes a valid rotation.
-        Quat()
+        GTL_CONSTEXPR14 Quat() : m_data(0, 0, 0, 1)
         {
-            makeIdentity();
         }
 
         //! Construct a quaternion initialized with the given axis-of-rotation and rotation angle.
@@ -51,7 +50,7 @@ namespace gtl
         }
 
         //! Construct a quaternion initialized with the given quaternion components.
-        Quat(Type q0, Type q1, Type q2, Type q3)
+        GTL_CONSTEXPR14 Quat(Type q0, Type q1, Type q2, Type q3)
         {
             setValue(q0, q1, q2, q3);
         }
@@ -68,17 +67,14 @@ namespace gtl
             setValue(a_rotate_from, a_rotate_to);
         }
 
-        //! Default destructor does nothing.
-        virtual ~Quat(){}
-
         //! Set the quaternion to be the identity. \sa isIdentity().
-        void makeIdentity()
+        GTL_CONSTEXPR14 void makeIdentity()
         {
             setValue(0.0, 0.0, 0.0, 1.0);
         }
 
         //! Check if quaternion is identity. 
-        bool isIdentity() const
+        GTL_CONSTEXPR14 bool isIdentity() const
         {
             return ((m_data[0] == 0.0) && 
                     (m_data[1] == 0.0) && 
@@ -87,13 +83,13 @@ namespace gtl
         }
 
         //! Normalizes a rotation quaternion to unit 4D length. Return value is the original length of the vector before normalization.
-        Type normalize()
+        GTL_CONSTEXPR14 Type normalize()
         {
             return m_data.normalize();
         }
 
         //! Set the rotation.
-        void setValue(Type q0, Type q1, Type q2, Type q3)
+        GTL_CONSTEXPR14 void setValue(Type q0, Type q1, Type q2, Type q3)
         {
             m_data[0] = q0;
             m_data[1] = q1;
@@ -103,7 +99,7 @@ namespace gtl
         }
 
         //! Reset the rotation by the four quaternions in the array.
-        void setValue(const Type q[4])
+        GTL_CONSTEXPR14 void setValue(const Type q[4])
         {
             setValue(q[0], q[1], q[2], q[3]);
         }
@@ -273,7 +269,7 @@ namespace gtl
         }
 
         //! Return this rotation in the form of a matrix.
-        Matrix4<Type> getMatrix() const
+        GTL_CONSTEXPR14 Matrix4<Type> getMatrix() const
         {
             Matrix4<Type> matrix;
 
@@ -312,7 +308,7 @@ namespace gtl
         }
 
         //! Invert the rotation. Returns reference to self.
-        Quat<Type> & invert()
+        GTL_CONSTEXPR14 Quat<Type> & invert()
         {
             // Optimize by doing 1 div and 4 muls instead of 4 divs.
             Type inv = 1.0 / m_data.length();
@@ -326,7 +322,7 @@ namespace gtl
         }
 
         //! Non-destructively inverses the rotation and returns the result.
-        Quat<Type> inverse() const
+        GTL_CONSTEXPR14 Quat<Type> inverse() const
         {
             Quat<Type> quat(*this);
 
@@ -335,7 +331,7 @@ namespace gtl
 
 
         //! Multiplies the quaternions.
-        Quat<Type> & operator *= (const Quat<Type> & a_quat)
+        GTL_CONSTEXPR14 Quat<Type> & operator *= (const Quat<Type> & a_quat)
         {
             Type tx = m_data[0];
             Type ty = m_data[1];
@@ -356,7 +352,7 @@ namespace gtl
         }
 
         //! Multiplies components of quaternion with scalar value \a a_scale.
-        Quat<Type> & operator *= (Type a_scale)
+        GTL_CONSTEXPR14 Quat<Type> & operator *= (Type a_scale)
         {
             m_data *= a_scale;
 
@@ -364,7 +360,7 @@ namespace gtl
         }
 
         //! Check the two given quaternion for equality. 
-        friend bool operator==(const Quat<Type> & q1, const Quat<Type> & q2)
+        friend GTL_CONSTEXPR14 bool operator==(const Quat<Type> & q1, const Quat<Type> & q2)
         { 
             return ((q1.m_data[0] == q2.m_data[0])&&
                     (q1.m_data[1] == q2.m_data[1])&&
@@ -373,7 +369,7 @@ namespace gtl
         }
 
         //! Check the two given quaternion for inequality. 
-        friend bool operator!=(const Quat<Type> & q1, const Quat<Type> & q2)
+        friend GTL_CONSTEXPR14 bool operator!=(const Quat<Type> & q1, const Quat<Type> & q2)
         { 
             return !(q1 == q2);
         }
@@ -385,14 +381,14 @@ namespace gtl
         }
 
         //! Multiplies the two quaternions and returns the result.
-        friend Quat<Type> operator *(const Quat<Type> & q1, const Quat<Type> & q2)
+        friend GTL_CONSTEXPR14 Quat<Type> operator *(const Quat<Type> & q1, const Quat<Type> & q2)
         { 
             Quat<Type> q(q1); 
             q *= q2; 
             return q; 
         }		
 
-        friend Vec3<Type> operator *(const Quat<Type> & q1, const Vec3<Type> & v1)
+        friend GTL_CONSTEXPR14 Vec3<Type> operator *(const Quat<Type> & q1, const Vec3<Type> & v1)
         { 
             Vec3<Type> vec; 
             q1.multVec(v1, vec); 
@@ -400,7 +396,7 @@ namespace gtl
         }
 
         //! Rotate the \a src vector and put the result in \a dst.
-        void multVec(const Vec3<Type> & src, Vec3<Type> & dst) const
+        GTL_CONSTEXPR14 void multVec(const Vec3<Type> & src, Vec3<Type> & dst) const
         {
             Type QwQx = m_data[3] * m_data[0]; 
             Type QwQy = m_data[3] * m_data[1]; 
@@ -476,6 +472,9 @@ namespace gtl
 
     typedef Quat<float>  Quatf;
     typedef Quat<double> Quatd;
+
+    GTL_ASSERT_PACKED(Quatf, float, 4);
+    GTL_ASSERT_PACKED(Quatd, double, 4);
 } // namespace gtl
 
 #endif
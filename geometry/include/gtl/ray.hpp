@@ -33,22 +33,12 @@ namespace gtl
     class Ray
     {
     public:
-        //! Constructs an instance with initial values from \a a_ray.
-        Ray(const Ray<Type> & a_ray)
-        {
-            m_origin = a_ray.m_origin;
-            m_direction = a_ray.m_direction;
-        }
-
         //! Create a ray from a_origin with the direction a_direction. If \a normalize is true, \a a_direction will be normalized.
         Ray(const Vec3<Type> & a_origin, const Vec3<Type> & a_direction, bool normalize = true)
         {
             setValue(a_origin, a_direction, normalize);
         }
 
-        //! Default destructor does nothing.
-        virtual ~Ray(){}
-
         //! Set position and direction of the ray. If \a normalize is true, \a a_direction will be normalized.
         void setValue(const Vec3<Type> & a_origin, const Vec3<Type> & a_direction, bool normalize = true)
         {
@@ -142,7 +132,7 @@ namespace gtl
             Vec3<Type> qvec = tvec.cross(edge1);
 
             // calculate V parameter and test bounds
-            a_tuv[2] = m_origin.dot(qvec);
+            a_tuv[2] = m_direction.dot(qvec);
 
             if (a_tuv[2] < 0.0 || a_tuv[1] + a_tuv[2] > det)
                 return false;
@@ -228,6 +218,9 @@ namespace gtl
     typedef Ray<int>    Rayi;
     typedef Ray<float>  Rayf;
     typedef Ray<double> Rayd;
+
+    GTL_ASSERT_PACKED(Rayf, float, 6);
+    GTL_ASSERT_PACKED(Rayd, double, 6);
 } // namespace gtl
 
 #endif
@@ -0,0 +1,442 @@
+/*
+_______________________________________________________________________
+__________________________ G E O M E T R Y ____________________________
+|
+| THIS FILE IS PART OF THE GEOMETRY TEMPLATE LIBRARY.
+| USE, DISTRIBUTION AND REPRODUCTION OF THIS LIBRARY SOURCE IS
+| GOVERNED BY A BSD-STYLE SOURCE LICENSE.
+| PLEASE READ THESE TERMS BEFORE DISTRIBUTING.
+_______________________________________________________________________
+_______________________________________________________________________
+*/
+
+#ifndef RAYPACKET_H
+#define RAYPACKET_H
+
+#include <gtl/gtl.hpp>
+#include <gtl/vec3.hpp>
+#include <gtl/ray.hpp>
+#include <gtl/box3.hpp>
+#include <gtl/plane.hpp>
+#include <gtl/sphere.hpp>
+
+namespace gtl
+{
+    /*!
+    \class RayPacket RayPacket.hpp geometry/RayPacket.hpp
+    \brief Packet of N rays stored as structure of arrays.
+    \ingroup base
+
+    The origins, directions and inverse directions are kept coordinate by coordinate
+    so that the intersection tests run on all the rays at once without branches.
+    Every test returns a bit mask: bit i is set when the ray i is active and hits.
+    The float tests use SSE2 when available. N must be between 1 and 32.
+
+    \sa Ray
+    */
+    template<typename Type, int N>
+    class RayPacket
+    {
+    public:
+        enum { SIZE = N };
+
+        //! The default constructor makes a packet without active rays.
+        RayPacket() : m_mask(0)
+        {
+            for(int c = 0; c < 3; c++){
+                for(int i = 0; i < N; i++){
+                    m_origin[c][i] = m_direction[c][i] = m_invdir[c][i] = (Type)0;
+                }
+            }
+        }
+
+        //! Constructs a packet from the \a N rays of \a a_rays, all active.
+        RayPacket(const Ray<Type> * a_rays) : m_mask(0)
+        {
+            setValues(a_rays);
+        }
+
+        //! Set the ray of the lane \a i and make it active.
+        void setValue(int i, const Ray<Type> & a_ray)
+        {
+            const Vec3<Type> & origin = a_ray.getOrigin();
+            const Vec3<Type> & direction = a_ray.getDirection();
+
+            for(int c = 0; c < 3; c++){
+                m_origin[c][i] = origin[c];
+                m_direction[c][i] = direction[c];
+                m_invdir[c][i] = (Type)1 / direction[c];
+            }
+            m_mask |= 1u << i;
+        }
+
+        //! Set the \a N rays of the packet from \a a_rays and make them all active.
+        void setValues(const Ray<Type> * a_rays)
+        {
+            for(int i = 0; i < N; i++) setValue(i, a_rays[i]);
+        }
+
+        //! Return the ray of the lane \a i.
+        Ray<Type> getValue(int i) const
+        {
+            return Ray<Type>(getOrigin(i), getDirection(i), false);
+        }
+
+        //! Return the origin of the ray of the lane \a i.
+        Vec3<Type> getOrigin(int i) const
+        {
+            return Vec3<Type>(m_origin[0][i], m_origin[1][i], m_origin[2][i]);
+        }
+
+        //! Return the direction of the ray of the lane \a i.
+        Vec3<Type> getDirection(int i) const
+        {
+            return Vec3<Type>(m_direction[0][i], m_direction[1][i], m_direction[2][i]);
+        }
+
+        //! Return the mask of the active rays. \sa setMask().
+        unsigned int getMask() const
+        {
+            return m_mask;
+        }
+
+        //! Set the mask of the active rays, the inactive rays never hit anything. \sa getMask().
+        void setMask(unsigned int a_mask)
+        {
+            m_mask = a_mask & fullMask();
+        }
+
+        /*! Slab test of the rays against \a a_box.
+        \a a_tmin and \a a_tmax receive the entry and exit distances of every ray.
+        A ray hits when the box is in front of it or when it starts inside the box.
+        */
+        unsigned int intersect(const Box3<Type> & a_box, Type a_tmin[N], Type a_tmax[N]) const
+        {
+            if(a_box.isEmpty()) return 0;
+
+            return m_mask & slabs(m_origin[0], m_origin[1], m_origin[2], m_invdir[0], m_invdir[1], m_invdir[2],
+                                  a_box.getMin(), a_box.getMax(), (const Type *)NULL, a_tmin, a_tmax, N);
+        }
+
+        //! Return the rays which hit \a a_box between 0 and their own \a a_tfar distance.
+        unsigned int intersect(const Box3<Type> & a_box, const Type a_tfar[N]) const
+        {
+            if(a_box.isEmpty()) return 0;
+
+            Type tmin[N], tmax[N];
+
+            return m_mask & slabs(m_origin[0], m_origin[1], m_origin[2], m_invdir[0], m_invdir[1], m_invdir[2],
+                                  a_box.getMin(), a_box.getMax(), a_tfar, tmin, tmax, N);
+        }
+
+        /*! Intersect the rays with the triangle defined by vert0,vert1,vert2, as Ray::intersect() does.
+        For every ray which hits, \a a_t is the distance to the plane of the triangle and (\a a_u,\a a_v)
+        the coordinates inside the triangle.
+        */
+        unsigned int intersect(const Vec3<Type> & vert0, const Vec3<Type> & vert1, const Vec3<Type> & vert2,
+                               Type a_t[N], Type a_u[N], Type a_v[N]) const
+        {
+            return m_mask & triangles(m_origin[0], m_origin[1], m_origin[2], m_direction[0], m_direction[1], m_direction[2],
+                                      vert0, vert1, vert2, a_t, a_u, a_v, N);
+        }
+
+        //! Intersect the rays with \a a_plane, as Plane::intersect() does. \a a_t is the distance from the ray origin to the plane.
+        unsigned int intersect(const Plane<Type> & a_plane, Type a_t[N]) const
+        {
+            return m_mask & planes(m_origin[0], m_origin[1], m_origin[2], m_direction[0], m_direction[1], m_direction[2],
+                                   a_plane.getNormal(), a_plane.getDistanceFromOrigin(), a_t, N);
+        }
+
+        /*! Intersect the rays with \a a_sphere, as Sphere::intersect() does.
+        A ray hits when the sphere is in front of it, \a a_t0 and \a a_t1 are then the entry and exit distances.
+        */
+        unsigned int intersect(const Sphere<Type> & a_sphere, Type a_t0[N], Type a_t1[N]) const
+        {
+            return m_mask & spheres(m_origin[0], m_origin[1], m_origin[2], m_direction[0], m_direction[1], m_direction[2],
+                                    a_sphere.getCenter(), a_sphere.getRadius(), a_t0, a_t1, N);
+        }
+
+    private:
+        typedef char SizeCheck[(N > 0 && N <= 32) ? 1 : -1];
+
+        Type m_origin[3][N];
+        Type m_direction[3][N];
+        Type m_invdir[3][N];
+        unsigned int m_mask;
+
+        static unsigned int fullMask()
+        {
+            return (N == 32 ? 0u : 1u << (N & 31)) - 1u;
+        }
+
+        // The lane kernels below return the bit mask of the n lanes which hit.
+
+        template<typename T>
+        static unsigned int slabs(const T * ox, const T * oy, const T * oz, const T * ix, const T * iy, const T * iz,
+                                  const Vec3<T> & bmin, const Vec3<T> & bmax, const T * tfar, T * tmin, T * tmax, int n)
+        {
+            const T * o[3] = { ox, oy, oz };
+            const T * inv[3] = { ix, iy, iz };
+            unsigned int mask = 0;
+
+            for(int i = 0; i < n; i++){
+                T lo = -std::numeric_limits<T>::max();
+                T hi = std::numeric_limits<T>::max();
+
+                for(int c = 0; c < 3; c++){
+                    const T t0 = (bmin[c] - o[c][i]) * inv[c][i];
+                    const T t1 = (bmax[c] - o[c][i]) * inv[c][i];
+                    const T enter = t0 < t1 ? t0 : t1;
+                    const T leave = t0 < t1 ? t1 : t0;
+                    lo = enter > lo ? enter : lo;
+                    hi = leave < hi ? leave : hi;
+                }
+
+                tmin[i] = lo;
+                tmax[i] = hi;
+
+                const T start = lo > (T)0 ? lo : (T)0;
+                const T end = tfar && tfar[i] < hi ? tfar[i] : hi;
+
+                mask |= (unsigned int)(start <= end) << i;
+            }
+            return mask;
+        }
+
+        template<typename T>
+        static unsigned int triangles(const T * ox, const T * oy, const T * oz, const T * dx, const T * dy, const T * dz,
+                                      const Vec3<T> & vert0, const Vec3<T> & vert1, const Vec3<T> & vert2,
+                                      T * a_t, T * a_u, T * a_v, int n)
+        {
+            const Vec3<T> edge1 = vert1 - vert0;
+            const Vec3<T> edge2 = vert2 - vert0;
+            unsigned int mask = 0;
+
+            for(int i = 0; i < n; i++){
+                // Moller and Trumbore, see Ray::intersect()
+                const Vec3<T> dir(dx[i], dy[i], dz[i]);
+                const Vec3<T> pvec = dir.cross(edge2);
+                const T det = edge1.dot(pvec);
+                const Vec3<T> tvec = Vec3<T>(ox[i], oy[i], oz[i]) - vert0;
+                const Vec3<T> qvec = tvec.cross(edge1);
+                const T u = tvec.dot(pvec);
+                const T v = dir.dot(qvec);
+                const T inv_det = (T)1 / det;
+
+                a_t[i] = edge2.dot(qvec) * inv_det;
+                a_u[i] = u * inv_det;
+                a_v[i] = v * inv_det;
+
+                mask |= (unsigned int)(det >= EPS && u >= (T)0 && u <= det && v >= (T)0 && u + v <= det) << i;
+            }
+            return mask;
+        }
+
+        template<typename T>
+        static unsigned int planes(const T * ox, const T * oy, const T * oz, const T * dx, const T * dy, const T * dz,
+                                   const Vec3<T> & normal, T distance, T * a_t, int n)
+        {
+            unsigned int mask = 0;
+
+            for(int i = 0; i < n; i++){
+                const T denom = normal[0] * dx[i] + normal[1] * dy[i] + normal[2] * dz[i];
+
+                a_t[i] = (distance - (normal[0] * ox[i] + normal[1] * oy[i] + normal[2] * oz[i])) / denom;
+
+                mask |= (unsigned int)(denom != (T)0) << i;
+            }
+            return mask;
+        }
+
+        template<typename T>
+        static unsigned int spheres(const T * ox, const T * oy, const T * oz, const T * dx, const T * dy, const T * dz,
+                                    const Vec3<T> & center, T radius, T * a_t0, T * a_t1, int n)
+        {
+            unsigned int mask = 0;
+
+            for(int i = 0; i < n; i++){
+                const T x = ox[i] - center[0], y = oy[i] - center[1], z = oz[i] - center[2];
+                const T a = dx[i] * dx[i] + dy[i] * dy[i] + dz[i] * dz[i];
+                const T b = (T)2 * (x * dx[i] + y * dy[i] + z * dz[i]);
+                const T c = x * x + y * y + z * z - radius * radius;
+                const T disc = b * b - (T)4 * a * c;
+                const T root = std::sqrt(disc > (T)0 ? disc : (T)0);
+                const T inv = (T)1 / ((T)2 * a);
+
+                a_t0[i] = (-b - root) * inv;
+                a_t1[i] = (-b + root) * inv;
+
+                // both roots must be in front of the origin
+                mask |= (unsigned int)(disc >= (T)0 && a_t0[i] > (T)0) << i;
+            }
+            return mask;
+        }
+
+#ifdef GTL_SSE2
+        // SSE2 versions for float, four lanes per iteration. The lanes are not aligned.
+        static unsigned int slabs(const float * ox, const float * oy, const float * oz, const float * ix, const float * iy, const float * iz,
+                                  const Vec3<float> & bmin, const Vec3<float> & bmax, const float * tfar, float * tmin, float * tmax, int n)
+        {
+            const float * o[3] = { ox, oy, oz };
+            const float * inv[3] = { ix, iy, iz };
+            const __m128 zero = _mm_setzero_ps();
+            unsigned int mask = 0;
+            int i = 0;
+
+            for(; i + 4 <= n; i += 4){
+                __m128 lo = _mm_set1_ps(-std::numeric_limits<float>::max());
+                __m128 hi = _mm_set1_ps(std::numeric_limits<float>::max());
+
+                for(int c = 0; c < 3; c++){
+                    const __m128 org = _mm_loadu_ps(o[c] + i);
+                    const __m128 rcp = _mm_loadu_ps(inv[c] + i);
+                    const __m128 t0 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(bmin[c]), org), rcp);
+                    const __m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(bmax[c]), org), rcp);
+                    lo = _mm_max_ps(_mm_min_ps(t0, t1), lo);
+                    hi = _mm_min_ps(_mm_max_ps(t1, t0), hi);
+                }
+
+                _mm_storeu_ps(tmin + i, lo);
+                _mm_storeu_ps(tmax + i, hi);
+
+                const __m128 end = tfar ? _mm_min_ps(_mm_loadu_ps(tfar + i), hi) : hi;
+
+                mask |= (unsigned int)_mm_movemask_ps(_mm_cmple_ps(_mm_max_ps(lo, zero), end)) << i;
+            }
+
+            // remaining lanes
+            if(i < n) mask |= slabs<float>(ox + i, oy + i, oz + i, ix + i, iy + i, iz + i, bmin, bmax, tfar ? tfar + i : NULL, tmin + i, tmax + i, n - i) << i;
+
+            return mask;
+        }
+
+        static unsigned int triangles(const float * ox, const float * oy, const float * oz, const float * dx, const float * dy, const float * dz,
+                                      const Vec3<float> & vert0, const Vec3<float> & vert1, const Vec3<float> & vert2,
+                                      float * a_t, float * a_u, float * a_v, int n)
+        {
+            const Vec3<float> edge1 = vert1 - vert0;
+            const Vec3<float> edge2 = vert2 - vert0;
+            const __m128 e1x = _mm_set1_ps(edge1[0]), e1y = _mm_set1_ps(edge1[1]), e1z = _mm_set1_ps(edge1[2]);
+            const __m128 e2x = _mm_set1_ps(edge2[0]), e2y = _mm_set1_ps(edge2[1]), e2z = _mm_set1_ps(edge2[2]);
+            const __m128 v0x = _mm_set1_ps(vert0[0]), v0y = _mm_set1_ps(vert0[1]), v0z = _mm_set1_ps(vert0[2]);
+            const __m128 eps = _mm_set1_ps(std::numeric_limits<float>::epsilon());
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 one = _mm_set1_ps(1.0f);
+            unsigned int mask = 0;
+            int i = 0;
+
+            for(; i + 4 <= n; i += 4){
+                const __m128 x = _mm_loadu_ps(dx + i), y = _mm_loadu_ps(dy + i), z = _mm_loadu_ps(dz + i);
+
+                // pvec = dir x edge2
+                const __m128 px = _mm_sub_ps(_mm_mul_ps(y, e2z), _mm_mul_ps(z, e2y));
+                const __m128 py = _mm_sub_ps(_mm_mul_ps(z, e2x), _mm_mul_ps(x, e2z));
+                const __m128 pz = _mm_sub_ps(_mm_mul_ps(x, e2y), _mm_mul_ps(y, e2x));
+                const __m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+
+                // tvec = origin - vert0, qvec = tvec x edge1
+                const __m128 tx = _mm_sub_ps(_mm_loadu_ps(ox + i), v0x);
+                const __m128 ty = _mm_sub_ps(_mm_loadu_ps(oy + i), v0y);
+                const __m128 tz = _mm_sub_ps(_mm_loadu_ps(oz + i), v0z);
+                const __m128 qx = _mm_sub_ps(_mm_mul_ps(ty, e1z), _mm_mul_ps(tz, e1y));
+                const __m128 qy = _mm_sub_ps(_mm_mul_ps(tz, e1x), _mm_mul_ps(tx, e1z));
+                const __m128 qz = _mm_sub_ps(_mm_mul_ps(tx, e1y), _mm_mul_ps(ty, e1x));
+
+                const __m128 u = _mm_add_ps(_mm_add_ps(_mm_mul_ps(tx, px), _mm_mul_ps(ty, py)), _mm_mul_ps(tz, pz));
+                const __m128 v = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, qx), _mm_mul_ps(y, qy)), _mm_mul_ps(z, qz));
+                const __m128 t = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz));
+                const __m128 inv_det = _mm_div_ps(one, det);
+
+                _mm_storeu_ps(a_t + i, _mm_mul_ps(t, inv_det));
+                _mm_storeu_ps(a_u + i, _mm_mul_ps(u, inv_det));
+                _mm_storeu_ps(a_v + i, _mm_mul_ps(v, inv_det));
+
+                __m128 hit = _mm_cmpge_ps(det, eps);
+                hit = _mm_and_ps(hit, _mm_cmpge_ps(u, zero));
+                hit = _mm_and_ps(hit, _mm_cmple_ps(u, det));
+                hit = _mm_and_ps(hit, _mm_cmpge_ps(v, zero));
+                hit = _mm_and_ps(hit, _mm_cmple_ps(_mm_add_ps(u, v), det));
+
+                mask |= (unsigned int)_mm_movemask_ps(hit) << i;
+            }
+
+            // remaining lanes
+            if(i < n) mask |= triangles<float>(ox + i, oy + i, oz + i, dx + i, dy + i, dz + i, vert0, vert1, vert2, a_t + i, a_u + i, a_v + i, n - i) << i;
+
+            return mask;
+        }
+
+        static unsigned int planes(const float * ox, const float * oy, const float * oz, const float * dx, const float * dy, const float * dz,
+                                   const Vec3<float> & normal, float distance, float * a_t, int n)
+        {
+            const __m128 nx = _mm_set1_ps(normal[0]), ny = _mm_set1_ps(normal[1]), nz = _mm_set1_ps(normal[2]);
+            const __m128 dist = _mm_set1_ps(distance);
+            const __m128 zero = _mm_setzero_ps();
+            unsigned int mask = 0;
+            int i = 0;
+
+            for(; i + 4 <= n; i += 4){
+                const __m128 denom = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, _mm_loadu_ps(dx + i)), _mm_mul_ps(ny, _mm_loadu_ps(dy + i))),
+                                                _mm_mul_ps(nz, _mm_loadu_ps(dz + i)));
+                const __m128 num = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, _mm_loadu_ps(ox + i)), _mm_mul_ps(ny, _mm_loadu_ps(oy + i))),
+                                              _mm_mul_ps(nz, _mm_loadu_ps(oz + i)));
+
+                _mm_storeu_ps(a_t + i, _mm_div_ps(_mm_sub_ps(dist, num), denom));
+
+                mask |= (unsigned int)_mm_movemask_ps(_mm_cmpneq_ps(denom, zero)) << i;
+            }
+
+            // remaining lanes
+            if(i < n) mask |= planes<float>(ox + i, oy + i, oz + i, dx + i, dy + i, dz + i, normal, distance, a_t + i, n - i) << i;
+
+            return mask;
+        }
+
+        static unsigned int spheres(const float * ox, const float * oy, const float * oz, const float * dx, const float * dy, const float * dz,
+                                    const Vec3<float> & center, float radius, float * a_t0, float * a_t1, int n)
+        {
+            const __m128 cx = _mm_set1_ps(center[0]), cy = _mm_set1_ps(center[1]), cz = _mm_set1_ps(center[2]);
+            const __m128 r2 = _mm_set1_ps(radius * radius);
+            const __m128 two = _mm_set1_ps(2.0f), four = _mm_set1_ps(4.0f), one = _mm_set1_ps(1.0f);
+            const __m128 zero = _mm_setzero_ps();
+            unsigned int mask = 0;
+            int i = 0;
+
+            for(; i + 4 <= n; i += 4){
+                const __m128 x = _mm_sub_ps(_mm_loadu_ps(ox + i), cx);
+                const __m128 y = _mm_sub_ps(_mm_loadu_ps(oy + i), cy);
+                const __m128 z = _mm_sub_ps(_mm_loadu_ps(oz + i), cz);
+                const __m128 ddx = _mm_loadu_ps(dx + i), ddy = _mm_loadu_ps(dy + i), ddz = _mm_loadu_ps(dz + i);
+
+                const __m128 a = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ddx, ddx), _mm_mul_ps(ddy, ddy)), _mm_mul_ps(ddz, ddz));
+                const __m128 b = _mm_mul_ps(two, _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, ddx), _mm_mul_ps(y, ddy)), _mm_mul_ps(z, ddz)));
+                const __m128 c = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)), r2);
+                const __m128 disc = _mm_sub_ps(_mm_mul_ps(b, b), _mm_mul_ps(four, _mm_mul_ps(a, c)));
+                const __m128 root = _mm_sqrt_ps(_mm_max_ps(disc, zero));
+                const __m128 inv = _mm_div_ps(one, _mm_mul_ps(two, a));
+                const __m128 t0 = _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(zero, b), root), inv);
+                const __m128 t1 = _mm_mul_ps(_mm_add_ps(_mm_sub_ps(zero, b), root), inv);
+
+                _mm_storeu_ps(a_t0 + i, t0);
+                _mm_storeu_ps(a_t1 + i, t1);
+
+                mask |= (unsigned int)_mm_movemask_ps(_mm_and_ps(_mm_cmpge_ps(disc, zero), _mm_cmpgt_ps(t0, zero))) << i;
+            }
+
+            // remaining lanes
+            if(i < n) mask |= spheres<float>(ox + i, oy + i, oz + i, dx + i, dy + i, dz + i, center, radius, a_t0 + i, a_t1 + i, n - i) << i;
+
+            return mask;
+        }
+#endif
+    };
+
+    typedef RayPacket<float, 4>   RayPacket4f;
+    typedef RayPacket<float, 8>   RayPacket8f;
+    typedef RayPacket<float, 16>  RayPacket16f;
+    typedef RayPacket<double, 4>  RayPacket4d;
+    typedef RayPacket<double, 8>  RayPacket8d;
+    typedef RayPacket<double, 16> RayPacket16d;
+} // namespace gtl
+
+#endif
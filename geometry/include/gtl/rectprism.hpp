@@ -18,7 +18,9 @@ _______________________________________________________________________
 #include <gtl/ray.hpp>
 #include <gtl/polyhedron.hpp>
 #include <gtl/matrix3.hpp>
+#include <gtl/voxelgrid.hpp>
 #include <vector>
+#include <cfloat>
 
 namespace gtl
 {
@@ -35,52 +37,22 @@ namespace gtl
         //! The default constructor makes a cube.
         RectPrism()
         {
-			Vec3<Type> pts[8];
-
-			if (m_vertices != NULL)
-			{
-				delete [] m_vertices;
-			}
-			m_vertices = NULL;
-			m_num_vertices = 0;
-
-			pts[0].setValue((Type)0.0, (Type)0.0, (Type)0.0);
-			pts[1].setValue((Type)1.0, (Type)0.0, (Type)0.0);
-			pts[2].setValue((Type)1.0, (Type)1.0, (Type)0.0);
-			pts[3].setValue((Type)0.0, (Type)1.0, (Type)0.0);
-			pts[4].setValue((Type)0.0, (Type)0.0, (Type)1.0);
-			pts[5].setValue((Type)1.0, (Type)0.0, (Type)1.0);
-			pts[6].setValue((Type)1.0, (Type)1.0, (Type)1.0);
-			pts[7].setValue((Type)0.0, (Type)1.0, (Type)1.0);
-
-			setVertices(pts);
-
-			m_fill_init = 0;
-			m_resolution = 1.0;
-			m_num_fill_points = 1;
-			
-			m_i_dim = 1.0;
-			m_j_dim = 1.0;
-			m_k_dim = 1.0;
-
-			m_ray_i = NULL;
-			m_ray_j = NULL;
-			m_ray_k = NULL;
+			setUnitCube();
+			initFill();
         }
 
         //!	Constructs a polyhedron from the provided list of 3D points.
         RectPrism(Vec3<Type> *pts)
         {
-			m_vertices = NULL;
-			m_num_vertices = 0;
-
             if (setVertices(pts) < 0)
-				RectPrism();	// if setVertices fails, construct default polyhedron...
+				setUnitCube();	// if setVertices fails, construct default polyhedron...
+
+			initFill();
         }
 
-		int setVertices(Vec3<Type> *pts)
+		int setVertices(const Vec3<Type> *pts)
 		{
-			return Polyhedron::setVertices(pts, 8);
+			return Polyhedron<Type>::setVertices(pts, 8);
 		}
 
 		int getNumFillPoints()
@@ -94,87 +66,18 @@ namespace gtl
 		// this method must be called before calling any of the other fill methods
 		void prepareFill(double resolution)
 		{
-			// 1. Start with arbitrary point (m_vertices[0])
-			// 2. Find its 3 linearly independent link points (the 2 closest points are alway part of
-			// the list of 3 linearly independent connected points, and the 3rd one is obtained from
-			// the cross product of the 2 produced vectors)
-			Vec3<Type> link_points[3];
-			double min_dist[2];
-			Vec3<Type> link_vectors[3];
-			int min_index[2] = {0};	// index of the vertex that is the first closest one to vertex 0
-
-			for (int i = 0; i < 2; i++)
-			{
-				min_dist[i] = DBL_MAX;
-				for (int j = 1; j < 8; j++)
-				{
-					if (j != min_index[0])
-					{
-						Vec3<Type> vec;
-
-						vec = m_vertices[j] - m_vertices[0];
-
-						if (vec.length() < min_dist[i])
-						{
-							link_vectors[i] = vec;
-							min_dist[i] = vec.length();
-							min_index[i] = j;
-							link_points[i] = m_vertices[j];
-						}
-					}
-				}
-			}
-
-			// preliminary link_vectors[2]... can point in the opposite direction.
-			link_vectors[2] = link_vectors[0].cross(link_vectors[1]);
-
-			// Establish 3 linearly independent rays from these points
-			m_ray_i = new Ray<Type>(m_vertices[0], link_vectors[0]);
-			m_ray_j = new Ray<Type>(m_vertices[0], link_vectors[1]);
-			m_ray_k = new Ray<Type>(m_vertices[0], link_vectors[2]);
-
-			// find link_points[2] (so that we can establish k_dim)
-			Vec3<Type> closest_vertex;
-			double min_ray_dist = DBL_MAX;
-
-			for (int i = 1; i < 8; i++)
-			{
-				if (m_vertices[i] == link_points[0])
-					continue;
-
-				if (m_vertices[i] == link_points[1])
-					continue;
-
-				// NOTE: Ray::getDistance works in such a way that whether it doesn't matter if
-				// the cross-product vector link_vectors[2] is currently pointing in the wrong direction
-				double dist = m_ray_k->getDistance(m_vertices[i]);
-
-				if (dist < min_ray_dist)
-				{
-					min_ray_dist = dist;
-					closest_vertex = m_vertices[i];
-				}
-			}
-
-			link_points[2] = closest_vertex;
-			
-			// now make sure the link_vectors[2] vector points in the right direction for our ray_k, because voxelize() will
-			// depend on that direction being the right one...
-			Vec3<Type> vec;
-			vec = link_points[2] - m_vertices[0];
-			link_vectors[2] = vec;
-			
-			m_ray_k->setValue(m_ray_k->getOrigin(), link_vectors[2]);
-
-			// Establish width, height and length, for index calculation
-			m_i_dim = (link_points[0] - m_vertices[0]).length();
-			m_j_dim = (link_points[1] - m_vertices[0]).length();
-			m_k_dim = (link_points[2] - m_vertices[0]).length();
-
 			m_resolution = resolution;
 			m_fill_init = 1;
+			m_fill_grid_init = 0;
 
-			voxelize();
+			// the voxels come out sorted and unique, no need to sort them afterwards
+			FillSink sink(m_fill_points);
+
+			m_fill_points.clear();
+			m_fill_grid = VoxelGrid<Type>((Type)resolution);	// releases the grid of the previous fill
+			this->voxelize(resolution, sink);
+
+			m_num_fill_points = (int)m_fill_points.size();
 		}
 
 		int getFillPoint(int index, Vec3<Type> &pt)
@@ -184,7 +87,7 @@ namespace gtl
 
 			if (index < 0 || index >= m_num_fill_points)
 			{
-				pt.setValue(0.0, 0.0, 0.0);
+				pt.setValue(0, 0, 0);
 				return -1;
 			} else {
 				pt = m_fill_points[index];
@@ -192,115 +95,159 @@ namespace gtl
 			}
 		}
 
+		//! Return the grid of the fill points, with the resolution given to prepareFill(). The grid is built from the fill points on the first call.
+		const VoxelGrid<Type> & getFillGrid()
+		{
+			if (m_fill_init == 0)
+				prepareFill(1.0);
+
+			if (m_fill_grid_init == 0)
+			{
+				// the points are sorted, the runs along k are consecutive
+				for (std::size_t first = 0, last = 0; first < m_fill_points.size(); first = last)
+				{
+					const Vec3<Type> & p = m_fill_points[first];
+
+					for (last = first + 1; last < m_fill_points.size(); last++)
+					{
+						const Vec3<Type> & q = m_fill_points[last];
+
+						if (q[0] != p[0] || q[1] != p[1] || q[2] != p[2] + (Type)(last - first))
+							break;
+					}
+
+					m_fill_grid.setRun((int)p[0], (int)p[1], (int)p[2], (int)p[2] + (int)(last - first) - 1);
+				}
+
+				m_fill_grid_init = 1;
+			}
+
+			return m_fill_grid;
+		}
+
 	private:
 		int m_fill_init;
 		double m_resolution;
-		
-		// 3 linearly independent rays meeting at an arbitrarily chosen corner
-		Ray<Type> *m_ray_i;
-		Ray<Type> *m_ray_j;
-		Ray<Type> *m_ray_k;
-
-		// Width, height and length
-		double m_i_dim;
-		double m_j_dim;
-		double m_k_dim;
 
 		std::vector< Vec3<Type> > m_fill_points;
 		int m_num_fill_points;
+		int m_fill_grid_init;
+		VoxelGrid<Type> m_fill_grid;
+
+		typedef typename Polyhedron<Type>::Halfspace Halfspace;
 
-		// generates the actual discrete fill points in m_fill_points
-		void voxelize()
+		// Appends the voxels to the list of fill points.
+		struct FillSink
 		{
-			// traverse the linearly independent rays (local coordinate system) three-dimensionally
-			for (double i = 0.0; round_to(i, m_resolution) < m_i_dim; i+=(m_resolution / 2.0))
+			FillSink(std::vector< Vec3<Type> > & a_points) : points(a_points) {}
+
+			void operator()(int i, int j, int k0, int k1)
 			{
-				Vec3<Type> ray_j_offset = m_ray_i->getValue(i);
+				for (int k = k0; k <= k1; k++)
+					points.push_back(Vec3<Type>((Type)i, (Type)j, (Type)k));
+			}
 
-				m_ray_j->setValue(ray_j_offset, m_ray_j->getDirection());
+			std::vector< Vec3<Type> > & points;
+		};
 
-				for (double j = 0.0; round_to(j, m_resolution) < m_j_dim; j+=(m_resolution / 2.0))
-				{
-					Vec3<Type> ray_k_offset = m_ray_j->getValue(j);
+		void setUnitCube()
+		{
+			// constant initialized, i.e. read-only data, when the constructors of Vec3 are constexpr
+			static const Vec3<Type> pts[8] = {
+				Vec3<Type>((Type)0.0, (Type)0.0, (Type)0.0),
+				Vec3<Type>((Type)1.0, (Type)0.0, (Type)0.0),
+				Vec3<Type>((Type)1.0, (Type)1.0, (Type)0.0),
+				Vec3<Type>((Type)0.0, (Type)1.0, (Type)0.0),
+				Vec3<Type>((Type)0.0, (Type)0.0, (Type)1.0),
+				Vec3<Type>((Type)1.0, (Type)0.0, (Type)1.0),
+				Vec3<Type>((Type)1.0, (Type)1.0, (Type)1.0),
+				Vec3<Type>((Type)0.0, (Type)1.0, (Type)1.0)
+			};
 
-					m_ray_k->setValue(ray_k_offset, m_ray_k->getDirection());
+			setVertices(pts);
+		}
 
-					for (double k = 0.0; round_to(k, m_resolution) < m_k_dim; k+=(m_resolution / 2.0))
-					{
-						Vec3<Type> temp;
+		void initFill()
+		{
+			m_fill_init = 0;
+			m_resolution = 1.0;
+			m_num_fill_points = 1;
+			m_fill_grid_init = 0;
+		}
 
-						temp = m_ray_k->getValue(k);
+		// The prism is the intersection of 3 slabs, found from its edges rather than from its convex hull.
+		virtual bool getHalfspaces(std::vector<Halfspace> & halfspaces) const
+		{
+			// 1. Start with arbitrary point (m_vertices[0])
+			// 2. Find its 3 linearly independent link points (the 2 closest points are alway part of
+			// the list of 3 linearly independent connected points, and the 3rd one is the closest
+			// to the line along the cross product of the 2 produced vectors)
+			const Vec3<double> origin = this->getCorner(0);
+			Vec3<double> edges[3];
+			int min_index[2] = {0, 0};
 
-						// discretize this voxel
-						temp.x() = round_to(temp.x(), m_resolution);
-						temp.y() = round_to(temp.y(), m_resolution);
-						temp.z() = round_to(temp.z(), m_resolution);
+			for (int e = 0; e < 2; e++)
+			{
+				double min_dist = DBL_MAX;
+
+				for (int j = 1; j < 8; j++)
+				{
+					if (j == min_index[0])
+						continue;
 
-						temp.x() /= m_resolution;
-						temp.y() /= m_resolution;
-						temp.z() /= m_resolution;
+					Vec3<double> vec = this->getCorner(j) - origin;
 
-						// add it to our flat list
-						m_fill_points.push_back(temp);
+					if (vec.length() < min_dist)
+					{
+						edges[e] = vec;
+						min_dist = vec.length();
+						min_index[e] = j;
 					}
 				}
 			}
 
-			// finally, remove duplicate voxels from our flat list...
-			remove_duplicates(m_fill_points);
-			m_num_fill_points = (int)m_fill_points.size();
-		}
-
-		// this function rounds value to the closest modulus of specified resolution
-		int round_to(Type value, Type resolution)
-		{
-			int low_boundary;
-			int high_boundary;
-			Type dist_to_low;
-			Type dist_to_high;
+			Vec3<double> axis = edges[0].cross(edges[1]);
 
-			low_boundary = (int)((int)(value / resolution) * resolution);
-			high_boundary = low_boundary + (int)((double)resolution + 0.5);
+			if (axis.normalize() == 0.0)
+				return false;
 
-			dist_to_low = value - (Type)low_boundary;
-			dist_to_high = (Type)high_boundary - value;
+			double min_line_dist = DBL_MAX;
 
-			if (dist_to_low < dist_to_high)
+			for (int j = 1; j < 8; j++)
 			{
-				return low_boundary;
-			} else {
-				return high_boundary;
+				if (j == min_index[0] || j == min_index[1])
+					continue;
+
+				Vec3<double> vec = this->getCorner(j) - origin;
+				double dist = (vec - axis * vec.dot(axis)).length();
+
+				if (dist < min_line_dist)
+				{
+					min_line_dist = dist;
+					edges[2] = vec;
+				}
 			}
-		}
 
-		static bool sort_operator(Vec3<Type> v1, Vec3<Type> v2)
-		{
-			if (v1.x() < v2.x())
+			halfspaces.clear();
+
+			for (int s = 0; s < 3; s++)
 			{
-				return true;
-			} else if (v1.x() > v2.x()) {
-				return false;
-			} else {
-				if (v1.y() < v2.y())
-				{
-					return true;
-				} else if (v1.y() > v2.y()) {
+				Vec3<double> normal = edges[(s + 1) % 3].cross(edges[(s + 2) % 3]);
+
+				if (normal.normalize() == 0.0)
 					return false;
-				} else {
-					if (v1.z() < v2.z())
-					{
-						return true;
-					} else {
-						return false;
-					}
-				}
+
+				double a = origin.dot(normal);
+				double b = (origin + edges[s]).dot(normal);
+
+				if (a == b)
+					return false;
+
+				halfspaces.push_back(Halfspace(normal, std::max(a, b)));
+				halfspaces.push_back(Halfspace(normal * -1.0, -std::min(a, b)));
 			}
-		}
 
-		void remove_duplicates(std::vector< Vec3<Type> > &vec)
-		{
-			std::sort(vec.begin(), vec.end(), sort_operator);
-			vec.erase(std::unique(vec.begin(), vec.end()), vec.end());
+			return true;
 		}
 	};
 
@@ -89,7 +89,7 @@ namespace gtl
 		{
 			double distance;
 
-			distance = sqrt(SQR(pt1.y() - pt2.y()) + SQR(pt1.x() - pt2.x()));
+			distance = sqrt(sqr((double)(pt1.y() - pt2.y())) + sqr((double)(pt1.x() - pt2.x())));
 
 			return (Type)distance;
 		}
@@ -108,7 +108,7 @@ namespace gtl
 				+
 			    (point.y() - pt1.y()) * (pt2.y() - pt1.y()))
 			        /
-			    (SQR(getPtDistance(pt1, pt2)));
+			    (sqr(pt2.x() - pt1.x()) + sqr(pt2.y() - pt1.y()));
 
 			double x = pt1.x() + (u * (pt2.x() - pt1.x()));
 			double y = pt1.y() + (u * (pt2.y() - pt1.y()));
@@ -0,0 +1,419 @@
+/*
+_______________________________________________________________________
+__________________________ G E O M E T R Y ____________________________
+|
+| THIS FILE IS PART OF THE GEOMETRY TEMPLATE LIBRARY.
+| USE, DISTRIBUTION AND REPRODUCTION OF THIS LIBRARY SOURCE IS
+| GOVERNED BY A BSD-STYLE SOURCE LICENSE.
+| PLEASE READ THESE TERMS BEFORE DISTRIBUTING.
+_______________________________________________________________________
+_______________________________________________________________________
+*/
+
+#ifndef SPATIALHASH_H
+#define SPATIALHASH_H
+
+#include <gtl/gtl.hpp>
+#include <gtl/vec3.hpp>
+#include <gtl/box3.hpp>
+#include <gtl/sphere.hpp>
+
+#include <utility>
+
+namespace gtl
+{
+    /*!
+    \class SpatialHash SpatialHash.hpp geometry/SpatialHash.hpp
+    \brief Broad phase finding the overlapping pairs of a dynamic set of boxes and spheres.
+    \ingroup base
+
+    The objects are registered in every cell of a uniform grid that their bounding box
+    touches. Only the occupied cells are stored: the (cell, object) entries are counting
+    sorted into the buckets of a hash table, so that the objects of a cell are contiguous
+    up to the few other cells sharing the bucket. A pair is reported by the single cell
+    holding the lower corner of the overlap of the two bounding boxes, which needs no
+    duplicate removal.
+
+    Moving an object within the cells it already covers only updates its bounds. The entries
+    are rebuilt, in buffers which keep their memory, when an object changed cells. If the
+    cell size is not given, it follows twice the average object size, and the grid is
+    rebuilt when the average drifts by more than a factor 2. The few objects which would
+    cover too many cells are tested against all the others instead.
+
+    \sa Box3, Sphere, SphereTree
+    */
+    template<typename Type>
+    class SpatialHash
+    {
+    public:
+        //! Pair of object identifiers (i, j), with i < j.
+        typedef std::pair<unsigned int, unsigned int> Pair;
+
+        //! Makes an empty set. A cell size of 0 adapts the cells to the objects. \sa setCellSize().
+        SpatialHash(Type a_cell_size = (Type)0) : m_cell_size(a_cell_size), m_adaptive(a_cell_size <= (Type)0),
+                                                  m_size_sum(0.0), m_count(0), m_dirty(false), m_bits(1)
+        {
+        }
+
+        //! Set the size of the cells, 0 adapts it to the objects.
+        void setCellSize(Type a_cell_size)
+        {
+            m_adaptive = a_cell_size <= (Type)0;
+            m_cell_size = m_adaptive ? (Type)0 : a_cell_size;
+            m_dirty = true;
+        }
+
+        //! Return the size of the cells, 0 if it was not chosen yet.
+        Type getCellSize() const
+        {
+            return m_cell_size;
+        }
+
+        //! Remove all the objects.
+        void clear()
+        {
+            m_objects.clear();
+            m_free.clear();
+            m_cells.clear();
+            m_entries.clear();
+            m_starts.clear();
+            m_large.clear();
+            m_size_sum = 0.0;
+            m_count = 0;
+            m_dirty = false;
+            if(m_adaptive) m_cell_size = (Type)0;
+        }
+
+        //! Return the number of objects.
+        std::size_t size() const
+        {
+            return m_count;
+        }
+
+        //! Add a box, return its identifier. The identifiers of removed objects are reused.
+        unsigned int insert(const Box3<Type> & a_box)
+        {
+            unsigned int id;
+
+            if(m_free.empty()){
+                id = (unsigned int)m_objects.size();
+                m_objects.push_back(Object());
+            }else{
+                id = m_free.back();
+                m_free.pop_back();
+            }
+
+            Object & object = m_objects[id];
+            object.alive = true;
+            object.box = a_box;
+            object.sphere = false;
+
+            m_size_sum += size(a_box);
+            m_count++;
+            m_dirty = true;
+
+            return id;
+        }
+
+        //! Add a sphere, return its identifier.
+        unsigned int insert(const Sphere<Type> & a_sphere)
+        {
+            const unsigned int id = insert(bounds(a_sphere));
+
+            m_objects[id].sphere = true;
+            m_objects[id].center = a_sphere.getCenter();
+            m_objects[id].radius = a_sphere.getRadius();
+
+            return id;
+        }
+
+        //! Move the box \a a_id, which keeps its identifier. The object must not have been removed.
+        void move(unsigned int a_id, const Box3<Type> & a_box)
+        {
+            Object & object = m_objects[a_id];
+
+            m_size_sum += size(a_box) - size(object.box);
+            object.box = a_box;
+            object.sphere = false;
+
+            if(!m_dirty && !sameCells(object)) m_dirty = true;
+        }
+
+        //! Move the sphere \a a_id, which keeps its identifier.
+        void move(unsigned int a_id, const Sphere<Type> & a_sphere)
+        {
+            move(a_id, bounds(a_sphere));
+
+            m_objects[a_id].sphere = true;
+            m_objects[a_id].center = a_sphere.getCenter();
+            m_objects[a_id].radius = a_sphere.getRadius();
+        }
+
+        //! Remove the object \a a_id.
+        void remove(unsigned int a_id)
+        {
+            Object & object = m_objects[a_id];
+
+            if(!object.alive) return;
+
+            object.alive = false;
+            m_size_sum -= size(object.box);
+            m_count--;
+            m_free.push_back(a_id);
+            m_dirty = true;
+        }
+
+        //! Return the bounding box of the object \a a_id.
+        const Box3<Type> & getBounds(unsigned int a_id) const
+        {
+            return m_objects[a_id].box;
+        }
+
+        /*! Append to \a a_pairs every pair of intersecting objects, as identifiers (i, j) with i < j,
+        in no particular order but the same from one call to the next. Boxes are tested with
+        Box3::intersect(), spheres with Sphere::intersect(). Calling a_pairs.clear() before every
+        step keeps its memory, and so does the hash. The cells are processed in parallel when
+        OpenMP is enabled. Return the number of pairs found.
+        */
+        std::size_t getOverlaps(std::vector<Pair> & a_pairs)
+        {
+            const std::size_t size = a_pairs.size();
+
+            if(m_count < 2) return 0;
+
+            update();
+
+            // split the buckets in chunks, which keep their pairs
+            const std::size_t num_buckets = m_starts.size() - 1;
+            const long num_chunks = m_entries.size() > PARALLEL_SIZE ? NUM_CHUNKS : 1;
+
+            m_chunk_pairs.resize(num_chunks);
+
+#ifdef _OPENMP
+            #pragma omp parallel for schedule(dynamic) if(num_chunks > 1)
+#endif
+            for(long c = 0; c < num_chunks; c++){
+                m_chunk_pairs[c].clear();
+                findPairs(num_buckets * c / num_chunks, num_buckets * (c + 1) / num_chunks, m_chunk_pairs[c]);
+            }
+
+            for(long c = 0; c < num_chunks; c++){
+                a_pairs.insert(a_pairs.end(), m_chunk_pairs[c].begin(), m_chunk_pairs[c].end());
+            }
+
+            // the objects covering too many cells against all the others
+            for(std::size_t l = 0; l < m_large.size(); l++){
+                const unsigned int a = m_large[l];
+
+                for(unsigned int b = 0; b < (unsigned int)m_objects.size(); b++){
+                    if(b == a || !m_objects[b].alive || (m_objects[b].large && b < a)) continue;
+                    if(overlap(a, b)) a_pairs.push_back(a < b ? Pair(a, b) : Pair(b, a));
+                }
+            }
+
+            return a_pairs.size() - size;
+        }
+
+    private:
+        struct Object
+        {
+            Box3<Type>   box;
+            Vec3<Type>   center;  //!< center of a sphere
+            Type         radius;  //!< radius of a sphere
+            Vec3<int>    lo;      //!< first cell covered at the last update
+            Vec3<int>    hi;      //!< last cell covered at the last update
+            bool         alive;
+            bool         sphere;
+            bool         large;   //!< covers too many cells to be hashed
+        };
+
+        struct Entry
+        {
+            uint64       key;     // biased cell coordinates on 21 bits each
+            unsigned int id;
+        };
+
+        // MAX_CELLS is the largest number of cells of a hashed object
+        enum { BIAS = 1 << 20, MAX_CELLS = 64, NUM_CHUNKS = 64, PARALLEL_SIZE = 16384 };
+
+        Type                       m_cell_size;
+        bool                       m_adaptive;
+        double                     m_size_sum;  //!< sum of the largest extent of the objects
+        std::size_t                m_count;
+        bool                       m_dirty;     //!< an object changed cells since the last update
+        std::vector<Object>        m_objects;
+        std::vector<unsigned int>  m_free;
+        std::vector<Entry>         m_cells;     //!< entries in the order of the objects
+        std::vector<Entry>         m_entries;   //!< entries grouped by bucket
+        std::vector<unsigned int>  m_starts;    //!< first entry of every bucket, and the total
+        std::vector<unsigned int>  m_large;
+        int                        m_bits;      //!< log2 of the number of buckets
+        std::vector< std::vector<Pair> > m_chunk_pairs;
+
+        static Box3<Type> bounds(const Sphere<Type> & a_sphere)
+        {
+            const Type r = a_sphere.getRadius();
+
+            return Box3<Type>(a_sphere.getCenter() - Vec3<Type>(r, r, r), a_sphere.getCenter() + Vec3<Type>(r, r, r));
+        }
+
+        static double size(const Box3<Type> & a_box)
+        {
+            const Vec3<Type> extent = a_box.getSize();
+
+            return (double)std::max(extent[0], std::max(extent[1], extent[2]));
+        }
+
+        int cell(Type a_coord) const
+        {
+            const double c = std::floor((double)a_coord / (double)m_cell_size);
+
+            const double bias = (double)BIAS;
+
+            return c < -bias ? -BIAS : (c >= bias ? BIAS - 1 : (int)c);
+        }
+
+        // Fibonacci hashing: the high bits of the key times 2^64 over the golden ratio.
+        unsigned int bucket(uint64 a_key) const
+        {
+            return (unsigned int)((a_key * ((uint64)0x9E3779B9 << 32 | (uint64)0x7F4A7C15)) >> (64 - m_bits));
+        }
+
+        static uint64 key(int i, int j, int k)
+        {
+            return (uint64)(i + BIAS) | (uint64)(j + BIAS) << 21 | (uint64)(k + BIAS) << 42;
+        }
+
+        bool sameCells(const Object & a_object) const
+        {
+            if(m_cell_size <= (Type)0) return false;
+
+            for(int c = 0; c < 3; c++){
+                if(cell(a_object.box.getMin()[c]) != a_object.lo[c] || cell(a_object.box.getMax()[c]) != a_object.hi[c]) return false;
+            }
+            return true;
+        }
+
+        // Choose the cell size if it adapts, and rebuild the sorted entries if the objects changed cells.
+        void update()
+        {
+            if(m_adaptive){
+                const double ideal = 2.0 * m_size_sum / (double)m_count;
+
+                if(ideal > 0.0 && (m_cell_size <= (Type)0 || m_cell_size < 0.5 * ideal || m_cell_size > 2.0 * ideal)){
+                    m_cell_size = (Type)ideal;
+                    m_dirty = true;
+                }
+                if(m_cell_size <= (Type)0){
+                    // all the objects are points
+                    m_cell_size = (Type)1;
+                    m_dirty = true;
+                }
+            }
+
+            if(!m_dirty) return;
+
+            m_cells.clear();
+            m_large.clear();
+
+            for(unsigned int id = 0; id < (unsigned int)m_objects.size(); id++){
+                Object & object = m_objects[id];
+
+                if(!object.alive) continue;
+
+                std::size_t cells = 1;
+                for(int c = 0; c < 3; c++){
+                    object.lo[c] = cell(object.box.getMin()[c]);
+                    object.hi[c] = cell(object.box.getMax()[c]);
+                    cells *= (std::size_t)(object.hi[c] - object.lo[c] + 1);
+                }
+
+                object.large = cells > MAX_CELLS;
+
+                if(object.large){
+                    m_large.push_back(id);
+                    continue;
+                }
+
+                Entry entry;
+                entry.id = id;
+
+                for(int i = object.lo[0]; i <= object.hi[0]; i++){
+                    for(int j = object.lo[1]; j <= object.hi[1]; j++){
+                        for(int k = object.lo[2]; k <= object.hi[2]; k++){
+                            entry.key = key(i, j, k);
+                            m_cells.push_back(entry);
+                        }
+                    }
+                }
+            }
+
+            // counting sort in about twice as many buckets as entries, the identifiers stay increasing in a bucket
+            m_bits = 1;
+            while(m_bits < 30 && ((std::size_t)1 << m_bits) < 2 * m_cells.size()) m_bits++;
+
+            m_starts.assign(((std::size_t)1 << m_bits) + 1, 0u);
+            for(std::size_t e = 0; e < m_cells.size(); e++) m_starts[bucket(m_cells[e].key) + 1]++;
+            for(std::size_t b = 1; b < m_starts.size(); b++) m_starts[b] += m_starts[b - 1];
+
+            m_entries.resize(m_cells.size());
+            for(std::size_t e = 0; e < m_cells.size(); e++) m_entries[m_starts[bucket(m_cells[e].key)]++] = m_cells[e];
+
+            // every start was moved to the start of the next bucket
+            for(std::size_t b = m_starts.size() - 1; b > 0; b--) m_starts[b] = m_starts[b - 1];
+            m_starts[0] = 0;
+
+            m_dirty = false;
+        }
+
+        // Test the pairs of the cells of the buckets [begin, end).
+        void findPairs(std::size_t begin, std::size_t end, std::vector<Pair> & a_pairs) const
+        {
+            for(std::size_t bucket = begin; bucket < end; bucket++){
+                const unsigned int last = m_starts[bucket + 1];
+
+                for(unsigned int p = m_starts[bucket]; p < last; p++){
+                    const uint64 cellkey = m_entries[p].key;
+                    const unsigned int a = m_entries[p].id;
+                    const Box3<Type> & box = m_objects[a].box;
+
+                    for(unsigned int q = p + 1; q < last; q++){
+                        if(m_entries[q].key != cellkey) continue;
+
+                        const unsigned int b = m_entries[q].id;
+                        const Box3<Type> & other = m_objects[b].box;
+
+                        if(!box.intersect(other)) continue;
+
+                        // report the pair in the cell of the lower corner of the overlap only
+                        const int i = cell(std::max(box.getMin()[0], other.getMin()[0]));
+                        const int j = cell(std::max(box.getMin()[1], other.getMin()[1]));
+                        const int k = cell(std::max(box.getMin()[2], other.getMin()[2]));
+
+                        if(key(i, j, k) != cellkey) continue;
+
+                        if(overlap(a, b)) a_pairs.push_back(Pair(a, b));
+                    }
+                }
+            }
+        }
+
+        // Exact test of the shapes of two objects whose bounding boxes intersect.
+        bool overlap(unsigned int a, unsigned int b) const
+        {
+            const Object & oa = m_objects[a];
+            const Object & ob = m_objects[b];
+
+            if(oa.sphere && ob.sphere) return Sphere<Type>(oa.center, oa.radius).intersect(Sphere<Type>(ob.center, ob.radius));
+            if(oa.sphere) return Sphere<Type>(oa.center, oa.radius).intersect(ob.box);
+            if(ob.sphere) return Sphere<Type>(ob.center, ob.radius).intersect(oa.box);
+
+            return oa.box.intersect(ob.box);
+        }
+    };
+
+    typedef SpatialHash<float>  SpatialHashf;
+    typedef SpatialHash<double> SpatialHashd;
+} // namespace gtl
+
+#endif
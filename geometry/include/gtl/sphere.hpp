@@ -40,12 +40,6 @@ namespace gtl
             m_radius = 1;
         }
 
-        //! Constructs an instance with initial values from \a a_sphere.
-        Sphere(const Sphere<Type> & a_sphere)
-        {
-            setValue(a_sphere.m_center, a_sphere.m_radius);
-        }
-
         //! Construct a sphere given center and radius
         Sphere(const Vec3<Type> &c, Type r)
         {
@@ -58,31 +52,14 @@ namespace gtl
             setPoles(p1, p2); 
         }
 
-        //! Compute a fast approximation of the bounding ball for the given point set.
+        //! Compute a fast approximation of the bounding ball for the given point set. \sa circumscribe().
         Sphere(const std::vector< Vec3<Type> > & points)
         {
-            //based on the algorithm given by [Jack Ritter, 1990]
-            if(points.empty()) return;
-
-            // find a large diameter to start with
-            // first get the bounding box
-            Box3<Type> bbox;
-            for(unsigned int i=0; i<points.size(); i++){
-                bbox.extendBy(points[i]);
-            }
-
-            setPoles(bbox.getMin(), bbox.getMax());
+            makeEmpty();
 
-            m_radius /= (Type)2.0;
-
-            for(unsigned int i=0; i<points.size(); i++){
-                extendBy(points[i]);
-            }
+            if(!points.empty()) extendBy(&points[0], points.size());
         }
 
-        //! Default destructor does nothing.
-        virtual ~Sphere(){}
-
         //! Change the center and radius
         void setValue(const Vec3<Type> &c, Type r)
         {
@@ -97,6 +74,19 @@ namespace gtl
             m_radius = (Type)0.5 * (p1 - p2).length();
         }
 
+        //! Check if this has been marked as an empty sphere, of negative radius. \sa makeEmpty().
+        bool isEmpty() const
+        {
+            return m_radius < 0;
+        }
+
+        //! Marks this as an empty sphere, which the first point or sphere it is extended by replaces. \sa isEmpty().
+        void makeEmpty()
+        {
+            m_center.setValue(0, 0, 0);
+            m_radius = -1;
+        }
+
         //! Set the center
         void setCenter(const Vec3<Type> &c)
         {
@@ -124,13 +114,13 @@ namespace gtl
         //! Volume of the sphere
         Type getVolume() const
         {
-            return (Type)(M_PI * (4.0 / 3.0) * std::pow(m_radius, 3));
+            return (Type)(M_PI * (4.0 / 3.0) * m_radius * m_radius * m_radius);
         }
 
         //! Surface of the sphere
         Type getSurface() const
         {
-            return (Type)(M_PI * 4.0 * std::pow(m_radius, 2));
+            return (Type)(M_PI * 4.0 * sqr(m_radius));
         }
 
         //! Make the sphere containing a given box
@@ -140,9 +130,150 @@ namespace gtl
             m_radius = (box.getMax() - m_center).length();
         }
 
+        /*! Make the smallest sphere containing the \a a_count points, with the randomized algorithm
+        of [Emo Welzl, 1991] in expected linear time. The recursion is unrolled into four nested loops
+        over the points in a shuffled order, each loop keeping one more point on the boundary. The
+        radius is finally enlarged by the rounding errors so that every point is inside.
+        */
+        void circumscribe(const Vec3<Type> * a_points, std::size_t a_count)
+        {
+            makeEmpty();
+
+            if(a_count == 0) return;
+
+            std::vector< Vec3<Type> > points(a_points, a_points + a_count);
+
+            // the shuffle makes the expected time linear whatever the order of the input
+            uint64 state = (uint64)0x9E3779B9 << 32 | (uint64)0x7F4A7C15;
+            for(std::size_t i = a_count - 1; i > 0; i--){
+                state ^= state << 13;
+                state ^= state >> 7;
+                state ^= state << 17;
+                std::swap(points[i], points[(std::size_t)(state % (uint64)(i + 1))]);
+            }
+
+            setValue(points[0], 0);
+
+            for(std::size_t i = 1; i < a_count; i++){
+                if(contains(points[i])) continue;
+
+                setValue(points[i], 0);
+
+                for(std::size_t j = 0; j < i; j++){
+                    if(contains(points[j])) continue;
+
+                    setPoles(points[i], points[j]);
+
+                    for(std::size_t k = 0; k < j; k++){
+                        if(contains(points[k])) continue;
+
+                        setBoundary(points[i], points[j], points[k]);
+
+                        for(std::size_t l = 0; l < k; l++){
+                            if(contains(points[l])) continue;
+
+                            setBoundary(points[i], points[j], points[k], points[l]);
+                        }
+                    }
+                }
+            }
+
+            Type radius = sqr(m_radius);
+            for(std::size_t i = 0; i < a_count; i++){
+                radius = std::max(radius, (points[i] - m_center).sqrLength());
+            }
+            m_radius = std::max(m_radius, squareRoot(radius));
+        }
+
+        //! Make the smallest sphere containing the given points. \sa circumscribe(const Vec3<Type> *, std::size_t).
+        void circumscribe(const std::vector< Vec3<Type> > & a_points)
+        {
+            if(a_points.empty()) makeEmpty();
+            else circumscribe(&a_points[0], a_points.size());
+        }
+
+        /*! Extend the sphere by \a a_count points, a fast approximation of the bounding sphere in
+        a single pass. The points are taken by blocks: the sphere of a block starts from its most
+        distant pair of extreme points along seven directions [Thomas Larsson, 2008], grows by the
+        points outside [Jack Ritter, 1990], and this sphere is extended by it. Points which do not
+        fit in memory are streamed by calling this on each chunk, starting from an empty sphere.
+        With OpenMP the blocks are bounded in parallel, which gives the same sphere.
+        */
+        void extendBy(const Vec3<Type> * a_points, std::size_t a_count)
+        {
+            const long num_blocks = (long)((a_count + BLOCK_SIZE - 1) / BLOCK_SIZE);
+
+            if(num_blocks == 1){
+                extendBy(bound(a_points, a_count));
+                return;
+            }
+
+            std::vector< Sphere<Type> > spheres(num_blocks);
+
+#ifdef _OPENMP
+            #pragma omp parallel for
+#endif
+            for(long b = 0; b < num_blocks; b++){
+                const std::size_t begin = (std::size_t)b * BLOCK_SIZE;
+
+                spheres[b] = bound(a_points + begin, std::min<std::size_t>(BLOCK_SIZE, a_count - begin));
+            }
+
+            for(long b = 0; b < num_blocks; b++){
+                extendBy(spheres[b]);
+            }
+        }
+
+        //! Return a sphere bounding the \a n points, an empty sphere if there are none. \sa fromPoints(const Type *, std::size_t, std::size_t).
+        static Sphere<Type> fromPoints(const Vec3<Type> * a_points, std::size_t n)
+        {
+            return fromPoints(n ? a_points[0].getValue() : NULL, n, sizeof(Vec3<Type>));
+        }
+
+        //! Return a sphere bounding the given points, an empty sphere if there are none.
+        static Sphere<Type> fromPoints(const std::vector< Vec3<Type> > & a_points)
+        {
+            return fromPoints(a_points.empty() ? NULL : &a_points[0], a_points.size());
+        }
+
+        /*! Return a sphere bounding \a n points laid out as for Box3::fromPoints(), centered on their
+        bounding box and reaching the farthest point. Both passes are taken without branches, four
+        points at once with SSE2 for floats, and split into blocks among threads with OpenMP. The
+        sphere is looser than the ones of circumscribe() and extendBy(const Vec3<Type> *, std::size_t).
+        */
+        static Sphere<Type> fromPoints(const Type * a_coordinates, std::size_t n, std::size_t a_stride)
+        {
+            Sphere<Type> sphere;
+            sphere.makeEmpty();
+
+            if(n == 0) return sphere;
+
+            const Vec3<Type> center = Box3<Type>::fromPoints(a_coordinates, n, a_stride).getCenter();
+            const long num_blocks = (long)((n + BLOCK_SIZE - 1) / BLOCK_SIZE);
+            const char * bytes = (const char *)a_coordinates;
+            std::vector<Type> distances(num_blocks);
+
+#ifdef _OPENMP
+            #pragma omp parallel for if(num_blocks > 1)
+#endif
+            for(long b = 0; b < num_blocks; b++){
+                const std::size_t begin = (std::size_t)b * BLOCK_SIZE;
+
+                distances[b] = farthest((const Type *)(bytes + begin * a_stride), std::min<std::size_t>(BLOCK_SIZE, n - begin), a_stride, center);
+            }
+
+            sphere.setValue(center, squareRoot(*std::max_element(distances.begin(), distances.end())));
+            return sphere;
+        }
+
         //! Extend the boundaries of the sphere by the given point.
         void extendBy(const Vec3<Type> &a_point)
         {
+            if(isEmpty()){
+                setValue(a_point, 0);
+                return;
+            }
+
             if(intersect(a_point)) return;
 
             Vec3<Type> dir = m_center - a_point;
@@ -154,14 +285,25 @@ namespace gtl
             setPoles(p1, a_point);
         }
 
-        //! Extend the boundaries of the sphere by the given sphere.
+        //! Extend the boundaries of the sphere by the given sphere, to the smallest sphere containing both.
         void extendBy(const Sphere<Type> &sphere)
         {
-            if(intersect(sphere)) return;
+            if(sphere.isEmpty()) return;
+            if(isEmpty()){
+                *this = sphere;
+                return;
+            }
 
             Vec3<Type> dir = m_center - sphere.getCenter();
 
-            dir.normalize();
+            Type distance = dir.normalize();
+
+            // one of the spheres contains the other one
+            if(distance + sphere.getRadius() <= m_radius) return;
+            if(distance + m_radius <= sphere.getRadius()){
+                *this = sphere;
+                return;
+            }
 
             Vec3<Type> p1 = m_center + m_radius * dir;
             Vec3<Type> p2 = sphere.getCenter() - sphere.getRadius() * dir;
@@ -268,11 +410,200 @@ namespace gtl
     private:
         Vec3<Type>  m_center;	//!< Sphere center
         Type	    m_radius;	//!< Sphere radius
+
+        enum
+        {
+            BLOCK_SIZE = 65536  //!< points bounded together by extendBy(const Vec3<Type> *, std::size_t)
+        };
+
+        // Inside up to rounding, for circumscribe().
+        bool contains(const Vec3<Type> & a_point) const
+        {
+            const Type tolerance = (Type)1.0 + 64 * std::numeric_limits<Type>::epsilon();
+
+            return (a_point - m_center).sqrLength() <= sqr(m_radius) * tolerance;
+        }
+
+        // Smallest sphere with the three points on its boundary, centered in their plane.
+        void setBoundary(const Vec3<Type> & a, const Vec3<Type> & b, const Vec3<Type> & c)
+        {
+            const Vec3<Type> u = b - a;
+            const Vec3<Type> v = c - a;
+            const Vec3<Type> n = u.cross(v);
+            const Type nn = n.sqrLength();
+
+            if(nn <= std::numeric_limits<Type>::epsilon() * u.sqrLength() * v.sqrLength()){
+                // aligned points, the two most distant are the poles
+                const Type ab = u.sqrLength(), ac = v.sqrLength(), bc = (c - b).sqrLength();
+
+                if(ab >= ac && ab >= bc) setPoles(a, b);
+                else if(ac >= bc) setPoles(a, c);
+                else setPoles(b, c);
+                return;
+            }
+
+            const Vec3<Type> offset = (v.sqrLength() * n.cross(u) + u.sqrLength() * v.cross(n)) / (2 * nn);
+
+            setValue(a + offset, offset.length());
+        }
+
+        // Sphere with the four points on its boundary.
+        void setBoundary(const Vec3<Type> & a, const Vec3<Type> & b, const Vec3<Type> & c, const Vec3<Type> & d)
+        {
+            const Vec3<Type> u = b - a;
+            const Vec3<Type> v = c - a;
+            const Vec3<Type> w = d - a;
+            const Type det = u.dot(v.cross(w));
+
+            if(sqr(det) <= std::numeric_limits<Type>::epsilon() * u.sqrLength() * v.sqrLength() * w.sqrLength()){
+                // coplanar points, the smallest sphere through three of them containing the fourth
+                const Vec3<Type> * points[4] = { &a, &b, &c, &d };
+                Sphere<Type> best;
+                best.makeEmpty();
+
+                for(int skip = 0; skip < 4; skip++){
+                    const Vec3<Type> * three[3];
+                    for(int p = 0, t = 0; p < 4; p++){
+                        if(p != skip) three[t++] = points[p];
+                    }
+
+                    Sphere<Type> sphere;
+                    sphere.setBoundary(*three[0], *three[1], *three[2]);
+
+                    if(sphere.contains(*points[skip]) && (best.isEmpty() || sphere.m_radius < best.m_radius)) best = sphere;
+                }
+
+                if(best.isEmpty()){
+                    setBoundary(a, b, c);
+                    extendBy(d);
+                }else{
+                    *this = best;
+                }
+                return;
+            }
+
+            const Vec3<Type> offset = (u.sqrLength() * v.cross(w) + v.sqrLength() * w.cross(u) + w.sqrLength() * u.cross(v)) / (2 * det);
+
+            setValue(a + offset, offset.length());
+        }
+
+        // Approximate bounding sphere of the points, seeded by the extreme points along seven directions.
+        static Sphere<Type> bound(const Vec3<Type> * a_points, std::size_t a_count)
+        {
+            std::size_t lower[7], upper[7];
+            Type low[7], high[7];
+
+            project(a_points[0], low);
+
+            for(int d = 0; d < 7; d++){
+                lower[d] = upper[d] = 0;
+                high[d] = low[d];
+            }
+
+            for(std::size_t i = 1; i < a_count; i++){
+                Type t[7];
+                project(a_points[i], t);
+
+                for(int d = 0; d < 7; d++){
+                    if(t[d] < low[d]){
+                        low[d] = t[d];
+                        lower[d] = i;
+                    }
+                    if(t[d] > high[d]){
+                        high[d] = t[d];
+                        upper[d] = i;
+                    }
+                }
+            }
+
+            int best = 0;
+            Type diameter = (a_points[upper[0]] - a_points[lower[0]]).sqrLength();
+
+            for(int d = 1; d < 7; d++){
+                const Type length = (a_points[upper[d]] - a_points[lower[d]]).sqrLength();
+
+                if(length > diameter){
+                    diameter = length;
+                    best = d;
+                }
+            }
+
+            Sphere<Type> sphere(a_points[lower[best]], a_points[upper[best]]);
+
+            for(std::size_t i = 0; i < a_count; i++){
+                sphere.extendBy(a_points[i]);
+            }
+            return sphere;
+        }
+
+        // Largest square distance from the center to the strided points.
+        template<typename T>
+        static T farthest(const T * a_coordinates, std::size_t n, std::size_t a_stride, const Vec3<T> & a_center)
+        {
+            const char * bytes = (const char *)a_coordinates;
+            T distance = 0;
+
+            for(std::size_t i = 0; i < n; i++){
+                const T * p = (const T *)(bytes + i * a_stride);
+                const T d = sqr(p[0] - a_center[0]) + sqr(p[1] - a_center[1]) + sqr(p[2] - a_center[2]);
+
+                distance = (d > distance) ? d : distance;
+            }
+            return distance;
+        }
+
+#ifdef GTL_SSE2
+        static float farthest(const float * a_coordinates, std::size_t n, std::size_t a_stride, const Vec3<float> & a_center)
+        {
+            const char * bytes = (const char *)a_coordinates;
+            const __m128 cx = _mm_set1_ps(a_center[0]);
+            const __m128 cy = _mm_set1_ps(a_center[1]);
+            const __m128 cz = _mm_set1_ps(a_center[2]);
+            __m128 distance = _mm_setzero_ps();
+            std::size_t i = 0;
+
+            // four points as rows, each loaded with the float which follows, so never the last point
+            for(; i + 4 < n; i += 4){
+                __m128 x = _mm_loadu_ps((const float *)(bytes + i * a_stride));
+                __m128 y = _mm_loadu_ps((const float *)(bytes + (i + 1) * a_stride));
+                __m128 z = _mm_loadu_ps((const float *)(bytes + (i + 2) * a_stride));
+                __m128 w = _mm_loadu_ps((const float *)(bytes + (i + 3) * a_stride));
+                _MM_TRANSPOSE4_PS(x, y, z, w);
+
+                x = _mm_sub_ps(x, cx);
+                y = _mm_sub_ps(y, cy);
+                z = _mm_sub_ps(z, cz);
+
+                const __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+                distance = _mm_max_ps(distance, d);
+            }
+
+            float d[4];
+            _mm_storeu_ps(d, distance);
+
+            return std::max(std::max(std::max(d[0], d[1]), std::max(d[2], d[3])), farthest<float>((const float *)(bytes + i * a_stride), n - i, a_stride, a_center));
+        }
+#endif
+
+        // Coordinates along the axes and the diagonals of the cube.
+        static void project(const Vec3<Type> & p, Type t[7])
+        {
+            t[0] = p[0];
+            t[1] = p[1];
+            t[2] = p[2];
+            t[3] = p[0] + p[1] + p[2];
+            t[4] = p[0] + p[1] - p[2];
+            t[5] = p[0] - p[1] + p[2];
+            t[6] = p[0] - p[1] - p[2];
+        }
     };
 
     typedef Sphere<int>    Spherei; 
     typedef Sphere<float>  Spheref; 
     typedef Sphere<double> Sphered;
+
+    GTL_ASSERT_PACKED(Spheref, float, 4);
+    GTL_ASSERT_PACKED(Sphered, double, 4);
 } // namespace gtl
 
 #endif
\ No newline at end of file
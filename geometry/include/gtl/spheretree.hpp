@@ -0,0 +1,401 @@
+/*
+_______________________________________________________________________
+__________________________ G E O M E T R Y ____________________________
+|
+| THIS FILE IS PART OF THE GEOMETRY TEMPLATE LIBRARY.
+| USE, DISTRIBUTION AND REPRODUCTION OF THIS LIBRARY SOURCE IS
+| GOVERNED BY A BSD-STYLE SOURCE LICENSE.
+| PLEASE READ THESE TERMS BEFORE DISTRIBUTING.
+_______________________________________________________________________
+_______________________________________________________________________
+*/
+
+#ifndef SPHERETREE_H
+#define SPHERETREE_H
+
+#include <gtl/gtl.hpp>
+#include <gtl/vec3.hpp>
+#include <gtl/box3.hpp>
+#include <gtl/ray.hpp>
+#include <gtl/sphere.hpp>
+
+#include <utility>
+
+namespace gtl
+{
+    /*!
+    \class SphereTree SphereTree.hpp geometry/SphereTree.hpp
+    \brief Bounding sphere hierarchy over a set of spheres.
+    \ingroup base
+
+    The tree is built top-down by splitting the centers at their median along the axis
+    of largest extent, and stored as a flat depth-first array of nodes like Bvh: the left
+    child of an inner node directly follows it. Every node is bounded by a sphere which is
+    grown with Sphere::extendBy(), so that moving spheres only need a refit() of the
+    bounds, in a single bottom-up pass, rather than a new build.
+
+    \sa Sphere, Bvh
+    */
+    template<typename Type>
+    class SphereTree
+    {
+    public:
+        //! The default constructor makes an empty hierarchy.
+        SphereTree(){}
+
+        //! Build the hierarchy of a set of spheres. \sa build().
+        SphereTree(const std::vector< Sphere<Type> > & a_spheres)
+        {
+            build(a_spheres);
+        }
+
+        //! Build the hierarchy of a set of spheres. The queries return indices in \a a_spheres.
+        void build(const std::vector< Sphere<Type> > & a_spheres)
+        {
+            if(a_spheres.empty()) clear();
+            else build(&a_spheres[0], a_spheres.size());
+        }
+
+        //! Build the hierarchy of \a a_num_spheres spheres. The queries return indices in \a a_spheres.
+        void build(const Sphere<Type> * a_spheres, std::size_t a_num_spheres)
+        {
+            clear();
+
+            if(a_num_spheres == 0) return;
+
+            m_indices.resize(a_num_spheres);
+            for(std::size_t i = 0; i < a_num_spheres; i++) m_indices[i] = (unsigned int)i;
+
+            m_nodes.reserve(2 * (a_num_spheres / MAX_LEAF_SIZE + 1));
+            buildRange(a_spheres, 0, (unsigned int)a_num_spheres);
+
+            m_spheres.resize(a_num_spheres);
+            refit(a_spheres);
+        }
+
+        //! Remove all the spheres.
+        void clear()
+        {
+            m_nodes.clear();
+            m_spheres.clear();
+            m_indices.clear();
+        }
+
+        /*! Update the bounds after the spheres moved or changed radius. \a a_spheres holds the
+        getNumSpheres() spheres in the order given to build(). The structure of the tree is
+        kept, so the queries get slower if the spheres moved far from where they were built.
+        */
+        void refit(const std::vector< Sphere<Type> > & a_spheres)
+        {
+            if(!a_spheres.empty()) refit(&a_spheres[0]);
+        }
+
+        //! Update the bounds after the spheres moved, see refit().
+        void refit(const Sphere<Type> * a_spheres)
+        {
+            for(std::size_t i = 0; i < m_indices.size(); i++){
+                m_spheres[i] = a_spheres[m_indices[i]];
+            }
+
+            // the children follow their parent, so a reverse sweep visits them first
+            for(std::size_t n = m_nodes.size(); n-- > 0;){
+                Node & node = m_nodes[n];
+
+                if(node.count){
+                    node.bounds = m_spheres[node.offset];
+                    for(unsigned int i = node.offset + 1; i < node.offset + node.count; i++){
+                        node.bounds.extendBy(m_spheres[i]);
+                    }
+                }else{
+                    node.bounds = m_nodes[n + 1].bounds;
+                    node.bounds.extendBy(m_nodes[node.offset].bounds);
+                }
+            }
+        }
+
+        //! Return the number of spheres.
+        std::size_t getNumSpheres() const
+        {
+            return m_indices.size();
+        }
+
+        //! Return the number of nodes.
+        std::size_t getNumNodes() const
+        {
+            return m_nodes.size();
+        }
+
+        //! Return the bounding sphere of all the spheres.
+        Sphere<Type> getBounds() const
+        {
+            return m_nodes.empty() ? Sphere<Type>(Vec3<Type>(0, 0, 0), 0) : m_nodes[0].bounds;
+        }
+
+        /*! Find the closest sphere hit by the ray, as defined by Sphere::intersect(): rays starting
+        inside a sphere do not hit it. Return true if there is an intersection. In that case
+        \a a_sphere is the index of the sphere and \a a_t the distance along the ray.
+        */
+        bool intersect(const Ray<Type> & a_ray, int & a_sphere, Type & a_t) const
+        {
+            if(m_nodes.empty()) return false;
+
+            Type tbest = std::numeric_limits<Type>::max();
+            int best = -1;
+
+            unsigned int stack[MAX_DEPTH + 1];
+            int top = 0;
+            unsigned int current = 0;
+            Type tnear;
+
+            if(!reaches(m_nodes[0].bounds, a_ray, tbest, tnear)) return false;
+
+            for(;;){
+                const Node & node = m_nodes[current];
+
+                if(node.count){
+                    for(unsigned int i = node.offset; i < node.offset + node.count; i++){
+                        Type t0, t1;
+                        if(m_spheres[i].intersect(a_ray, t0, t1) && t0 < tbest){
+                            tbest = t0;
+                            best = (int)i;
+                        }
+                    }
+                }else{
+                    // visit the nearest child first, keep the other one for later
+                    unsigned int left = current + 1;
+                    unsigned int right = node.offset;
+                    Type tleft, tright;
+                    bool hitleft = reaches(m_nodes[left].bounds, a_ray, tbest, tleft);
+                    bool hitright = reaches(m_nodes[right].bounds, a_ray, tbest, tright);
+
+                    if(hitleft && hitright){
+                        if(tright < tleft) std::swap(left, right);
+                        stack[top++] = right;
+                        current = left;
+                        continue;
+                    }
+                    if(hitleft){ current = left; continue; }
+                    if(hitright){ current = right; continue; }
+                }
+
+                // pop the next node which is still closer than the best hit
+                bool found = false;
+                while(top > 0){
+                    current = stack[--top];
+                    if(reaches(m_nodes[current].bounds, a_ray, tbest, tnear)){
+                        found = true;
+                        break;
+                    }
+                }
+                if(!found) break;
+            }
+
+            if(best < 0) return false;
+
+            a_sphere = (int)m_indices[best];
+            a_t = tbest;
+
+            return true;
+        }
+
+        //! Append to \a a_spheres the index of every sphere which intersects \a a_sphere. Return the number of spheres found.
+        std::size_t intersect(const Sphere<Type> & a_sphere, std::vector<unsigned int> & a_spheres) const
+        {
+            return collect(a_sphere, a_spheres);
+        }
+
+        //! Append to \a a_spheres the index of every sphere which intersects \a a_box. Return the number of spheres found.
+        std::size_t intersect(const Box3<Type> & a_box, std::vector<unsigned int> & a_spheres) const
+        {
+            return collect(a_box, a_spheres);
+        }
+
+        /*! Append to \a a_pairs every pair of intersecting spheres, as indices (i, j) with i < j.
+        The tree is traversed against itself, which avoids testing all the pairs.
+        Return the number of pairs found.
+        */
+        std::size_t getOverlaps(std::vector< std::pair<unsigned int, unsigned int> > & a_pairs) const
+        {
+            const std::size_t size = a_pairs.size();
+
+            if(m_nodes.empty()) return 0;
+
+            std::vector< std::pair<unsigned int, unsigned int> > stack;
+            stack.push_back(std::make_pair(0u, 0u));
+
+            while(!stack.empty()){
+                const unsigned int a = stack.back().first;
+                const unsigned int b = stack.back().second;
+                stack.pop_back();
+
+                const Node & na = m_nodes[a];
+                const Node & nb = m_nodes[b];
+
+                if(a == b){
+                    if(na.count){
+                        for(unsigned int i = na.offset; i < na.offset + na.count; i++){
+                            for(unsigned int j = i + 1; j < na.offset + na.count; j++) addPair(i, j, a_pairs);
+                        }
+                    }else{
+                        stack.push_back(std::make_pair(a + 1, a + 1));
+                        stack.push_back(std::make_pair(na.offset, na.offset));
+                        stack.push_back(std::make_pair(a + 1, na.offset));
+                    }
+                    continue;
+                }
+
+                if(!na.bounds.intersect(nb.bounds)) continue;
+
+                if(na.count && nb.count){
+                    for(unsigned int i = na.offset; i < na.offset + na.count; i++){
+                        if(!m_spheres[i].intersect(nb.bounds)) continue;
+                        for(unsigned int j = nb.offset; j < nb.offset + nb.count; j++) addPair(i, j, a_pairs);
+                    }
+                }else if(nb.count || (!na.count && na.bounds.getRadius() >= nb.bounds.getRadius())){
+                    // descend into the larger inner node
+                    stack.push_back(std::make_pair(a + 1, b));
+                    stack.push_back(std::make_pair(na.offset, b));
+                }else{
+                    stack.push_back(std::make_pair(a, b + 1));
+                    stack.push_back(std::make_pair(a, nb.offset));
+                }
+            }
+
+            return a_pairs.size() - size;
+        }
+
+    private:
+        // Flattened node. The left child of an inner node is the next node.
+        struct Node
+        {
+            Sphere<Type> bounds;
+            unsigned int offset; //!< first sphere of a leaf, right child of an inner node
+            unsigned int count;  //!< number of spheres of a leaf, 0 for an inner node
+        };
+
+        // Median splits bound the depth to 32 for up to 2^32 spheres.
+        enum { MAX_LEAF_SIZE = 4, MAX_DEPTH = 64 };
+
+        std::vector<Node>           m_nodes;   //!< Depth-first nodes, the root is the first one
+        std::vector< Sphere<Type> > m_spheres; //!< Spheres in leaf order
+        std::vector<unsigned int>   m_indices; //!< Index in the input of the spheres in leaf order
+
+        struct CenterLess
+        {
+            CenterLess(const Sphere<Type> * s, int a) : spheres(s), axis(a) {}
+
+            bool operator()(unsigned int i1, unsigned int i2) const
+            {
+                return spheres[i1].getCenter()[axis] < spheres[i2].getCenter()[axis];
+            }
+
+            const Sphere<Type> * spheres;
+            int axis;
+        };
+
+        // Build the subtree of [begin, end) of m_indices in depth-first order. The bounds are set by refit().
+        void buildRange(const Sphere<Type> * a_spheres, unsigned int begin, unsigned int end)
+        {
+            const std::size_t index = m_nodes.size();
+            m_nodes.push_back(Node());
+
+            const unsigned int count = end - begin;
+
+            if(count <= MAX_LEAF_SIZE){
+                m_nodes[index].offset = begin;
+                m_nodes[index].count = count;
+                return;
+            }
+
+            Box3<Type> centers;
+            for(unsigned int i = begin; i < end; i++) centers.extendBy(a_spheres[m_indices[i]].getCenter());
+
+            Vec3<Type> extent = centers.getSize();
+            int axis = 0;
+            if(extent[1] > extent[axis]) axis = 1;
+            if(extent[2] > extent[axis]) axis = 2;
+
+            const unsigned int middle = begin + count / 2;
+            std::nth_element(m_indices.begin() + begin, m_indices.begin() + middle, m_indices.begin() + end, CenterLess(a_spheres, axis));
+
+            buildRange(a_spheres, begin, middle);
+
+            m_nodes[index].offset = (unsigned int)m_nodes.size();
+            m_nodes[index].count = 0;
+
+            buildRange(a_spheres, middle, end);
+        }
+
+        template<typename Query>
+        std::size_t collect(const Query & a_query, std::vector<unsigned int> & a_spheres) const
+        {
+            const std::size_t size = a_spheres.size();
+
+            if(m_nodes.empty()) return 0;
+
+            unsigned int stack[MAX_DEPTH + 1];
+            int top = 0;
+
+            stack[top++] = 0;
+
+            while(top > 0){
+                const unsigned int current = stack[--top];
+                const Node & node = m_nodes[current];
+
+                if(!node.bounds.intersect(a_query)) continue;
+
+                if(node.count){
+                    for(unsigned int i = node.offset; i < node.offset + node.count; i++){
+                        if(m_spheres[i].intersect(a_query)) a_spheres.push_back(m_indices[i]);
+                    }
+                }else{
+                    stack[top++] = node.offset;
+                    stack[top++] = current + 1;
+                }
+            }
+
+            return a_spheres.size() - size;
+        }
+
+        void addPair(unsigned int i, unsigned int j, std::vector< std::pair<unsigned int, unsigned int> > & a_pairs) const
+        {
+            if(!m_spheres[i].intersect(m_spheres[j])) return;
+
+            const unsigned int a = m_indices[i], b = m_indices[j];
+
+            a_pairs.push_back(a < b ? std::make_pair(a, b) : std::make_pair(b, a));
+        }
+
+        // Return true if the ray gets inside of the sphere before \a a_tmax, in units of its direction.
+        // \a a_tnear receives the entry distance, 0 if the ray starts inside.
+        static bool reaches(const Sphere<Type> & a_sphere, const Ray<Type> & a_ray, Type a_tmax, Type & a_tnear)
+        {
+            const Vec3<Type> & dir = a_ray.getDirection();
+            const Vec3<Type> oc = a_ray.getOrigin() - a_sphere.getCenter();
+
+            const Type c = oc.sqrLength() - a_sphere.getRadius() * a_sphere.getRadius();
+
+            a_tnear = (Type)0;
+
+            if(c <= (Type)0) return true;
+
+            const Type b = oc.dot(dir);
+
+            if(b >= (Type)0) return false;
+
+            const Type a = dir.sqrLength();
+            const Type disc = b * b - a * c;
+
+            if(disc < (Type)0) return false;
+
+            a_tnear = (-b - (Type)std::sqrt(disc)) / a;
+
+            return a_tnear <= a_tmax;
+        }
+    };
+
+    typedef SphereTree<float>  SphereTreef;
+    typedef SphereTree<double> SphereTreed;
+} // namespace gtl
+
+#endif
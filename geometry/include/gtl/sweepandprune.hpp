@@ -0,0 +1,291 @@
+/*
+_______________________________________________________________________
+__________________________ G E O M E T R Y ____________________________
+|
+| THIS FILE IS PART OF THE GEOMETRY TEMPLATE LIBRARY.
+| USE, DISTRIBUTION AND REPRODUCTION OF THIS LIBRARY SOURCE IS
+| GOVERNED BY A BSD-STYLE SOURCE LICENSE.
+| PLEASE READ THESE TERMS BEFORE DISTRIBUTING.
+_______________________________________________________________________
+_______________________________________________________________________
+*/
+
+#ifndef SWEEPANDPRUNE_H
+#define SWEEPANDPRUNE_H
+
+#include <gtl/gtl.hpp>
+#include <gtl/vec3.hpp>
+#include <gtl/box3.hpp>
+
+#include <utility>
+
+namespace gtl
+{
+    /*!
+    \class SweepAndPrune SweepAndPrune.hpp geometry/SweepAndPrune.hpp
+    \brief Broad phase finding the overlapping pairs of a dynamic set of boxes by sorting them along one axis.
+    \ingroup base
+
+    The boxes are kept sorted by their lower bound along the axis where their centers
+    spread the most compared to their size. From one call of getOverlaps() to the next
+    the boxes only move a little, so the order is restored with an insertion sort whose
+    cost is the number of boxes which swapped. The sweep then tests every box against
+    the following ones until their lower bound passes its upper bound.
+
+    Unlike SpatialHash, the cost does not depend on the size of the boxes, which suits
+    long or thin objects, as long as the boxes do not all overlap along the sweep axis.
+    The interface is the same as SpatialHash.
+
+    \sa Box3, SpatialHash
+    */
+    template<typename Type>
+    class SweepAndPrune
+    {
+    public:
+        //! Pair of box identifiers (i, j), with i < j.
+        typedef std::pair<unsigned int, unsigned int> Pair;
+
+        //! Makes an empty set.
+        SweepAndPrune() : m_axis(0), m_count(0), m_removed(false)
+        {
+        }
+
+        //! Remove all the boxes.
+        void clear()
+        {
+            m_objects.clear();
+            m_free.clear();
+            m_added.clear();
+            m_entries.clear();
+            m_axis = 0;
+            m_count = 0;
+            m_removed = false;
+        }
+
+        //! Return the number of boxes.
+        std::size_t size() const
+        {
+            return m_count;
+        }
+
+        //! Return the axis along which the boxes are sorted.
+        int getAxis() const
+        {
+            return m_axis;
+        }
+
+        //! Add a box, return its identifier. The identifiers of removed boxes are reused.
+        unsigned int insert(const Box3<Type> & a_box)
+        {
+            unsigned int id;
+
+            if(m_free.empty()){
+                id = (unsigned int)m_objects.size();
+                m_objects.push_back(Object());
+                m_objects[id].sorted = false;
+            }else{
+                id = m_free.back();
+                m_free.pop_back();
+            }
+
+            m_objects[id].box = a_box;
+            m_objects[id].alive = true;
+            m_added.push_back(id);
+            m_count++;
+
+            return id;
+        }
+
+        //! Move the box \a a_id, which keeps its identifier. The box must not have been removed.
+        void move(unsigned int a_id, const Box3<Type> & a_box)
+        {
+            m_objects[a_id].box = a_box;
+        }
+
+        //! Remove the box \a a_id.
+        void remove(unsigned int a_id)
+        {
+            Object & object = m_objects[a_id];
+
+            if(!object.alive) return;
+
+            object.alive = false;
+            m_free.push_back(a_id);
+            m_count--;
+            m_removed = true;
+        }
+
+        //! Return the box \a a_id.
+        const Box3<Type> & getBounds(unsigned int a_id) const
+        {
+            return m_objects[a_id].box;
+        }
+
+        /*! Append to \a a_pairs every pair of intersecting boxes, as identifiers (i, j) with i < j,
+        in no particular order. Boxes are tested with Box3::intersect(). Calling a_pairs.clear()
+        before every step keeps its memory, and so does the sweep. Return the number of pairs found.
+        */
+        std::size_t getOverlaps(std::vector<Pair> & a_pairs)
+        {
+            const std::size_t size = a_pairs.size();
+
+            update();
+
+            const int axis = m_axis;
+            const std::size_t num_entries = m_entries.size();
+
+            for(std::size_t e = 0; e < num_entries; e++){
+                const Box3<Type> & box = m_entries[e].box;
+                const Type upper = box.getMax()[axis];
+                const unsigned int a = m_entries[e].id;
+
+                for(std::size_t f = e + 1; f < num_entries && m_entries[f].box.getMin()[axis] <= upper; f++){
+                    if(!box.intersect(m_entries[f].box)) continue;
+
+                    const unsigned int b = m_entries[f].id;
+                    a_pairs.push_back(a < b ? Pair(a, b) : Pair(b, a));
+                }
+            }
+
+            return a_pairs.size() - size;
+        }
+
+    private:
+        struct Object
+        {
+            Box3<Type>   box;
+            bool         alive;
+            bool         sorted;  //!< has an entry in the sorted array
+        };
+
+        struct Entry
+        {
+            Box3<Type>   box;     // copy of the box, so that the sweep reads contiguous memory
+            unsigned int id;
+        };
+
+        // less than on the lower bound along an axis
+        struct Less
+        {
+            int axis;
+
+            Less(int a_axis) : axis(a_axis)
+            {
+            }
+
+            bool operator ()(const Entry & e1, const Entry & e2) const
+            {
+                return e1.box.getMin()[axis] < e2.box.getMin()[axis];
+            }
+        };
+
+        int                       m_axis;
+        std::size_t               m_count;
+        bool                      m_removed;  //!< boxes were removed since the last update
+        std::vector<Object>       m_objects;
+        std::vector<unsigned int> m_free;
+        std::vector<unsigned int> m_added;    //!< boxes inserted since the last update
+        std::vector<Entry>        m_entries;  //!< sorted by lower bound along m_axis
+
+        /* Return the axis with the fewest expected overlaps, where the variance of the centers
+        over the squared average extent is the largest.
+        */
+        int sweepAxis() const
+        {
+            double sum[3] = {0.0, 0.0, 0.0};
+            double sum2[3] = {0.0, 0.0, 0.0};
+            double extent[3] = {0.0, 0.0, 0.0};
+
+            for(std::size_t e = 0; e < m_entries.size(); e++){
+                const Box3<Type> & box = m_entries[e].box;
+
+                for(int c = 0; c < 3; c++){
+                    const double center = 0.5 * ((double)box.getMin()[c] + (double)box.getMax()[c]);
+                    sum[c] += center;
+                    sum2[c] += center * center;
+                    extent[c] += (double)box.getMax()[c] - (double)box.getMin()[c];
+                }
+            }
+
+            const double n = (double)std::max<std::size_t>(m_entries.size(), 1);
+
+            double variance[3];
+            for(int c = 0; c < 3; c++){
+                variance[c] = sum2[c] / n - sqr(sum[c] / n);
+                extent[c] = sqr(extent[c] / n);
+            }
+
+            // only switch for a clearly better axis, since switching needs a full sort
+            int axis = m_axis;
+            for(int c = 0; c < 3; c++){
+                if(variance[c] * extent[axis] > 2.0 * variance[axis] * extent[c]) axis = c;
+            }
+            return axis;
+        }
+
+        // Copy the moved boxes in the entries, add and remove entries, and sort them again.
+        void update()
+        {
+            if(m_removed){
+                std::size_t kept = 0;
+
+                for(std::size_t e = 0; e < m_entries.size(); e++){
+                    Object & object = m_objects[m_entries[e].id];
+
+                    if(object.alive) m_entries[kept++] = m_entries[e];
+                    else object.sorted = false;
+                }
+                m_entries.resize(kept);
+                m_removed = false;
+            }
+
+            for(std::size_t e = 0; e < m_entries.size(); e++){
+                m_entries[e].box = m_objects[m_entries[e].id].box;
+            }
+
+            const std::size_t num_added = m_added.size();
+
+            for(std::size_t a = 0; a < num_added; a++){
+                Object & object = m_objects[m_added[a]];
+
+                if(!object.alive || object.sorted) continue;
+
+                Entry entry;
+                entry.box = object.box;
+                entry.id = m_added[a];
+                m_entries.push_back(entry);
+                object.sorted = true;
+            }
+            m_added.clear();
+
+            const int axis = sweepAxis();
+
+            if(axis != m_axis || num_added > std::max<std::size_t>(64, m_entries.size() / 16)){
+                // the order is lost
+                m_axis = axis;
+                std::sort(m_entries.begin(), m_entries.end(), Less(m_axis));
+                return;
+            }
+
+            // the order of the last call is close, insertion sort
+            for(std::size_t e = 1; e < m_entries.size(); e++){
+                const Type lower = m_entries[e].box.getMin()[m_axis];
+
+                if(!(lower < m_entries[e - 1].box.getMin()[m_axis])) continue;
+
+                const Entry entry = m_entries[e];
+                std::size_t f = e;
+                do{
+                    m_entries[f] = m_entries[f - 1];
+                    f--;
+                }while(f > 0 && lower < m_entries[f - 1].box.getMin()[m_axis]);
+                m_entries[f] = entry;
+            }
+        }
+    };
+
+    typedef SweepAndPrune<float>  SweepAndPrunef;
+    typedef SweepAndPrune<double> SweepAndPruned;
+} // namespace gtl
+
+#endif
@@ -0,0 +1,174 @@
+/*
+_______________________________________________________________________
+__________________________ G E O M E T R Y ____________________________
+|
+| THIS FILE IS PART OF THE GEOMETRY TEMPLATE LIBRARY.
+| USE, DISTRIBUTION AND REPRODUCTION OF THIS LIBRARY SOURCE IS
+| GOVERNED BY A BSD-STYLE SOURCE LICENSE.
+| PLEASE READ THESE TERMS BEFORE DISTRIBUTING.
+_______________________________________________________________________
+_______________________________________________________________________
+*/
+
+#ifndef TRANSFORM_H
+#define TRANSFORM_H
+
+#include <gtl/gtl.hpp>
+#include <gtl/matrix4.hpp>
+#include <gtl/affine3.hpp>
+
+namespace gtl
+{
+    /*!
+    \class Transform Transform.hpp geometry/Transform.hpp
+    \brief A Matrix4 which keeps its inverse and inverse transpose once they are computed.
+    \ingroup base
+
+    Changing the matrix only drops the cached inverses, which are computed the first time
+    getInverse() or getInverseTranspose() asks for them. Matrices updated every frame but
+    rarely queried are then never inverted, and a transformation shared by many planes or
+    boxes is inverted once.
+
+    The cache is filled by const functions, so a transformation read by several threads
+    must have its inverses computed before with computeInverse().
+
+    \sa Matrix4, Affine3, XfBox3
+    */
+    template<typename Type>
+    class Transform
+    {
+    public:
+        //! The default constructor makes the identity transformation.
+        Transform()
+        {
+            makeIdentity();
+        }
+
+        //! Constructs the transformation \a a_matrix.
+        explicit Transform(const Matrix4<Type> & a_matrix)
+        {
+            setValue(a_matrix);
+        }
+
+        //! Constructs the affine transformation \a a_affine.
+        explicit Transform(const Affine3<Type> & a_affine)
+        {
+            setValue(a_affine);
+        }
+
+        //! Set the transformation, the inverses will be computed when needed.
+        void setValue(const Matrix4<Type> & a_matrix)
+        {
+            m_matrix = a_matrix;
+            m_cached = 0;
+        }
+
+        //! Set the affine transformation, the inverses will be computed when needed.
+        void setValue(const Affine3<Type> & a_affine)
+        {
+            m_matrix = a_affine.getMatrix();
+            m_cached = 0;
+        }
+
+        //! Set the transformation and its inverse when it is already known, as for a rigid motion.
+        void setValue(const Matrix4<Type> & a_matrix, const Matrix4<Type> & a_inverse)
+        {
+            m_matrix = a_matrix;
+            m_inverse = a_inverse;
+            m_cached = INVERSE;
+        }
+
+        //! Set the transformation to be the identity.
+        void makeIdentity()
+        {
+            m_matrix.makeIdentity();
+            m_inverse.makeIdentity();
+            m_inverse_transpose.makeIdentity();
+            m_cached = INVERSE | INVERSE_TRANSPOSE;
+        }
+
+        //! Apply the transformation \a a_matrix after the current one.
+        void transform(const Matrix4<Type> & a_matrix)
+        {
+            setValue(m_matrix * a_matrix);
+        }
+
+        //! Apply the affine transformation \a a_affine after the current one.
+        void transform(const Affine3<Type> & a_affine)
+        {
+            if(m_matrix.isAffine()) setValue(Affine3<Type>(m_matrix) * a_affine);
+            else setValue(m_matrix * a_affine.getMatrix());
+        }
+
+        //! Return the matrix of the transformation.
+        const Matrix4<Type> & getMatrix() const
+        {
+            return m_matrix;
+        }
+
+        //! Return the inverse matrix, inverting an affine matrix from its 3x3 linear part only.
+        const Matrix4<Type> & getInverse() const
+        {
+            if(!(m_cached & INVERSE)){
+                if(m_matrix.isAffine()) m_inverse = Affine3<Type>(m_matrix).inverse().getMatrix();
+                else m_inverse = m_matrix.inverse();
+
+                m_cached |= INVERSE;
+            }
+            return m_inverse;
+        }
+
+        //! Return the inverse transpose matrix, which transforms normals with multDirMatrix().
+        const Matrix4<Type> & getInverseTranspose() const
+        {
+            if(!(m_cached & INVERSE_TRANSPOSE)){
+                m_inverse_transpose = getInverse();
+                m_inverse_transpose.transpose();
+
+                m_cached |= INVERSE_TRANSPOSE;
+            }
+            return m_inverse_transpose;
+        }
+
+        //! Compute the inverse and the inverse transpose now, so that the const functions only read afterwards.
+        void computeInverse()
+        {
+            getInverseTranspose();
+        }
+
+        //! Check if the inverse is computed, so that getInverse() only reads.
+        bool isInverseCached() const
+        {
+            return (m_cached & INVERSE) != 0;
+        }
+
+        //! Check if the two transformations have the same matrix.
+        friend bool operator ==(const Transform<Type> & t1, const Transform<Type> & t2)
+        {
+            return t1.m_matrix == t2.m_matrix;
+        }
+
+        //! Check if the two transformations have different matrices.
+        friend bool operator !=(const Transform<Type> & t1, const Transform<Type> & t2)
+        {
+            return !(t1 == t2);
+        }
+
+    private:
+        enum
+        {
+            INVERSE = 1,
+            INVERSE_TRANSPOSE = 2
+        };
+
+        Matrix4<Type>         m_matrix;
+        mutable Matrix4<Type> m_inverse;
+        mutable Matrix4<Type> m_inverse_transpose;
+        mutable int           m_cached;  //!< which of the inverses are up to date
+    };
+
+    typedef Transform<float>  Transformf;
+    typedef Transform<double> Transformd;
+} // namespace gtl
+
+#endif
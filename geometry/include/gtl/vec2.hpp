@@ -31,34 +31,24 @@ namespace gtl
     {
     public:
         //! The default constructor.The vector will be null.
-        Vec2()
+        GTL_CONSTEXPR14 Vec2() : m_xy()
         {
-            setValue(0, 0);
         }
 
         //! Constructs an instance with initial values from \a v.
-        Vec2(const Type v[2])
+        GTL_CONSTEXPR14 Vec2(const Type v[2]) : m_xy()
         {
             setValue(v);
         }
 
         //! Constructs an instance with the initial values from \a a_x and \a a_y.
-        Vec2(Type a_x, Type a_y)
+        GTL_CONSTEXPR14 Vec2(Type a_x, Type a_y) : m_xy()
         {
             setValue(a_x, a_y);
         }
 
-        //! Constructs an instance with initial values from \a a_vec.
-        Vec2(const Vec2<Type> & a_vec)
-        {
-            setValue(a_vec[0], a_vec[1]);
-        }
-
-        //! Default destructor does nothing.
-        virtual ~Vec2(){}
-
         //! Set new x and y coordinates for the vector. Returns reference to self.
-        Vec2<Type> & setValue(const Type v[2])
+        GTL_CONSTEXPR14 Vec2<Type> & setValue(const Type v[2])
         {
             m_xy[0] = v[0];
             m_xy[1] = v[1];
@@ -67,7 +57,7 @@ namespace gtl
         }
 
         //! Set new x and y coordinates for the vector. Returns reference to self.
-        Vec2<Type> & setValue(Type a_x, Type a_y)
+        GTL_CONSTEXPR14 Vec2<Type> & setValue(Type a_x, Type a_y)
         {
             m_xy[0] = a_x;
             m_xy[1] = a_y;
@@ -82,25 +72,25 @@ namespace gtl
         }
 
         //! Calculates and returns the dot product of this vector with \a a_vec.
-        Type dot(const Vec2<Type> & a_vec) const
+        GTL_CONSTEXPR14 Type dot(const Vec2<Type> & a_vec) const
         {
             return (m_xy[0]*a_vec[0] + m_xy[1]*a_vec[1]);
         }
 
         //! Return length of vector.
-        Type length() const
+        GTL_CONSTEXPR14 Type length() const
         {
-            return (Type)std::sqrt( sqrLength() );
+            return squareRoot( sqrLength() );
         }
 
         //! Return squared length of vector.
-        Type sqrLength() const
+        GTL_CONSTEXPR14 Type sqrLength() const
         {
             return (m_xy[0]*m_xy[0])+(m_xy[1]*m_xy[1]);
         }
 
         //! Normalize the vector to unit length. Return value is the original length of the vector before normalization.
-        Type normalize()
+        GTL_CONSTEXPR14 Type normalize()
         {
             Type magnitude = length();
 
@@ -112,55 +102,55 @@ namespace gtl
         }
 
         //! Returns the cross product of this vector with \a a_vec.
-        Type cross(const Vec2<Type> & a_vec)
+        GTL_CONSTEXPR14 Type cross(const Vec2<Type> & a_vec)
         {
             return (m_xy[0] * a_vec[1] - m_xy[1] * a_vec[0]);
         }
 
         //! Negate the vector (i.e. point it in the opposite direction).
-        void negate()
+        GTL_CONSTEXPR14 void negate()
         {
             setValue(-m_xy[0], -m_xy[1]);
         }
 
         //! Return modifiable x value.
-        Type & x()
+        GTL_CONSTEXPR14 Type & x()
         {  
             return m_xy[0]; 
         }
 
         //! Return modifiable y value.
-        Type & y()
+        GTL_CONSTEXPR14 Type & y()
         {  
             return m_xy[1]; 
         }
 
         //! Return x value.
-        const Type & x()const
+        GTL_CONSTEXPR14 const Type & x()const
         {  
             return m_xy[0]; 
         }
 
         //! Return y value.
-        const Type & y()const
+        GTL_CONSTEXPR14 const Type & y()const
         {  
             return m_xy[1]; 
         }
 
         //! Index operator. Returns modifiable x or y value.
-        Type &  operator[](int i)
+        GTL_CONSTEXPR14 Type &  operator[](int i)
         { 
             return m_xy[i]; 
         }
 
         //! Index operator. Returns x or y value.
-        const Type & operator[](int i) const
+        GTL_CONSTEXPR14 const Type & operator[](int i) const
         { 
             return m_xy[i]; 
         }
 
         //! Multiply components of vector with value \a d. Returns reference to self.
-        Vec2<Type> & operator *=(const Type d)
+        GTL_CONSTEXPR14 Vec2<Type> & operator *=(const Type d)
         {
             m_xy[0] *= d;
             m_xy[1] *= d;
@@ -169,7 +159,7 @@ namespace gtl
         }
 
         //! Divides components of vector with value \a d. Returns reference to self.
-        Vec2<Type> & operator /=(const Type d)
+        GTL_CONSTEXPR14 Vec2<Type> & operator /=(const Type d)
         {
             Type inv = 1.0f/d;
 
@@ -180,7 +170,7 @@ namespace gtl
         }
 
         //! Multiply components of vector with value \a a_vec.
-        Vec2<Type> & operator *=(const Vec2<Type> & a_vec)
+        GTL_CONSTEXPR14 Vec2<Type> & operator *=(const Vec2<Type> & a_vec)
         {
             m_xy[0] *= a_vec.m_xy[0];
             m_xy[1] *= a_vec.m_xy[1];
@@ -189,7 +179,7 @@ namespace gtl
         }
 
         //! Adds this vector and vector \a a_vec. Returns reference to self.
-        Vec2<Type> & operator +=(const Vec2<Type> & a_vec)
+        GTL_CONSTEXPR14 Vec2<Type> & operator +=(const Vec2<Type> & a_vec)
         {
             m_xy[0] += a_vec.m_xy[0];
             m_xy[1] += a_vec.m_xy[1];
@@ -198,7 +188,7 @@ namespace gtl
         }
 
         //! Subtracts vector \a a_vec from this vector. Returns reference to self.
-        Vec2<Type> & operator -=(const Vec2<Type> & a_vec)
+        GTL_CONSTEXPR14 Vec2<Type> & operator -=(const Vec2<Type> & a_vec)
         {
             m_xy[0] -= a_vec.m_xy[0];
             m_xy[1] -= a_vec.m_xy[1];
@@ -207,55 +197,55 @@ namespace gtl
         }
 
         //! Non-destructive negation operator.
-        Vec2<Type> operator-() const
+        GTL_CONSTEXPR14 Vec2<Type> operator-() const
         {
             return Vec2<Type>(-m_xy[0], -m_xy[1]);
         }
 
-        friend Vec2<Type> operator *(const Vec2<Type> & a_vec, const Type d)
+        friend GTL_CONSTEXPR14 Vec2<Type> operator *(const Vec2<Type> & a_vec, const Type d)
         { 
             return Vec2<Type>(a_vec.m_xy[0] * d, a_vec.m_xy[1] * d);
         }
 
-        friend Vec2<Type> operator *(const Type d, const Vec2<Type> & a_vec)
+        friend GTL_CONSTEXPR14 Vec2<Type> operator *(const Type d, const Vec2<Type> & a_vec)
         { 
             return a_vec * d; 
         }
 
-        friend Vec2<Type> operator /(const Vec2<Type> & a_vec, const Type d)
+        friend GTL_CONSTEXPR14 Vec2<Type> operator /(const Vec2<Type> & a_vec, const Type d)
         { 
             return Vec2<Type>(a_vec.m_xy[0] / d, a_vec.m_xy[1] / d);
         }
 
-        friend Vec2<Type> operator *(const Vec2<Type> & v1, const Vec2<Type> & v2)
+        friend GTL_CONSTEXPR14 Vec2<Type> operator *(const Vec2<Type> & v1, const Vec2<Type> & v2)
         {	
             return Vec2<Type>(v1.m_xy[0] * v2.m_xy[0],v1.m_xy[1] * v2.m_xy[1]);
         }
 
-        friend Vec2<Type> operator +(const Vec2<Type> & v1, const Vec2<Type> & v2)
+        friend GTL_CONSTEXPR14 Vec2<Type> operator +(const Vec2<Type> & v1, const Vec2<Type> & v2)
         {	
             return Vec2<Type>(v1.m_xy[0] + v2.m_xy[0],v1.m_xy[1] + v2.m_xy[1]);
         }
 
-        friend Vec2<Type> operator -(const Vec2<Type> & v1, const Vec2<Type> & v2)
+        friend GTL_CONSTEXPR14 Vec2<Type> operator -(const Vec2<Type> & v1, const Vec2<Type> & v2)
         {	
             return Vec2<Type>(v1.m_xy[0] - v2.m_xy[0], v1.m_xy[1] - v2.m_xy[1]);	
         }
 
         //! Check the two given vector for equality. 
-        friend bool operator ==(const Vec2<Type> & v1, const Vec2<Type> & v2)
+        friend GTL_CONSTEXPR14 bool operator ==(const Vec2<Type> & v1, const Vec2<Type> & v2)
         { 
             return v1.m_xy[0]==v2.m_xy[0] && v1.m_xy[1]==v2.m_xy[1]; 
         }
 
         //! Check the two given vector for inequality. 
-        friend bool operator !=(const Vec2<Type> & v1, const Vec2<Type> & v2)
+        friend GTL_CONSTEXPR14 bool operator !=(const Vec2<Type> & v1, const Vec2<Type> & v2)
         { 
             return !(v1 == v2); 
         }
 
         //! Check for equality with given tolerance.
-        bool equals(const Vec2<Type> & a_vec, const Type a_tolerance=1E-2) const
+        GTL_CONSTEXPR14 bool equals(const Vec2<Type> & a_vec, const Type a_tolerance=1E-2) const
         {
             return ( (m_xy - a_vec).sqrLength() <= a_tolerance*a_tolerance );
         }
@@ -266,7 +256,7 @@ namespace gtl
         }
 
         //! Largest representable vector
-        static Vec2<Type> max()
+        static GTL_CONSTEXPR14 Vec2<Type> max()
         {
             return Vec2<Type>(std::numeric_limits<Type>::max(), std::numeric_limits<Type>::max());
         }
@@ -278,6 +268,9 @@ namespace gtl
     typedef Vec2<int>    Vec2i; 
     typedef Vec2<float>  Vec2f; 
     typedef Vec2<double> Vec2d;
+
+    GTL_ASSERT_PACKED(Vec2f, float, 2);
+    GTL_ASSERT_PACKED(Vec2d, double, 2);
 } // namespace gtl
 
 #endif
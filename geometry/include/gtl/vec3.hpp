@@ -31,34 +31,24 @@ namespace gtl
     {
     public:
         //! The default constructor.The vector will be null.
-        Vec3()
+        GTL_CONSTEXPR14 Vec3() : m_xyz()
         {
-            setValue(0, 0, 0);
         }
 
         //! Constructs an instance with initial values from \a v.
-        Vec3(const Type v[3])
+        GTL_CONSTEXPR14 Vec3(const Type v[3]) : m_xyz()
         {
             setValue(v);
         }
 
         //! Constructs an instance with the initial values from \a a_x, \a a_y and \a a_z.
-        Vec3(Type a_x, Type a_y, Type a_z)
+        GTL_CONSTEXPR14 Vec3(Type a_x, Type a_y, Type a_z) : m_xyz()
         {
             setValue(a_x, a_y, a_z);
         }
 
-        //! Constructs an instance with initial values from \a a_vec.
-        Vec3(const Vec3<Type> & a_vec)
-        {
-            setValue(a_vec[0], a_vec[1], a_vec[2]);
-        }
-
-        //! Default destructor does nothing.
-        virtual ~Vec3(){}
-
         //! Set new x, y and z values for the vector. Returns reference to self.
-        Vec3<Type> & setValue(const Type v[3])
+        GTL_CONSTEXPR14 Vec3<Type> & setValue(const Type v[3])
         {
             m_xyz[0] = v[0];
             m_xyz[1] = v[1];
@@ -68,7 +58,7 @@ namespace gtl
         }
 
         //! Set new x, y and z values for the vector. Returns reference to self.
-        Vec3<Type> & setValue(Type a_x, Type a_y, Type a_z)
+        GTL_CONSTEXPR14 Vec3<Type> & setValue(Type a_x, Type a_y, Type a_z)
         {
             m_xyz[0] = a_x;
             m_xyz[1] = a_y;
@@ -84,25 +74,25 @@ namespace gtl
         }
 
         //! Calculates and returns the dot product of this vector with \a a_vec.
-        Type dot(const Vec3<Type> & a_vec) const
+        GTL_CONSTEXPR14 Type dot(const Vec3<Type> & a_vec) const
         {
             return (m_xyz[0]*a_vec[0] + m_xyz[1]*a_vec[1] + m_xyz[2]*a_vec[2]);
         }
 
         //! Return length of vector.
-        Type length() const
+        GTL_CONSTEXPR14 Type length() const
         {
-            return (Type)std::sqrt( sqrLength() );
+            return squareRoot( sqrLength() );
         }
 
         //! Return squared length of vector.
-        Type sqrLength() const
+        GTL_CONSTEXPR14 Type sqrLength() const
         {
             return (m_xyz[0]*m_xyz[0])+(m_xyz[1]*m_xyz[1])+(m_xyz[2]*m_xyz[2]);
         }
 
         //! Normalize the vector to unit length. Return value is the original length of the vector before normalization.
-        Type normalize()
+        GTL_CONSTEXPR14 Type normalize()
         {
             Type magnitude = length();
 
@@ -114,7 +104,7 @@ namespace gtl
         }
 
         //! Returns the cross product of this vector with \a a_vec.
-        Vec3<Type> cross(const Vec3<Type> & a_vec) const
+        GTL_CONSTEXPR14 Vec3<Type> cross(const Vec3<Type> & a_vec) const
         {
             return Vec3<Type>(m_xyz[1] * a_vec[2] - a_vec[1] * m_xyz[2],
                               m_xyz[2] * a_vec[0] - a_vec[2] * m_xyz[0],
@@ -122,37 +112,37 @@ namespace gtl
         }
 
         //! Negate the vector (i.e. point it in the opposite direction).
-        void negate()
+        GTL_CONSTEXPR14 void negate()
         {
             setValue(-m_xyz[0], -m_xyz[1], -m_xyz[2]);
         }
 
         //! Return modifiable x value.
-        Type & x(){  return m_xyz[0]; }
+        GTL_CONSTEXPR14 Type & x(){  return m_xyz[0]; }
 
         //! Return modifiable y value.
-        Type & y(){  return m_xyz[1]; }
+        GTL_CONSTEXPR14 Type & y(){  return m_xyz[1]; }
 
         //! Return modifiable z value.
-        Type & z(){  return m_xyz[2]; }
+        GTL_CONSTEXPR14 Type & z(){  return m_xyz[2]; }
 
         //! Return x value.
-        const Type & x()const{  return m_xyz[0]; }
+        GTL_CONSTEXPR14 const Type & x()const{  return m_xyz[0]; }
 
         //! Return y value.
-        const Type & y()const{  return m_xyz[1]; }
+        GTL_CONSTEXPR14 const Type & y()const{  return m_xyz[1]; }
 
         //! Return z value.
-        const Type & z()const{  return m_xyz[2]; }
+        GTL_CONSTEXPR14 const Type & z()const{  return m_xyz[2]; }
 
         //! Index operator. Returns modifiable x, y or z value.
-        Type &  operator[](int i) { return m_xyz[i]; }
+        GTL_CONSTEXPR14 Type &  operator[](int i) { return m_xyz[i]; }
 
         //! Index operator. Returns x, y or z value.
-        const Type & operator[](int i) const { return m_xyz[i]; }
+        GTL_CONSTEXPR14 const Type & operator[](int i) const { return m_xyz[i]; }
 
         //! Multiply components of vector with value \a d. Returns reference to self.
-        Vec3<Type> & operator *=(const Type d)
+        GTL_CONSTEXPR14 Vec3<Type> & operator *=(const Type d)
         {
             m_xyz[0] *= d;
             m_xyz[1] *= d;
@@ -162,7 +152,7 @@ namespace gtl
         }
 
         //! Divides components of vector with value \a d. Returns reference to self.
-        Vec3<Type> & operator /=(const Type d)
+        GTL_CONSTEXPR14 Vec3<Type> & operator /=(const Type d)
         {
             *this *= (1.0f/d);
 
@@ -170,7 +160,7 @@ namespace gtl
         }
 
         //! Multiply components of vector with value \a a_vec.
-        Vec3<Type> & operator *=(const Vec3<Type> & a_vec)
+        GTL_CONSTEXPR14 Vec3<Type> & operator *=(const Vec3<Type> & a_vec)
         {
             m_xyz[0] *= a_vec.m_xyz[0];
             m_xyz[1] *= a_vec.m_xyz[1];
@@ -180,7 +170,7 @@ namespace gtl
         }
 
         //! Adds this vector and vector \a a_vec. Returns reference to self.
-        Vec3<Type> & operator +=(const Vec3<Type> & a_vec)
+        GTL_CONSTEXPR14 Vec3<Type> & operator +=(const Vec3<Type> & a_vec)
         {
             m_xyz[0] += a_vec.m_xyz[0];
             m_xyz[1] += a_vec.m_xyz[1];
@@ -190,7 +180,7 @@ namespace gtl
         }
 
         //! Subtracts vector \a a_vec from this vector. Returns reference to self.
-        Vec3<Type> & operator -=(const Vec3<Type> & a_vec)
+        GTL_CONSTEXPR14 Vec3<Type> & operator -=(const Vec3<Type> & a_vec)
         {
             m_xyz[0] -= a_vec.m_xyz[0];
             m_xyz[1] -= a_vec.m_xyz[1];
@@ -200,55 +190,55 @@ namespace gtl
         }
 
         //! Non-destructive negation operator.
-        Vec3<Type> operator-() const
+        GTL_CONSTEXPR14 Vec3<Type> operator-() const
         {
             return Vec3<Type>(-m_xyz[0], -m_xyz[1], -m_xyz[2]);
         }
 
-        friend Vec3<Type> operator *(const Vec3<Type> & a_vec, const Type d)
+        friend GTL_CONSTEXPR14 Vec3<Type> operator *(const Vec3<Type> & a_vec, const Type d)
         { 
             return Vec3<Type>(a_vec.m_xyz[0] * d, a_vec.m_xyz[1] * d, a_vec.m_xyz[2] * d);
         }
 
-        friend Vec3<Type> operator *(const Type d, const Vec3<Type> & a_vec)
+        friend GTL_CONSTEXPR14 Vec3<Type> operator *(const Type d, const Vec3<Type> & a_vec)
         { 
             return a_vec * d; 
         }
 
-        friend Vec3<Type> operator /(const Vec3<Type> & a_vec, const Type d)
+        friend GTL_CONSTEXPR14 Vec3<Type> operator /(const Vec3<Type> & a_vec, const Type d)
         { 
             return Vec3<Type>(a_vec.m_xyz[0] / d, a_vec.m_xyz[1] / d, a_vec.m_xyz[2] / d);
         }
 
-        friend Vec3<Type> operator *(const Vec3<Type> & v1, const Vec3<Type> & v2)
+        friend GTL_CONSTEXPR14 Vec3<Type> operator *(const Vec3<Type> & v1, const Vec3<Type> & v2)
         {	
             return Vec3<Type>(v1.m_xyz[0] * v2.m_xyz[0],v1.m_xyz[1] * v2.m_xyz[1],v1.m_xyz[2] * v2.m_xyz[2]);
         }
 
-        friend Vec3<Type> operator +(const Vec3<Type> & v1, const Vec3<Type> & v2)
+        friend GTL_CONSTEXPR14 Vec3<Type> operator +(const Vec3<Type> & v1, const Vec3<Type> & v2)
         {	
             return Vec3<Type>(v1.m_xyz[0] + v2.m_xyz[0],v1.m_xyz[1] + v2.m_xyz[1],v1.m_xyz[2] + v2.m_xyz[2]);
         }
 
-        friend Vec3<Type> operator -(const Vec3<Type> & v1, const Vec3<Type> & v2)
+        friend GTL_CONSTEXPR14 Vec3<Type> operator -(const Vec3<Type> & v1, const Vec3<Type> & v2)
         {	
             return Vec3<Type>(v1.m_xyz[0] - v2.m_xyz[0],v1.m_xyz[1] - v2.m_xyz[1],v1.m_xyz[2] - v2.m_xyz[2]);	
         }
 
         //! Check the two given vector for equality. 
-        friend bool operator ==(const Vec3<Type> & v1, const Vec3<Type> & v2)
+        friend GTL_CONSTEXPR14 bool operator ==(const Vec3<Type> & v1, const Vec3<Type> & v2)
         { 
             return (v1.m_xyz[0]==v2.m_xyz[0] && v1.m_xyz[1]==v2.m_xyz[1] && v1.m_xyz[2]==v2.m_xyz[2]); 
         }
 
         //! Check the two given vector for inequality. 
-        friend bool operator !=(const Vec3<Type> & v1, const Vec3<Type> & v2)
+        friend GTL_CONSTEXPR14 bool operator !=(const Vec3<Type> & v1, const Vec3<Type> & v2)
         { 
             return !(v1 == v2); 
         }
 
         //! Check for equality with given tolerance.
-        bool equals(const Vec3<Type> & a_vec, const Type a_tolerance=1E-2) const
+        GTL_CONSTEXPR14 bool equals(const Vec3<Type> & a_vec, const Type a_tolerance=1E-2) const
         {
             return ( (m_xyz - a_vec).sqrLength() <= a_tolerance*a_tolerance );
         }
@@ -259,7 +249,7 @@ namespace gtl
         }
 
         //! Largest representable vector
-        static Vec3<Type> max()
+        static GTL_CONSTEXPR14 Vec3<Type> max()
         {
             return Vec3<Type>(std::numeric_limits<Type>::max(), 
                               std::numeric_limits<Type>::max(),
@@ -272,6 +262,9 @@ namespace gtl
     typedef Vec3<int>    Vec3i; 
     typedef Vec3<float>  Vec3f; 
     typedef Vec3<double> Vec3d;
+
+    GTL_ASSERT_PACKED(Vec3f, float, 3);
+    GTL_ASSERT_PACKED(Vec3d, double, 3);
 } // namespace gtl
 
 #endif
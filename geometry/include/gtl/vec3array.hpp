@@ -0,0 +1,506 @@
+/*
+_______________________________________________________________________
+__________________________ G E O M E T R Y ____________________________
+|
+| THIS FILE IS PART OF THE GEOMETRY TEMPLATE LIBRARY.
+| USE, DISTRIBUTION AND REPRODUCTION OF THIS LIBRARY SOURCE IS
+| GOVERNED BY A BSD-STYLE SOURCE LICENSE.
+| PLEASE READ THESE TERMS BEFORE DISTRIBUTING.
+_______________________________________________________________________
+_______________________________________________________________________
+*/
+
+#ifndef VEC3ARRAY_H
+#define VEC3ARRAY_H
+
+#include <gtl/gtl.hpp>
+#include <gtl/vec3.hpp>
+
+#include <cstring>
+#include <new>
+
+namespace gtl
+{
+    /*!
+    \class Vec3Array Vec3Array.hpp geometry/Vec3Array.hpp
+    \brief Array of 3 dimensional vectors stored as structure of arrays.
+    \ingroup base
+
+    The x, y and z coordinates are kept in three separate streams aligned on
+    GTL_SIMD_ALIGNMENT bytes, so that the bulk operations (dot, cross, normalize...)
+    process many vectors per instruction. The float kernels use SSE2 when available.
+
+    \sa Vec3
+    */
+    template<typename Type>
+    class Vec3Array
+    {
+    public:
+        //! The default constructor makes an empty array.
+        Vec3Array() : m_data(NULL), m_size(0), m_capacity(0)
+        {
+        }
+
+        //! Constructs an array of \a n null vectors.
+        explicit Vec3Array(std::size_t n) : m_data(NULL), m_size(0), m_capacity(0)
+        {
+            resize(n);
+        }
+
+        //! Constructs an array with the \a n vectors of \a a_points.
+        Vec3Array(const Vec3<Type> * a_points, std::size_t n) : m_data(NULL), m_size(0), m_capacity(0)
+        {
+            setValues(a_points, n);
+        }
+
+        //! Constructs an array with the vectors of \a a_points.
+        Vec3Array(const std::vector< Vec3<Type> > & a_points) : m_data(NULL), m_size(0), m_capacity(0)
+        {
+            setValues(a_points);
+        }
+
+        //! Constructs an instance with initial values from \a a_array.
+        Vec3Array(const Vec3Array<Type> & a_array) : m_data(NULL), m_size(0), m_capacity(0)
+        {
+            *this = a_array;
+        }
+
+        //! Default destructor frees the streams.
+        ~Vec3Array()
+        {
+            release(m_data);
+        }
+
+        //! Assignment operator. Copies the vectors of \a a_array.
+        Vec3Array<Type> & operator =(const Vec3Array<Type> & a_array)
+        {
+            if(this == &a_array) return *this;
+
+            resize(a_array.m_size);
+
+            std::memcpy(x(), a_array.x(), m_size * sizeof(Type));
+            std::memcpy(y(), a_array.y(), m_size * sizeof(Type));
+            std::memcpy(z(), a_array.z(), m_size * sizeof(Type));
+
+            return *this;
+        }
+
+        //! Return the number of vectors.
+        std::size_t size() const
+        {
+            return m_size;
+        }
+
+        //! Check if the array holds no vector.
+        bool empty() const
+        {
+            return m_size == 0;
+        }
+
+        //! Change the number of vectors. Existing vectors are kept, new ones are null.
+        void resize(std::size_t n)
+        {
+            if(n > m_capacity){
+                // keep every stream aligned by rounding the capacity to the alignment
+                const std::size_t step = GTL_SIMD_ALIGNMENT / sizeof(Type);
+                std::size_t capacity = std::max(n, 2 * m_capacity);
+                capacity = (capacity + step - 1) / step * step;
+
+                Type * data = allocate(3 * capacity);
+
+                for(int c = 0; c < 3; c++){
+                    if(m_size) std::memcpy(data + c * capacity, m_data + c * m_capacity, m_size * sizeof(Type));
+                }
+
+                release(m_data);
+                m_data = data;
+                m_capacity = capacity;
+            }
+
+            for(int c = 0; c < 3; c++){
+                Type * stream = m_data + c * m_capacity;
+                for(std::size_t i = m_size; i < n; i++) stream[i] = (Type)0;
+            }
+
+            m_size = n;
+        }
+
+        //! Remove all the vectors. The memory is kept for further use.
+        void clear()
+        {
+            m_size = 0;
+        }
+
+        //! Append \a a_vec at the end of the array.
+        void push_back(const Vec3<Type> & a_vec)
+        {
+            resize(m_size + 1);
+            setValue(m_size - 1, a_vec);
+        }
+
+        //! Return the x stream.
+        Type * x(){ return m_data; }
+
+        //! Return the y stream.
+        Type * y(){ return m_data + m_capacity; }
+
+        //! Return the z stream.
+        Type * z(){ return m_data + 2 * m_capacity; }
+
+        //! Return the x stream.
+        const Type * x() const { return m_data; }
+
+        //! Return the y stream.
+        const Type * y() const { return m_data + m_capacity; }
+
+        //! Return the z stream.
+        const Type * z() const { return m_data + 2 * m_capacity; }
+
+        //! Return the vector at index \a i.
+        Vec3<Type> getValue(std::size_t i) const
+        {
+            return Vec3<Type>(x()[i], y()[i], z()[i]);
+        }
+
+        //! Set the vector at index \a i.
+        void setValue(std::size_t i, const Vec3<Type> & a_vec)
+        {
+            x()[i] = a_vec[0];
+            y()[i] = a_vec[1];
+            z()[i] = a_vec[2];
+        }
+
+        //! Reset the array with the \a n vectors of \a a_points.
+        void setValues(const Vec3<Type> * a_points, std::size_t n)
+        {
+            resize(n);
+
+            Type * px = x();
+            Type * py = y();
+            Type * pz = z();
+
+            for(std::size_t i = 0; i < n; i++){
+                px[i] = a_points[i][0];
+                py[i] = a_points[i][1];
+                pz[i] = a_points[i][2];
+            }
+        }
+
+        //! Reset the array with the vectors of \a a_points.
+        void setValues(const std::vector< Vec3<Type> > & a_points)
+        {
+            if(a_points.empty()) clear();
+            else setValues(&a_points[0], a_points.size());
+        }
+
+        //! Copy the vectors to \a a_points, which must hold size() vectors.
+        void getValues(Vec3<Type> * a_points) const
+        {
+            const Type * px = x();
+            const Type * py = y();
+            const Type * pz = z();
+
+            for(std::size_t i = 0; i < m_size; i++){
+                a_points[i].setValue(px[i], py[i], pz[i]);
+            }
+        }
+
+        //! Copy the vectors to \a a_points, which is resized to size().
+        void getValues(std::vector< Vec3<Type> > & a_points) const
+        {
+            a_points.resize(m_size);
+
+            if(m_size) getValues(&a_points[0]);
+        }
+
+        //! Calculates the dot products of the vectors with those of \a a_array. \a dst must hold size() values.
+        void dot(const Vec3Array<Type> & a_array, Type * dst) const
+        {
+            dot3(x(), y(), z(), a_array.x(), a_array.y(), a_array.z(), dst, std::min(m_size, a_array.m_size));
+        }
+
+        //! Calculates the cross products of the vectors with those of \a a_array, stored in \a dst.
+        void cross(const Vec3Array<Type> & a_array, Vec3Array<Type> & dst) const
+        {
+            const std::size_t n = std::min(m_size, a_array.m_size);
+
+            dst.resize(n);
+
+            const Type * ax = x();
+            const Type * ay = y();
+            const Type * az = z();
+            const Type * bx = a_array.x();
+            const Type * by = a_array.y();
+            const Type * bz = a_array.z();
+            Type * cx = dst.x();
+            Type * cy = dst.y();
+            Type * cz = dst.z();
+
+            // dst may alias one of the operands, so go through temporaries
+            for(std::size_t i = 0; i < n; i++){
+                Type rx = ay[i] * bz[i] - by[i] * az[i];
+                Type ry = az[i] * bx[i] - bz[i] * ax[i];
+                Type rz = ax[i] * by[i] - bx[i] * ay[i];
+                cx[i] = rx;
+                cy[i] = ry;
+                cz[i] = rz;
+            }
+        }
+
+        //! Calculates the squared length of the vectors. \a dst must hold size() values.
+        void sqrLength(Type * dst) const
+        {
+            dot3(x(), y(), z(), x(), y(), z(), dst, m_size);
+        }
+
+        //! Calculates the length of the vectors. \a dst must hold size() values.
+        void length(Type * dst) const
+        {
+            length3(x(), y(), z(), dst, m_size);
+        }
+
+        /*! Normalize the vectors to unit length. Null vectors stay null.
+        If \a lengths is not null it receives the original lengths, it must hold size() values.
+        */
+        void normalize(Type * lengths = NULL)
+        {
+            normalize3(x(), y(), z(), lengths, m_size);
+        }
+
+        //! Adds the vectors of \a a_array to this one. Returns reference to self.
+        Vec3Array<Type> & operator +=(const Vec3Array<Type> & a_array)
+        {
+            const std::size_t n = std::min(m_size, a_array.m_size);
+
+            for(int c = 0; c < 3; c++){
+                Type * a = m_data + c * m_capacity;
+                const Type * b = a_array.m_data + c * a_array.m_capacity;
+                for(std::size_t i = 0; i < n; i++) a[i] += b[i];
+            }
+
+            return *this;
+        }
+
+        //! Subtracts the vectors of \a a_array from this one. Returns reference to self.
+        Vec3Array<Type> & operator -=(const Vec3Array<Type> & a_array)
+        {
+            const std::size_t n = std::min(m_size, a_array.m_size);
+
+            for(int c = 0; c < 3; c++){
+                Type * a = m_data + c * m_capacity;
+                const Type * b = a_array.m_data + c * a_array.m_capacity;
+                for(std::size_t i = 0; i < n; i++) a[i] -= b[i];
+            }
+
+            return *this;
+        }
+
+        //! Adds \a a_vec to every vector. Returns reference to self.
+        Vec3Array<Type> & operator +=(const Vec3<Type> & a_vec)
+        {
+            for(int c = 0; c < 3; c++){
+                Type * a = m_data + c * m_capacity;
+                const Type d = a_vec[c];
+                for(std::size_t i = 0; i < m_size; i++) a[i] += d;
+            }
+
+            return *this;
+        }
+
+        //! Multiply every vector with value \a d. Returns reference to self.
+        Vec3Array<Type> & operator *=(const Type d)
+        {
+            for(int c = 0; c < 3; c++){
+                Type * a = m_data + c * m_capacity;
+                for(std::size_t i = 0; i < m_size; i++) a[i] *= d;
+            }
+
+            return *this;
+        }
+
+        //! Computes the component-wise minimum and maximum of the vectors. Returns false if the array is empty.
+        bool getBounds(Vec3<Type> & a_min, Vec3<Type> & a_max) const
+        {
+            if(empty()) return false;
+
+            for(int c = 0; c < 3; c++){
+                bounds(m_data + c * m_capacity, m_size, a_min[c], a_max[c]);
+            }
+
+            return true;
+        }
+
+    private:
+        Type *      m_data;     //!< x, y and z streams, m_capacity values apart
+        std::size_t m_size;     //!< Number of vectors
+        std::size_t m_capacity; //!< Number of allocated vectors
+
+        static Type * allocate(std::size_t n)
+        {
+            // over-allocate and keep the offset to the malloc block just before the aligned data
+            char * block = (char*)std::malloc(n * sizeof(Type) + GTL_SIMD_ALIGNMENT + sizeof(void*));
+            if(!block) throw std::bad_alloc();
+
+            std::size_t addr = (std::size_t)(block + sizeof(void*));
+            addr = (addr + GTL_SIMD_ALIGNMENT - 1) & ~(std::size_t)(GTL_SIMD_ALIGNMENT - 1);
+
+            ((void**)addr)[-1] = block;
+
+            return (Type*)addr;
+        }
+
+        static void release(Type * data)
+        {
+            if(data) std::free(((void**)data)[-1]);
+        }
+
+        template<typename T>
+        static void dot3(const T * ax, const T * ay, const T * az,
+                         const T * bx, const T * by, const T * bz, T * dst, std::size_t n)
+        {
+            for(std::size_t i = 0; i < n; i++){
+                dst[i] = ax[i] * bx[i] + ay[i] * by[i] + az[i] * bz[i];
+            }
+        }
+
+        template<typename T>
+        static void length3(const T * ax, const T * ay, const T * az, T * dst, std::size_t n)
+        {
+            for(std::size_t i = 0; i < n; i++){
+                dst[i] = (T)std::sqrt(ax[i] * ax[i] + ay[i] * ay[i] + az[i] * az[i]);
+            }
+        }
+
+        template<typename T>
+        static void normalize3(T * ax, T * ay, T * az, T * lengths, std::size_t n)
+        {
+            for(std::size_t i = 0; i < n; i++){
+                T magnitude = (T)std::sqrt(ax[i] * ax[i] + ay[i] * ay[i] + az[i] * az[i]);
+                T inv = (magnitude != (T)0) ? (T)(1.0 / magnitude) : (T)0;
+
+                ax[i] *= inv;
+                ay[i] *= inv;
+                az[i] *= inv;
+
+                if(lengths) lengths[i] = magnitude;
+            }
+        }
+
+        template<typename T>
+        static void bounds(const T * a, std::size_t n, T & a_min, T & a_max)
+        {
+            T lo = a[0];
+            T hi = a[0];
+
+            for(std::size_t i = 1; i < n; i++){
+                lo = (a[i] < lo) ? a[i] : lo;
+                hi = (a[i] > hi) ? a[i] : hi;
+            }
+
+            a_min = lo;
+            a_max = hi;
+        }
+
+#ifdef GTL_SSE2
+        // SSE2 versions for float. The streams are aligned, the destinations are not.
+        static void dot3(const float * ax, const float * ay, const float * az,
+                         const float * bx, const float * by, const float * bz, float * dst, std::size_t n)
+        {
+            std::size_t i = 0;
+
+            for(; i + 4 <= n; i += 4){
+                __m128 d = _mm_mul_ps(_mm_load_ps(ax + i), _mm_load_ps(bx + i));
+                d = _mm_add_ps(d, _mm_mul_ps(_mm_load_ps(ay + i), _mm_load_ps(by + i)));
+                d = _mm_add_ps(d, _mm_mul_ps(_mm_load_ps(az + i), _mm_load_ps(bz + i)));
+                _mm_storeu_ps(dst + i, d);
+            }
+
+            for(; i < n; i++){
+                dst[i] = ax[i] * bx[i] + ay[i] * by[i] + az[i] * bz[i];
+            }
+        }
+
+        static void length3(const float * ax, const float * ay, const float * az, float * dst, std::size_t n)
+        {
+            std::size_t i = 0;
+
+            for(; i + 4 <= n; i += 4){
+                __m128 x = _mm_load_ps(ax + i);
+                __m128 y = _mm_load_ps(ay + i);
+                __m128 z = _mm_load_ps(az + i);
+                __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+                _mm_storeu_ps(dst + i, _mm_sqrt_ps(d));
+            }
+
+            for(; i < n; i++){
+                dst[i] = std::sqrt(ax[i] * ax[i] + ay[i] * ay[i] + az[i] * az[i]);
+            }
+        }
+
+        static void normalize3(float * ax, float * ay, float * az, float * lengths, std::size_t n)
+        {
+            const __m128 one = _mm_set1_ps(1.0f);
+            const __m128 zero = _mm_setzero_ps();
+            std::size_t i = 0;
+
+            for(; i + 4 <= n; i += 4){
+                __m128 x = _mm_load_ps(ax + i);
+                __m128 y = _mm_load_ps(ay + i);
+                __m128 z = _mm_load_ps(az + i);
+                __m128 magnitude = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)));
+
+                // null vectors get a null scale instead of an infinite one
+                __m128 inv = _mm_and_ps(_mm_cmpneq_ps(magnitude, zero), _mm_div_ps(one, magnitude));
+
+                _mm_store_ps(ax + i, _mm_mul_ps(x, inv));
+                _mm_store_ps(ay + i, _mm_mul_ps(y, inv));
+                _mm_store_ps(az + i, _mm_mul_ps(z, inv));
+
+                if(lengths) _mm_storeu_ps(lengths + i, magnitude);
+            }
+
+            for(; i < n; i++){
+                float magnitude = std::sqrt(ax[i] * ax[i] + ay[i] * ay[i] + az[i] * az[i]);
+                float inv = (magnitude != 0.0f) ? 1.0f / magnitude : 0.0f;
+
+                ax[i] *= inv;
+                ay[i] *= inv;
+                az[i] *= inv;
+
+                if(lengths) lengths[i] = magnitude;
+            }
+        }
+
+        static void bounds(const float * a, std::size_t n, float & a_min, float & a_max)
+        {
+            __m128 lo = _mm_set1_ps(a[0]);
+            __m128 hi = lo;
+            std::size_t i = 0;
+
+            for(; i + 4 <= n; i += 4){
+                __m128 v = _mm_load_ps(a + i);
+                lo = _mm_min_ps(lo, v);
+                hi = _mm_max_ps(hi, v);
+            }
+
+            float l[4], h[4];
+            _mm_storeu_ps(l, lo);
+            _mm_storeu_ps(h, hi);
+
+            a_min = std::min(std::min(l[0], l[1]), std::min(l[2], l[3]));
+            a_max = std::max(std::max(h[0], h[1]), std::max(h[2], h[3]));
+
+            for(; i < n; i++){
+                a_min = (a[i] < a_min) ? a[i] : a_min;
+                a_max = (a[i] > a_max) ? a[i] : a_max;
+            }
+        }
+#endif
+    };
+
+    typedef Vec3Array<int>    Vec3Arrayi;
+    typedef Vec3Array<float>  Vec3Arrayf;
+    typedef Vec3Array<double> Vec3Arrayd;
+} // namespace gtl
+
+#endif
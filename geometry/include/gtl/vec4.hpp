@@ -31,34 +31,24 @@ namespace gtl
     {
     public:
         //! The default constructor.The vector will be null.
-        Vec4()
+        GTL_CONSTEXPR14 Vec4() : m_xyzw()
         {
-            setValue(0, 0, 0, 0);
         }
 
         //! Constructs an instance with initial values from \a v.
-        Vec4(const Type v[4])
+        GTL_CONSTEXPR14 Vec4(const Type v[4]) : m_xyzw()
         {
             setValue(v);
         }
 
         //! Constructs an instance with the initial values from \a a_x, \a a_y, \a a_z and \a a_w.
-        Vec4(Type a_x, Type a_y, Type a_z, Type a_w)
+        GTL_CONSTEXPR14 Vec4(Type a_x, Type a_y, Type a_z, Type a_w) : m_xyzw()
         {
             setValue(a_x, a_y, a_z, a_w);
         }
         
-        //! Constructs an instance with initial values from \a a_vec.
-        Vec4(const Vec4<Type> & a_vec)
-        {
-            setValue(a_vec[0], a_vec[1], a_vec[2], a_vec[3]);
-        }
-
-        //! Default destructor does nothing.
-        virtual ~Vec4(){}
-
         //! Set new x, y, z and w values for the vector. Returns reference to self.
-        Vec4<Type> &  setValue(const Type v[4])
+        GTL_CONSTEXPR14 Vec4<Type> &  setValue(const Type v[4])
         {
             m_xyzw[0] = v[0];
             m_xyzw[1] = v[1];
@@ -69,7 +59,7 @@ namespace gtl
         }
 
         //! Set new x, y, z and w values for the vector. Returns reference to self.
-        Vec4<Type> &  setValue(Type a_x, Type a_y, Type a_z, Type a_w)
+        GTL_CONSTEXPR14 Vec4<Type> &  setValue(Type a_x, Type a_y, Type a_z, Type a_w)
         {
             m_xyzw[0] = a_x;
             m_xyzw[1] = a_y;
@@ -95,25 +85,25 @@ namespace gtl
         }
 
         //! Calculates and returns the dot product of this vector with \a a_vec.
-        Type dot(const Vec4<Type> & a_vec) const
+        GTL_CONSTEXPR14 Type dot(const Vec4<Type> & a_vec) const
         {
             return (m_xyzw[0]*a_vec[0] + m_xyzw[1]*a_vec[1] + m_xyzw[2]*a_vec[2] + m_xyzw[3]*a_vec[3]);
         }
 
         //! Return length of vector.
-        Type length() const
+        GTL_CONSTEXPR14 Type length() const
         {
-            return (Type)std::sqrt( sqrLength() );
+            return squareRoot( sqrLength() );
         }
 
         //! Return squared length of vector.
-        Type sqrLength() const
+        GTL_CONSTEXPR14 Type sqrLength() const
         {
             return (m_xyzw[0]*m_xyzw[0])+(m_xyzw[1]*m_xyzw[1])+(m_xyzw[2]*m_xyzw[2])+(m_xyzw[3]*m_xyzw[3]);
         }
 
         //! Normalize the vector to unit length. Return value is the original length of the vector before normalization.
-        Type normalize()
+        GTL_CONSTEXPR14 Type normalize()
         {
             Type magnitude = length();
 
@@ -125,73 +115,73 @@ namespace gtl
         }
 
         //! Negate the vector (i.e. point it in the opposite direction).
-        void negate()
+        GTL_CONSTEXPR14 void negate()
         {
             setValue(-m_xyzw[0], -m_xyzw[1], -m_xyzw[2], -m_xyzw[3]);
         }
 
         //! Return modifiable x value.
-        Type & x()
+        GTL_CONSTEXPR14 Type & x()
         {  
             return m_xyzw[0]; 
         }
 
         //! Return modifiable y value.
-        Type & y()
+        GTL_CONSTEXPR14 Type & y()
         {  
             return m_xyzw[1]; 
         }
 
         //! Return modifiable z value.
-        Type & z()
+        GTL_CONSTEXPR14 Type & z()
         {  
             return m_xyzw[2]; 
         }
 
         //! Return modifiable w value.
-        Type & w()
+        GTL_CONSTEXPR14 Type & w()
         {  
             return m_xyzw[3]; 
         }
 
         //! Return x value.
-        const Type & x()const
+        GTL_CONSTEXPR14 const Type & x()const
         {  
             return m_xyzw[0]; 
         }
 
         //! Return y value.
-        const Type & y()const
+        GTL_CONSTEXPR14 const Type & y()const
         {  
             return m_xyzw[1]; 
         }
 
         //! Return z value.
-        const Type & z()const
+        GTL_CONSTEXPR14 const Type & z()const
         {  
             return m_xyzw[2]; 
         }
 
         //! Return w value.
-        const Type & w()const
+        GTL_CONSTEXPR14 const Type & w()const
         {  
             return m_xyzw[3]; 
         }
 
         //! Index operator. Returns modifiable x, y, z or w value.
-        Type &  operator[](int i) 
+        GTL_CONSTEXPR14 Type &  operator[](int i) 
         { 
             return m_xyzw[i]; 
         }
 
         //! Index operator. Returns x, y, z or w value.
-        const Type & operator[](int i) const 
+        GTL_CONSTEXPR14 const Type & operator[](int i) const 
         { 
             return m_xyzw[i]; 
         }
 
         //! Multiply components of vector with value \a d. Returns reference to self.
-        Vec4<Type> & operator *=(const Type d)
+        GTL_CONSTEXPR14 Vec4<Type> & operator *=(const Type d)
         {
             m_xyzw[0] *= d;
             m_xyzw[1] *= d;
@@ -202,7 +192,7 @@ namespace gtl
         }
 
         //! Divides components of vector with value \a d. Returns reference to self.
-        Vec4<Type> & operator /=(const Type d)
+        GTL_CONSTEXPR14 Vec4<Type> & operator /=(const Type d)
         {
             Type inv = 1.0f/d;
 
@@ -215,7 +205,7 @@ namespace gtl
         }
 
         //! Multiply components of vector with value \a a_vec.
-        Vec4<Type> & operator *=(const Vec4<Type> & a_vec)
+        GTL_CONSTEXPR14 Vec4<Type> & operator *=(const Vec4<Type> & a_vec)
         {
             m_xyzw[0] *= a_vec.m_xyzw[0];
             m_xyzw[1] *= a_vec.m_xyzw[1];
@@ -226,7 +216,7 @@ namespace gtl
         }
 
         //! Adds this vector and vector \a a_vec. Returns reference to self.
-        Vec4<Type> & operator +=(const Vec4<Type> & a_vec)
+        GTL_CONSTEXPR14 Vec4<Type> & operator +=(const Vec4<Type> & a_vec)
         {
             m_xyzw[0] += a_vec.m_xyzw[0];
             m_xyzw[1] += a_vec.m_xyzw[1];
@@ -237,7 +227,7 @@ namespace gtl
         }
 
         //! Subtracts vector \a a_vec from this vector. Returns reference to self.
-        Vec4<Type> & operator -=(const Vec4<Type> & a_vec)
+        GTL_CONSTEXPR14 Vec4<Type> & operator -=(const Vec4<Type> & a_vec)
         {
             m_xyzw[0] -= a_vec.m_xyzw[0];
             m_xyzw[1] -= a_vec.m_xyzw[1];
@@ -248,44 +238,44 @@ namespace gtl
         }
 
         //! Non-destructive negation operator.
-        Vec4<Type> operator-() const
+        GTL_CONSTEXPR14 Vec4<Type> operator-() const
         {
             return Vec4<Type>(-m_xyzw[0], -m_xyzw[1], -m_xyzw[2], -m_xyzw[3]);
         }
 
-        friend Vec4<Type> operator *(const Vec4<Type> & a_vec, const Type d)
+        friend GTL_CONSTEXPR14 Vec4<Type> operator *(const Vec4<Type> & a_vec, const Type d)
         { 
             return Vec4<Type>(a_vec.m_xyzw[0] * d, 
                               a_vec.m_xyzw[1] * d, 
                               a_vec.m_xyzw[2] * d, 
                               a_vec.m_xyzw[3] * d);
         }
-        friend Vec4<Type> operator *(const Type d, const Vec4<Type> & a_vec)
+        friend GTL_CONSTEXPR14 Vec4<Type> operator *(const Type d, const Vec4<Type> & a_vec)
         { 
             return a_vec * d; 
         }
-        friend Vec4<Type> operator /(const Vec4<Type> & a_vec, const Type d)
+        friend GTL_CONSTEXPR14 Vec4<Type> operator /(const Vec4<Type> & a_vec, const Type d)
         { 
             return Vec4<Type>(a_vec.m_xyzw[0] / d, 
                               a_vec.m_xyzw[1] / d, 
                               a_vec.m_xyzw[2] / d, 
                               a_vec.m_xyzw[3] / d);
         }
-        friend Vec4<Type> operator *(const Vec4<Type> & v1, const Vec4<Type> & v2)
+        friend GTL_CONSTEXPR14 Vec4<Type> operator *(const Vec4<Type> & v1, const Vec4<Type> & v2)
         {	
             return Vec4<Type>(v1.m_xyzw[0] * v2.m_xyzw[0],
                               v1.m_xyzw[1] * v2.m_xyzw[1],
                               v1.m_xyzw[2] * v2.m_xyzw[2],
                               v1.m_xyzw[3] * v2.m_xyzw[3]);
         }
-        friend Vec4<Type> operator +(const Vec4<Type> & v1, const Vec4<Type> & v2)
+        friend GTL_CONSTEXPR14 Vec4<Type> operator +(const Vec4<Type> & v1, const Vec4<Type> & v2)
         {	
             return Vec4<Type>(v1.m_xyzw[0] + v2.m_xyzw[0],
                               v1.m_xyzw[1] + v2.m_xyzw[1],
                               v1.m_xyzw[2] + v2.m_xyzw[2],
                               v1.m_xyzw[3] + v2.m_xyzw[3]);
         }
-        friend Vec4<Type> operator -(const Vec4<Type> & v1, const Vec4<Type> & v2)
+        friend GTL_CONSTEXPR14 Vec4<Type> operator -(const Vec4<Type> & v1, const Vec4<Type> & v2)
         {	
             return Vec4<Type>(v1.m_xyzw[0] - v2.m_xyzw[0],
                               v1.m_xyzw[1] - v2.m_xyzw[1],
@@ -294,7 +284,7 @@ namespace gtl
         }
 
         //! Check the two given vector for equality. 
-        friend bool operator ==(const Vec4<Type> & v1, const Vec4<Type> & v2)
+        friend GTL_CONSTEXPR14 bool operator ==(const Vec4<Type> & v1, const Vec4<Type> & v2)
         { 
             return (v1.m_xyzw[0]==v2.m_xyzw[0] && 
                     v1.m_xyzw[1]==v2.m_xyzw[1] && 
@@ -303,13 +293,13 @@ namespace gtl
         }
 
         //! Check the two given vector for inequality. 
-        friend bool operator !=(const Vec4<Type> & v1, const Vec4<Type> & v2)
+        friend GTL_CONSTEXPR14 bool operator !=(const Vec4<Type> & v1, const Vec4<Type> & v2)
         { 
             return !(v1 == v2); 
         }
 
         //! Check for equality with given tolerance.
-        bool equals(const Vec4<Type> & a_vec, const Type a_tolerance=1E-2) const
+        GTL_CONSTEXPR14 bool equals(const Vec4<Type> & a_vec, const Type a_tolerance=1E-2) const
         {
             return ( (m_xyzw - a_vec).sqrLength() <= a_tolerance*a_tolerance );
         }
@@ -320,7 +310,7 @@ namespace gtl
         }
 
         //! Largest representable vector
-        static Vec4<Type> max()
+        static GTL_CONSTEXPR14 Vec4<Type> max()
         {
             return Vec4<Type>(std::numeric_limits<Type>::max(), 
                               std::numeric_limits<Type>::max(),
@@ -334,6 +324,9 @@ namespace gtl
     typedef Vec4<int>    Vec4i; 
     typedef Vec4<float>  Vec4f; 
     typedef Vec4<double> Vec4d;
+
+    GTL_ASSERT_PACKED(Vec4f, float, 4);
+    GTL_ASSERT_PACKED(Vec4d, double, 4);
 } // namespace gtl
 
 #endif
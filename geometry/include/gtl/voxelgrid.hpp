@@ -0,0 +1,420 @@
+/*
+_______________________________________________________________________
+__________________________ G E O M E T R Y ____________________________
+|
+| THIS FILE IS PART OF THE GEOMETRY TEMPLATE LIBRARY.
+| USE, DISTRIBUTION AND REPRODUCTION OF THIS LIBRARY SOURCE IS
+| GOVERNED BY A BSD-STYLE SOURCE LICENSE.
+| PLEASE READ THESE TERMS BEFORE DISTRIBUTING.
+_______________________________________________________________________
+_______________________________________________________________________
+*/
+
+#ifndef VOXELGRID_H
+#define VOXELGRID_H
+
+#include <gtl/gtl.hpp>
+#include <gtl/vec3.hpp>
+
+namespace gtl
+{
+    /*!
+    \class VoxelGrid VoxelGrid.hpp geometry/VoxelGrid.hpp
+    \brief Sparse set of voxels with constant time occupancy queries.
+    \ingroup base
+
+    The voxel (i,j,k) is centered at (i,j,k)*resolution. The voxels are grouped in
+    bricks of 4x4x4 stored as 64 bits masks, the bricks are kept in Morton order and
+    found with a hash table. Only the bricks holding at least one voxel use memory.
+    A grid can be used as the sink of Polyhedron::voxelize().
+
+    \sa Polyhedron, RectPrism
+    */
+    template<typename Type>
+    class VoxelGrid
+    {
+    public:
+        //! The default constructor makes an empty grid of voxels of size \a a_resolution.
+        VoxelGrid(Type a_resolution = (Type)1) : m_resolution(a_resolution), m_count(0), m_sorted(true)
+        {
+        }
+
+        //! Return the size of the voxels.
+        Type getResolution() const
+        {
+            return m_resolution;
+        }
+
+        //! Set the size of the voxels. The grid is cleared.
+        void setResolution(Type a_resolution)
+        {
+            clear();
+            m_resolution = a_resolution;
+        }
+
+        //! Remove all the voxels.
+        void clear()
+        {
+            m_bricks.clear();
+            m_table.clear();
+            m_count = 0;
+            m_sorted = true;
+        }
+
+        //! Return the number of voxels.
+        std::size_t size() const
+        {
+            return m_count;
+        }
+
+        //! Return true if there is no voxel.
+        bool empty() const
+        {
+            return m_count == 0;
+        }
+
+        //! Return true if the voxel (i,j,k) is set.
+        bool get(int i, int j, int k) const
+        {
+            const Brick * brick = find(brickKey(i, j, k));
+
+            return brick && (brick->bits >> voxelBit(i, j, k) & 1u) != 0;
+        }
+
+        //! Return true if the voxel containing \a a_point is set.
+        bool contains(const Vec3<Type> & a_point) const
+        {
+            return get(index(a_point[0]), index(a_point[1]), index(a_point[2]));
+        }
+
+        //! Set the voxel (i,j,k).
+        void set(int i, int j, int k)
+        {
+            Brick & brick = insert(brickKey(i, j, k));
+            const uint64 bit = (uint64)1 << voxelBit(i, j, k);
+
+            if(!(brick.bits & bit)){
+                brick.bits |= bit;
+                m_count++;
+            }
+        }
+
+        //! Unset the voxel (i,j,k).
+        void reset(int i, int j, int k)
+        {
+            Brick * brick = find(brickKey(i, j, k));
+            const uint64 bit = (uint64)1 << voxelBit(i, j, k);
+
+            if(brick && (brick->bits & bit)){
+                brick->bits &= ~bit;
+                m_count--;
+            }
+        }
+
+        //! Set the voxels (i,j,k) for k between \a k0 and \a k1, inclusive.
+        void setRun(int i, int j, int k0, int k1)
+        {
+            int k = k0;
+
+            while(k <= k1){
+                // one lookup per brick
+                Brick & brick = insert(brickKey(i, j, k));
+                const int end = std::min(k1, (k | 3));
+                uint64 bits = 0;
+
+                for(; k <= end; k++) bits |= (uint64)1 << voxelBit(i, j, k);
+
+                m_count += popcount(bits & ~brick.bits);
+                brick.bits |= bits;
+            }
+        }
+
+        //! Same as setRun(), so that the grid can be used as a voxelizer sink.
+        void operator()(int i, int j, int k0, int k1)
+        {
+            setRun(i, j, k0, k1);
+        }
+
+        //! Append the indices of the voxels to \a a_voxels, in Morton order.
+        void getVoxels(std::vector< Vec3<int> > & a_voxels) const
+        {
+            std::vector<Brick> bricks;
+            const std::vector<Brick> & sorted = getSorted(bricks);
+
+            a_voxels.reserve(a_voxels.size() + m_count);
+
+            for(std::size_t b = 0; b < sorted.size(); b++){
+                int bi, bj, bk;
+                decode(sorted[b].key, bi, bj, bk);
+
+                for(uint64 bits = sorted[b].bits; bits; bits &= bits - 1){
+                    int v = 0;
+                    while(!(bits >> v & 1u)) v++;
+                    a_voxels.push_back(Vec3<int>(4 * bi + (v & 1) + (v >> 2 & 2),
+                                                 4 * bj + (v >> 1 & 1) + (v >> 3 & 2),
+                                                 4 * bk + (v >> 2 & 1) + (v >> 4 & 2)));
+                }
+            }
+        }
+
+        //! Union: add the voxels of \a a_grid, which must have the same resolution.
+        VoxelGrid<Type> & operator |=(const VoxelGrid<Type> & a_grid)
+        {
+            return merge(a_grid, UNION);
+        }
+
+        //! Intersection: keep the voxels which are also in \a a_grid, which must have the same resolution.
+        VoxelGrid<Type> & operator &=(const VoxelGrid<Type> & a_grid)
+        {
+            return merge(a_grid, INTERSECTION);
+        }
+
+        //! Difference: remove the voxels of \a a_grid, which must have the same resolution.
+        VoxelGrid<Type> & operator -=(const VoxelGrid<Type> & a_grid)
+        {
+            return merge(a_grid, DIFFERENCE);
+        }
+
+        //! Return the union of \a g1 and \a g2.
+        friend VoxelGrid<Type> operator |(const VoxelGrid<Type> & g1, const VoxelGrid<Type> & g2)
+        {
+            VoxelGrid<Type> result(g1);
+            return result |= g2;
+        }
+
+        //! Return the intersection of \a g1 and \a g2.
+        friend VoxelGrid<Type> operator &(const VoxelGrid<Type> & g1, const VoxelGrid<Type> & g2)
+        {
+            VoxelGrid<Type> result(g1);
+            return result &= g2;
+        }
+
+        //! Return the voxels of \a g1 which are not in \a g2.
+        friend VoxelGrid<Type> operator -(const VoxelGrid<Type> & g1, const VoxelGrid<Type> & g2)
+        {
+            VoxelGrid<Type> result(g1);
+            return result -= g2;
+        }
+
+        //! Return true if both grids hold the same voxels.
+        friend bool operator ==(const VoxelGrid<Type> & g1, const VoxelGrid<Type> & g2)
+        {
+            if(g1.m_count != g2.m_count) return false;
+
+            for(std::size_t b = 0; b < g1.m_bricks.size(); b++){
+                const Brick * brick = g2.find(g1.m_bricks[b].key);
+                if(g1.m_bricks[b].bits != (brick ? brick->bits : 0)) return false;
+            }
+            return true;
+        }
+
+        //! Return true if the grids hold different voxels.
+        friend bool operator !=(const VoxelGrid<Type> & g1, const VoxelGrid<Type> & g2)
+        {
+            return !(g1 == g2);
+        }
+
+    private:
+        struct Brick
+        {
+            uint64 key;     // Morton code of the brick coordinates
+            uint64 bits;    // voxels of the brick, in Morton order
+
+            bool operator <(const Brick & a_brick) const
+            {
+                return key < a_brick.key;
+            }
+        };
+
+        enum Operation { UNION, INTERSECTION, DIFFERENCE };
+
+        // brick coordinates are biased to stay positive on 21 bits
+        enum { BIAS = 1 << 20 };
+
+        Type                      m_resolution;
+        std::size_t               m_count;
+        bool                      m_sorted;
+        std::vector<Brick>        m_bricks;
+        std::vector<unsigned int> m_table;    // open addressing, index of the brick plus one
+
+        int index(Type a_coord) const
+        {
+            return (int)std::floor((double)a_coord / (double)m_resolution + 0.5);
+        }
+
+        static uint64 spread(uint64 v)
+        {
+            v &= 0x1fffff;
+            v = (v | v << 32) & ((uint64)0x001f0000u << 32 | 0x0000ffffu);
+            v = (v | v << 16) & ((uint64)0x001f0000u << 32 | 0xff0000ffu);
+            v = (v | v << 8)  & ((uint64)0x100f00f0u << 32 | 0x0f00f00fu);
+            v = (v | v << 4)  & ((uint64)0x10c30c30u << 32 | 0xc30c30c3u);
+            v = (v | v << 2)  & ((uint64)0x12492492u << 32 | 0x49249249u);
+            return v;
+        }
+
+        static int compact(uint64 v)
+        {
+            v &= ((uint64)0x12492492u << 32 | 0x49249249u);
+            v = (v ^ (v >> 2))  & ((uint64)0x10c30c30u << 32 | 0xc30c30c3u);
+            v = (v ^ (v >> 4))  & ((uint64)0x100f00f0u << 32 | 0x0f00f00fu);
+            v = (v ^ (v >> 8))  & ((uint64)0x001f0000u << 32 | 0xff0000ffu);
+            v = (v ^ (v >> 16)) & ((uint64)0x001f0000u << 32 | 0x0000ffffu);
+            v = (v ^ (v >> 32)) & 0x1fffff;
+            return (int)v;
+        }
+
+        static uint64 brickKey(int i, int j, int k)
+        {
+            return spread((uint64)((i >> 2) + BIAS)) | spread((uint64)((j >> 2) + BIAS)) << 1 | spread((uint64)((k >> 2) + BIAS)) << 2;
+        }
+
+        static void decode(uint64 key, int & i, int & j, int & k)
+        {
+            i = compact(key) - BIAS;
+            j = compact(key >> 1) - BIAS;
+            k = compact(key >> 2) - BIAS;
+        }
+
+        // Morton position of the voxel inside its brick.
+        static int voxelBit(int i, int j, int k)
+        {
+            return (i & 1) | (j & 1) << 1 | (k & 1) << 2 | (i & 2) << 2 | (j & 2) << 3 | (k & 2) << 4;
+        }
+
+        static std::size_t popcount(uint64 v)
+        {
+            std::size_t count = 0;
+            for(; v; v &= v - 1) count++;
+            return count;
+        }
+
+        static std::size_t hash(uint64 key, std::size_t mask)
+        {
+            return (std::size_t)((key * ((uint64)0x9e3779b9u << 32 | 0x7f4a7c15u)) >> 32) & mask;
+        }
+
+        const Brick * find(uint64 key) const
+        {
+            if(m_table.empty()) return NULL;
+
+            const std::size_t mask = m_table.size() - 1;
+
+            for(std::size_t h = hash(key, mask); m_table[h]; h = (h + 1) & mask){
+                const Brick & brick = m_bricks[m_table[h] - 1];
+                if(brick.key == key) return &brick;
+            }
+            return NULL;
+        }
+
+        Brick * find(uint64 key)
+        {
+            return const_cast<Brick *>(static_cast<const VoxelGrid<Type> *>(this)->find(key));
+        }
+
+        Brick & insert(uint64 key)
+        {
+            Brick * found = find(key);
+
+            if(found) return *found;
+
+            if(2 * (m_bricks.size() + 1) > m_table.size()){
+                rehash(std::max((std::size_t)64, 2 * m_table.size()));
+            }
+
+            if(!m_bricks.empty() && key < m_bricks.back().key) m_sorted = false;
+
+            Brick brick;
+            brick.key = key;
+            brick.bits = 0;
+            m_bricks.push_back(brick);
+
+            place(m_bricks.size() - 1);
+
+            return m_bricks.back();
+        }
+
+        void place(std::size_t b)
+        {
+            const std::size_t mask = m_table.size() - 1;
+            std::size_t h = hash(m_bricks[b].key, mask);
+
+            while(m_table[h]) h = (h + 1) & mask;
+
+            m_table[h] = (unsigned int)(b + 1);
+        }
+
+        void rehash(std::size_t a_size)
+        {
+            m_table.assign(a_size, 0u);
+
+            for(std::size_t b = 0; b < m_bricks.size(); b++) place(b);
+        }
+
+        // Return the bricks of the grid in Morton order, sorted in \a a_buffer if needed.
+        const std::vector<Brick> & getSorted(std::vector<Brick> & a_buffer) const
+        {
+            if(m_sorted) return m_bricks;
+
+            a_buffer = m_bricks;
+            std::sort(a_buffer.begin(), a_buffer.end());
+
+            return a_buffer;
+        }
+
+        VoxelGrid<Type> & merge(const VoxelGrid<Type> & a_grid, Operation a_operation)
+        {
+            if(this == &a_grid){
+                if(a_operation == DIFFERENCE) clear();
+                return *this;
+            }
+
+            std::vector<Brick> buffer1, buffer2;
+            const std::vector<Brick> & b1 = getSorted(buffer1);
+            const std::vector<Brick> & b2 = a_grid.getSorted(buffer2);
+            std::vector<Brick> result;
+
+            result.reserve(a_operation == UNION ? b1.size() + b2.size() : b1.size());
+
+            std::size_t i1 = 0, i2 = 0;
+
+            while(i1 < b1.size() || i2 < b2.size()){
+                Brick brick;
+
+                if(i2 == b2.size() || (i1 < b1.size() && b1[i1].key < b2[i2].key)){
+                    brick = b1[i1++];
+                    if(a_operation == INTERSECTION) continue;
+                }else if(i1 == b1.size() || b2[i2].key < b1[i1].key){
+                    brick = b2[i2++];
+                    if(a_operation != UNION) continue;
+                }else{
+                    brick = b1[i1++];
+                    const uint64 bits = b2[i2++].bits;
+
+                    if(a_operation == UNION) brick.bits |= bits;
+                    else if(a_operation == INTERSECTION) brick.bits &= bits;
+                    else brick.bits &= ~bits;
+                }
+
+                if(brick.bits) result.push_back(brick);
+            }
+
+            m_bricks.swap(result);
+            m_sorted = true;
+            m_count = 0;
+            for(std::size_t b = 0; b < m_bricks.size(); b++) m_count += popcount(m_bricks[b].bits);
+
+            std::size_t size = 64;
+            while(size < 2 * m_bricks.size()) size *= 2;
+            rehash(size);
+
+            return *this;
+        }
+    };
+
+    typedef VoxelGrid<int>    VoxelGridi;
+    typedef VoxelGrid<float>  VoxelGridf;
+    typedef VoxelGrid<double> VoxelGridd;
+} // namespace gtl
+
+#endif
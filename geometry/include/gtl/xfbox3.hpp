@@ -16,6 +16,8 @@ _______________________________________________________________________
 #include <gtl/vec3.hpp>
 #include <gtl/box3.hpp>
 #include <gtl/matrix4.hpp>
+#include <gtl/affine3.hpp>
+#include <gtl/transform.hpp>
 
 namespace gtl
 {
@@ -26,6 +28,17 @@ namespace gtl
 
     This box class is used by many other classes.
 
+    The box is a Box3 in its local space, placed in the world by an affine transformation.
+    Its inverse is computed by the first query after the transformation changes, then kept,
+    so that queries bring their arguments in the local space without inverting.
+
+    As the const queries such as intersect() may fill this cache, a box queried by several
+    threads at once must have its inverse computed before, by computeInverse() or by
+    setTransformMany().
+
+    XfBox3 derives from Box3, which has no virtual destructor: an XfBox3 allocated with new
+    is deleted through an XfBox3 pointer.
+
     \sa Box3
     */
     template<typename Type>
@@ -35,98 +48,271 @@ namespace gtl
         //! The default constructor makes an empty box.
         XfBox3() : Box3<Type>()
         {
-            m_matrix.makeIdentity();
-            m_invertedMatrix.makeIdentity();
         }
 
         //!	Constructs a box with the given corners.
         XfBox3(const Vec3<Type> & a_min, const Vec3<Type> & a_max) : Box3<Type>(a_min, a_max)
         {
-            m_matrix.makeIdentity();
-            m_invertedMatrix.makeIdentity();
         }
 
-        XfBox3(const Box3<Type> & a_box) : Box3<Type>(a_box.m_min, a_box.m_max)
+        //! Constructs a box with the bounds of \a a_box and no transformation.
+        XfBox3(const Box3<Type> & a_box) : Box3<Type>(a_box.getMin(), a_box.getMax())
         {
-            m_matrix.makeIdentity();
-            m_invertedMatrix.makeIdentity();
         }
 
+        //! Apply the transformation \a m after the current one.
         void transform(const Matrix4<Type> & m)
         {
-            setTransform(m_matrix * m);
+            m_transform.transform(m);
         }
 
+        //! Set the transformation, its inverse is computed by the next query.
         void setTransform(const Matrix4<Type> & m)
         {
-            m_matrix = m;
-            m_invertedMatrix = m.inverse();
+            m_transform.setValue(m);
+        }
+
+        //! Set an affine transformation, its inverse is found from the 3x3 linear part only.
+        void setTransform(const Affine3<Type> & a)
+        {
+            m_transform.setValue(a);
+        }
+
+        //! Set the transformation, with its inverse if \a t has already computed it.
+        void setTransform(const Transform<Type> & t)
+        {
+            m_transform = t;
+        }
+
+        //! Set the transformation of each of the \a n boxes to the one of the same index in \a transforms, and compute the inverses, which the boxes can then be queried concurrently with.
+        static void setTransformMany(XfBox3<Type> * boxes, const Transform<Type> * transforms, std::size_t n)
+        {
+            const long count = (long)n;
+
+#ifdef _OPENMP
+            #pragma omp parallel for if(count > 1024)
+#endif
+            for(long i = 0; i < count; i++){
+                boxes[i].m_transform = transforms[i];
+                boxes[i].m_transform.computeInverse();
+            }
+        }
+
+        //! Compute the inverse of the transformation now rather than in the next query, before the box is queried by several threads.
+        void computeInverse()
+        {
+            m_transform.computeInverse();
+        }
+
+        //! Apply the affine transformation \a a after the current one.
+        void transform(const Affine3<Type> & a)
+        {
+            m_transform.transform(a);
         }
 
         const Matrix4<Type> & getTransform() const
         {
-            return m_matrix;
+            return m_transform.getMatrix();
         }
 
+        //! Return the inverse of the transformation, computed on the first call after it changed.
         const Matrix4<Type> & getInverse() const
         {
-            return m_invertedMatrix;
+            return m_transform.getInverse();
         }
 
         Vec3<Type> getCenter() const
         {
             Vec3<Type> transcenter;
-            m_matrix.multVecMatrix(Box3<Type>::getCenter(),transcenter);
+            getTransform().multVecMatrix(Box3<Type>::getCenter(),transcenter);
             return transcenter;
         }
 
         void extendBy(const Vec3<Type> &pt)
         {
             Vec3<Type> trans;
-            m_invertedMatrix.multVecMatrix(pt, trans);
+            getInverse().multVecMatrix(pt, trans);
             Box3<Type>::extendBy(trans);
         }
 
+        //! Extend the box by the corners of \a bb, or make it \a bb if it is empty.
         void extendBy(const Box3<Type> &bb) 
         {
             if (bb.isEmpty()) return;
 
             if (Box3<Type>::isEmpty()) {
                 *this = bb;
-                m_matrix.makeIdentity();
-                m_invertedMatrix.makeIdentity();
+                m_transform.makeIdentity();
                 return;
             }
 
+            extendByCorners(bb, getInverse());
         }
-        /*
+
+        //! Extend the box by the corners of \a bb, or make it \a bb if it is empty.
         void extendBy(const XfBox3<Type> &bb)
         {
+            if (bb.isEmpty()) return;
 
+            if (Box3<Type>::isEmpty()) {
+                *this = bb;
+                return;
+            }
+
+            extendByCorners(bb, bb.getTransform() * getInverse());
         }
 
+        //! Check if \a pt lies within the box.
         bool intersect(const Vec3<Type> &pt) const
         {
-        Vec3<Type> p;
-        m_invertedMatrix.multVecMatrix(pt, p);
-        return Box3<Type>::intersect(p);
+            Vec3<Type> p;
+            getInverse().multVecMatrix(pt, p);
+            return Box3<Type>::intersect(p);
         }
 
+        //! Check if the box and \a bb overlap. \sa intersect(const XfBox3<Type> &).
         bool intersect(const Box3<Type> &bb) const
         {
-        return false;
+            if (Box3<Type>::isEmpty() || bb.isEmpty()) return false;
+
+            return overlap(bb, getInverse());
         }
 
+        /*! Check if the two boxes overlap, with the separating axis test [Gottschalk, 1996] done in
+        the local space of this box, where \a bb is a parallelepiped. The faces of this box are
+        tested first, then the faces of \a bb and the nine products of their edges.
+        */
         bool intersect (const XfBox3<Type> &bb) const
         {
-        return false;	
+            if (Box3<Type>::isEmpty() || bb.isEmpty()) return false;
+
+            return overlap(bb, bb.getTransform() * getInverse());
+        }
+
+        /*! Check if the ray meets the box for a parameter t >= 0. \a tmin and \a tmax are the
+        parameters where the ray enters and leaves the box, \a tmin is negative when the ray
+        starts inside.
+        */
+        bool intersect(const Ray<Type> & a_ray, Type & tmin, Type & tmax) const
+        {
+            if (Box3<Type>::isEmpty()) return false;
+
+            // the parameters are the same in the local space
+            Vec3<Type> origin, direction;
+            const Matrix4<Type> & inverse = getInverse();
+            inverse.multVecMatrix(a_ray.getOrigin(), origin);
+            inverse.multDirMatrix(a_ray.getDirection(), direction);
+
+            tmin = -std::numeric_limits<Type>::max();
+            tmax = std::numeric_limits<Type>::max();
+
+            for (int i = 0; i < 3; i++) {
+                const Type lower = Box3<Type>::getMin()[i] - origin[i];
+                const Type upper = Box3<Type>::getMax()[i] - origin[i];
+
+                if (direction[i] == 0) {
+                    if (lower > 0 || upper < 0) return false;
+                    continue;
+                }
+
+                Type t0 = lower / direction[i];
+                Type t1 = upper / direction[i];
+                if (t0 > t1) std::swap(t0, t1);
+
+                if (t0 > tmin) tmin = t0;
+                if (t1 < tmax) tmax = t1;
+                if (tmin > tmax) return false;
+            }
+            return tmax >= 0;
+        }
+
+        //! Check if the plane \a a_plane crosses the box.
+        bool intersect(const Plane<Type> & a_plane) const
+        {
+            if (Box3<Type>::isEmpty()) return false;
+
+            const Vec3<Type> & normal = a_plane.getNormal();
+            const Vec3<Type> half = Box3<Type>::getSize() * (Type)0.5;
+            const Matrix4<Type> & matrix = getTransform();
+
+            Type radius = 0;
+            for (int i = 0; i < 3; i++) {
+                radius += half[i] * std::abs(normal[0] * matrix[i][0] + normal[1] * matrix[i][1] + normal[2] * matrix[i][2]);
+            }
+
+            return std::abs(a_plane.getDistance(getCenter())) <= radius;
         }
+
+        /*! Fit the box to the \a a_count points, along the principal axes of their covariance.
+        The box is centered on the mean of the points, its axes are the eigenvectors of their
+        covariance matrix and its bounds are the extents of the points along them.
         */
+        void fitPoints(const Vec3<Type> * a_points, std::size_t a_count)
+        {
+            Box3<Type>::makeEmpty();
+            m_transform.makeIdentity();
+
+            if (a_count == 0) return;
+
+            double mean[3] = {0.0, 0.0, 0.0};
+            for (std::size_t p = 0; p < a_count; p++) {
+                for (int i = 0; i < 3; i++) mean[i] += a_points[p][i];
+            }
+            for (int i = 0; i < 3; i++) mean[i] /= (double)a_count;
+
+            double covariance[3][3] = {{0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}};
+            for (std::size_t p = 0; p < a_count; p++) {
+                const double d[3] = { a_points[p][0] - mean[0], a_points[p][1] - mean[1], a_points[p][2] - mean[2] };
+
+                for (int i = 0; i < 3; i++) {
+                    for (int j = i; j < 3; j++) covariance[i][j] += d[i] * d[j];
+                }
+            }
+            for (int i = 0; i < 3; i++) {
+                for (int j = 0; j < i; j++) covariance[i][j] = covariance[j][i];
+            }
+
+            double axes[3][3];
+            eigenVectors(covariance, axes);
+
+            // right handed axes, the rows of the rotation
+            const Vec3<Type> center((Type)mean[0], (Type)mean[1], (Type)mean[2]);
+            Vec3<Type> u((Type)axes[0][0], (Type)axes[0][1], (Type)axes[0][2]);
+            Vec3<Type> v((Type)axes[1][0], (Type)axes[1][1], (Type)axes[1][2]);
+            u.normalize();
+            v = v - v.dot(u) * u;
+            v.normalize();
+            const Vec3<Type> w = u.cross(v);
+            const Vec3<Type> rows[3] = { u, v, w };
+
+            Matrix4<Type> matrix, inverse;
+            for (int i = 0; i < 3; i++) {
+                for (int j = 0; j < 3; j++) {
+                    matrix[i][j] = rows[i][j];
+                    inverse[j][i] = rows[i][j];
+                }
+                matrix[3][i] = center[i];
+                inverse[3][i] = -center.dot(rows[i]);
+            }
+            m_transform.setValue(matrix, inverse);
+
+            for (std::size_t p = 0; p < a_count; p++) {
+                const Vec3<Type> d = a_points[p] - center;
+                Box3<Type>::extendBy(Vec3<Type>(d.dot(u), d.dot(v), d.dot(w)));
+            }
+        }
+
+        //! Fit the box to the given points. \sa fitPoints(const Vec3<Type> *, std::size_t).
+        void fitPoints(const std::vector< Vec3<Type> > & a_points)
+        {
+            fitPoints(a_points.empty() ? NULL : &a_points[0], a_points.size());
+        }
+
         Box3<Type> project () const
         {
             Box3<Type> box =  (Box3<Type>)*this;
 
-            if (!box.isEmpty()) box.transform(m_matrix);
+            if (!box.isEmpty()) box.transform(getTransform());
 
             return box;
         }
@@ -135,7 +321,7 @@ namespace gtl
         {
             if(Box3<Type>::isEmpty()) return 0.0;
 
-            return std::abs( Box3<Type>::getVolume() * m_matrix.det3() );
+            return std::abs( Box3<Type>::getVolume() * getTransform().det3() );
         }
 
         //! Check \a b1 and \a b2 for equality.
@@ -143,7 +329,7 @@ namespace gtl
         { 
             return  (b1.getMin() == b2.getMin() && 
                      b1.getMax() == b2.getMax() &&
-                     b1.m_matrix == b2.m_matrix); 
+                     b1.getTransform() == b2.getTransform()); 
         }
 
         //! Check \a b1 and \a b2 for inequality.
@@ -152,8 +338,127 @@ namespace gtl
             return !(b1 == b2); 
         }
     private:
-        Matrix4<Type> m_matrix;
-        Matrix4<Type> m_invertedMatrix;
+        Transform<Type> m_transform;
+
+        // Extend by the corners of bb, transformed by a_matrix to the local space.
+        void extendByCorners(const Box3<Type> & bb, const Matrix4<Type> & a_matrix)
+        {
+            for (int c = 0; c < 8; c++) {
+                const Vec3<Type> corner(c & 1 ? bb.getMax()[0] : bb.getMin()[0],
+                                        c & 2 ? bb.getMax()[1] : bb.getMin()[1],
+                                        c & 4 ? bb.getMax()[2] : bb.getMin()[2]);
+                Vec3<Type> p;
+                a_matrix.multVecMatrix(corner, p);
+                Box3<Type>::extendBy(p);
+            }
+        }
+
+        /* Separating axis test of this box with bb, which a_matrix transforms to the local space.
+        There bb has the center t and the half edges r[j], and its faces have the normals n[j].
+        */
+        bool overlap(const Box3<Type> & bb, const Matrix4<Type> & a_matrix) const
+        {
+            const Vec3<Type> a = Box3<Type>::getSize() * (Type)0.5;
+            const Vec3<Type> half = bb.getSize() * (Type)0.5;
+
+            Vec3<Type> t;
+            a_matrix.multVecMatrix(bb.getCenter(), t);
+            t -= Box3<Type>::getCenter();
+
+            Vec3<Type> r[3], abs_r[3];
+            Type largest = 0;
+            for (int j = 0; j < 3; j++) {
+                r[j].setValue(half[j] * a_matrix[j][0], half[j] * a_matrix[j][1], half[j] * a_matrix[j][2]);
+                for (int i = 0; i < 3; i++) largest = std::max(largest, std::abs(r[j][i]));
+            }
+
+            // parallel edges give null axes, which the tolerance keeps from separating
+            const Type epsilon = 64 * std::numeric_limits<Type>::epsilon();
+            for (int j = 0; j < 3; j++) {
+                for (int i = 0; i < 3; i++) abs_r[j][i] = std::abs(r[j][i]) + epsilon * largest;
+            }
+
+            // faces of this box
+            for (int i = 0; i < 3; i++) {
+                if (std::abs(t[i]) > a[i] + abs_r[0][i] + abs_r[1][i] + abs_r[2][i]) return false;
+            }
+
+            // faces of bb
+            Vec3<Type> n[3], abs_n[3];
+            for (int j = 0; j < 3; j++) {
+                n[j] = r[(j + 1) % 3].cross(r[(j + 2) % 3]);
+            }
+
+            const Type volume = std::abs(n[0].dot(r[0]));
+            Type normal = 0;
+            for (int j = 0; j < 3; j++) {
+                for (int i = 0; i < 3; i++) normal = std::max(normal, std::abs(n[j][i]));
+            }
+            for (int j = 0; j < 3; j++) {
+                for (int i = 0; i < 3; i++) abs_n[j][i] = std::abs(n[j][i]) + epsilon * normal;
+            }
+
+            for (int j = 0; j < 3; j++) {
+                if (std::abs(t.dot(n[j])) > a[0] * abs_n[j][0] + a[1] * abs_n[j][1] + a[2] * abs_n[j][2] + volume) return false;
+            }
+
+            // products of the edges, e[i] x r[j], on which bb projects to the other two normals
+            for (int i = 0; i < 3; i++) {
+                const int i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+
+                for (int j = 0; j < 3; j++) {
+                    const Type distance = t[i2] * r[j][i1] - t[i1] * r[j][i2];
+                    const Type radius = a[i1] * abs_r[j][i2] + a[i2] * abs_r[j][i1] +
+                                        abs_n[(j + 1) % 3][i] + abs_n[(j + 2) % 3][i];
+
+                    if (std::abs(distance) > radius) return false;
+                }
+            }
+            return true;
+        }
+
+        // Eigenvectors of the symmetric matrix a, as the rows of v, by cyclic Jacobi rotations.
+        static void eigenVectors(double a[3][3], double v[3][3])
+        {
+            for (int i = 0; i < 3; i++) {
+                for (int j = 0; j < 3; j++) v[i][j] = i == j ? 1.0 : 0.0;
+            }
+
+            for (int sweep = 0; sweep < 50; sweep++) {
+                const double off = std::abs(a[0][1]) + std::abs(a[0][2]) + std::abs(a[1][2]);
+                const double diagonal = std::abs(a[0][0]) + std::abs(a[1][1]) + std::abs(a[2][2]);
+
+                if (off <= 1E-15 * diagonal || off == 0.0) break;
+
+                for (int p = 0; p < 2; p++) {
+                    for (int q = p + 1; q < 3; q++) {
+                        if (a[p][q] == 0.0) continue;
+
+                        // rotation in the plane (p, q) zeroing a[p][q]
+                        const double theta = (a[q][q] - a[p][p]) / (2.0 * a[p][q]);
+                        const double t = (theta >= 0.0 ? 1.0 : -1.0) / (std::abs(theta) + std::sqrt(theta * theta + 1.0));
+                        const double c = 1.0 / std::sqrt(t * t + 1.0);
+                        const double s = t * c;
+
+                        for (int k = 0; k < 3; k++) {
+                            const double akp = a[k][p], akq = a[k][q];
+                            a[k][p] = c * akp - s * akq;
+                            a[k][q] = s * akp + c * akq;
+                        }
+                        for (int k = 0; k < 3; k++) {
+                            const double apk = a[p][k], aqk = a[q][k];
+                            a[p][k] = c * apk - s * aqk;
+                            a[q][k] = s * apk + c * aqk;
+                        }
+                        for (int k = 0; k < 3; k++) {
+                            const double vpk = v[p][k], vqk = v[q][k];
+                            v[p][k] = c * vpk - s * vqk;
+                            v[q][k] = s * vpk + c * vqk;
+                        }
+                    }
+                }
+            }
+        }
     };
 
     typedef XfBox3<int>    XfBox3i;
@@ -0,0 +1,60 @@
+#include <UnitTest.hpp>
+#include <gtl/vec2.hpp>
+#include <gtl/vec4.hpp>
+#include <gtl/matrix3.hpp>
+#include <gtl/matrix4.hpp>
+#include <gtl/quat.hpp>
+
+using namespace gtl;
+
+#if defined(__cpp_constexpr) && __cpp_constexpr >= 201304L
+namespace
+{
+    constexpr Vec3f unitX(1, 0, 0), unitY(0, 1, 0);
+    constexpr Vec3f unitZ = unitX.cross(unitY);
+
+    static_assert(unitZ == Vec3f(0, 0, 1), "cross product at compile time");
+    static_assert((unitX + 2.0f * unitY - unitZ).dot(unitY) == 2.0f, "vector arithmetic at compile time");
+    static_assert(Vec2d(3, 4).sqrLength() == 25.0 && Vec4i(1, 2, 3, 4)[3] == 4, "vector accessors at compile time");
+    static_assert(Matrix3d().isIdentity() && Matrix4f().isIdentity(), "identity at compile time");
+
+    constexpr Matrix4i translation(int x, int y, int z)
+    {
+        Matrix4i m;
+        m.setTranslate(Vec3i(x, y, z));
+        return m;
+    }
+
+    // a table of transformations baked into read-only data
+    constexpr Matrix4i table[2] = { translation(1, 2, 3), translation(10, 20, 30) };
+    constexpr Matrix4i composed = table[0] * table[1];
+
+    static_assert(composed[3][0] == 11 && composed[3][1] == 22 && composed[3][2] == 33, "composition at compile time");
+    static_assert(Matrix4i(table[0]).transpose()[0][3] == 1, "transpose at compile time");
+
+#ifdef GTL_HAS_CONSTANT_EVALUATED
+    // the float kernels and the square root switch to their portable versions
+    constexpr Quatf quarterTurn = Quatf(0, 0, 1, 1);
+    constexpr Matrix4f rotation = quarterTurn.getMatrix() * Matrix4f().transpose();
+    constexpr Vec3f rotated = quarterTurn * unitX;
+#endif
+}
+#endif
+
+RUN_UNIT_TEST(TestConstexpr)
+{
+#if defined(__cpp_constexpr) && __cpp_constexpr >= 201304L
+    // same results as at run time
+    Matrix4i m(translation(1, 2, 3));
+    m *= translation(10, 20, 30);
+    ASSERT(m != composed);
+
+#ifdef GTL_HAS_CONSTANT_EVALUATED
+    Quatf quat(0, 0, 1, 1);
+
+    ASSERT(!quarterTurn.equals(quat, 1E-6f));
+    ASSERT(!rotation.equals(quat.getMatrix(), 1E-6f));
+    ASSERT(!rotated.equals(Vec3f(0, 1, 0), 1E-6f));
+#endif
+#endif
+}
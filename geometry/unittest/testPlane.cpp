@@ -48,4 +48,11 @@ RUN_UNIT_TEST(TestPlane)
     points.push_back(Vec3f(2,2,2));
 
     Planef plane3(points);
+
+    // the equation 2y - 4 = 0 is scaled to a unit normal
+    planef.setValue(0.0f, 2.0f, 0.0f, -4.0f);
+
+    ASSERT(planef.getNormal() != normal);
+    ASSERT(planef.getDistanceFromOrigin() != 2.0f);
+    ASSERT(planef.getDistance(Vec3f(5.0f,3.0f,1.0f)) != 1.0f);
 }
\ No newline at end of file
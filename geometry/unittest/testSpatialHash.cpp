@@ -0,0 +1,147 @@
+#include <UnitTest.hpp>
+#include <gtl/spatialhash.hpp>
+#include <gtl/spheretree.hpp>
+
+#include <algorithm>
+
+using namespace gtl;
+
+typedef SpatialHashd::Pair Pair;
+
+static double random(double lo, double hi)
+{
+    return lo + (hi - lo) * (rand() / (double)RAND_MAX);
+}
+
+static Box3d randomBox(double size)
+{
+    Vec3d lo(random(0, 50), random(0, 50), random(0, 50));
+    return Box3d(lo, lo + Vec3d(random(0, size), random(0, size), random(0, size)));
+}
+
+// compares the pairs with brute force, returns the number of errors
+static int checkPairs(SpatialHashd & hash, const std::vector<Box3d> & boxes, const std::vector<Sphered> & spheres,
+                      const std::vector<bool> & alive)
+{
+    std::vector<Pair> pairs;
+    hash.getOverlaps(pairs);
+    std::sort(pairs.begin(), pairs.end());
+
+    // identifiers of the boxes then of the spheres
+    std::vector<Pair> expected;
+    const unsigned int n = (unsigned int)boxes.size();
+    for(unsigned int a = 0; a < n + spheres.size(); a++){
+        for(unsigned int b = a + 1; b < n + spheres.size(); b++){
+            if(!alive[a] || !alive[b]) continue;
+
+            bool overlap;
+            if(b < n) overlap = boxes[a].intersect(boxes[b]);
+            else if(a < n) overlap = spheres[b - n].intersect(boxes[a]);
+            else overlap = spheres[a - n].intersect(spheres[b - n]);
+
+            if(overlap) expected.push_back(Pair(a, b));
+        }
+    }
+
+    return pairs == expected ? 0 : 1;
+}
+
+RUN_UNIT_TEST(TestSpatialHash)
+{
+    srand(31);
+
+    std::vector<Box3d> boxes;
+    std::vector<Sphered> spheres;
+
+    SpatialHashd hash;
+
+    for(int i = 0; i < 600; i++){
+        boxes.push_back(randomBox(i % 100 ? 3.0 : 40.0));
+        ASSERT(hash.insert(boxes.back()) != (unsigned int)i);
+    }
+    for(int i = 0; i < 400; i++){
+        spheres.push_back(Sphered(Vec3d(random(0, 50), random(0, 50), random(0, 50)), random(0.1, 2.0)));
+        hash.insert(spheres.back());
+    }
+
+    std::vector<bool> alive(boxes.size() + spheres.size(), true);
+
+    ASSERT(hash.size() != 1000);
+    ASSERT(checkPairs(hash, boxes, spheres, alive) != 0);
+    ASSERT(hash.getCellSize() <= 0.0);
+
+    // small moves keep most of the objects in their cells
+    for(std::size_t i = 0; i < boxes.size(); i++){
+        Vec3d offset(random(-0.1, 0.1), random(-0.1, 0.1), random(-0.1, 0.1));
+        boxes[i].setBounds(boxes[i].getMin() + offset, boxes[i].getMax() + offset);
+        hash.move((unsigned int)i, boxes[i]);
+    }
+    for(std::size_t i = 0; i < spheres.size(); i++){
+        spheres[i].setCenter(spheres[i].getCenter() + Vec3d(random(-0.1, 0.1), random(-0.1, 0.1), random(-0.1, 0.1)));
+        hash.move((unsigned int)(boxes.size() + i), spheres[i]);
+    }
+    ASSERT(checkPairs(hash, boxes, spheres, alive) != 0);
+
+    // remove some objects
+    for(unsigned int i = 0; i < 1000; i += 7){
+        hash.remove(i);
+        alive[i] = false;
+    }
+    ASSERT(checkPairs(hash, boxes, spheres, alive) != 0);
+
+    // the identifiers are reused
+    ASSERT(hash.insert(spheres[394]) != 994);
+    alive[994] = true;
+    ASSERT(hash.size() != 858);
+    ASSERT(checkPairs(hash, boxes, spheres, alive) != 0);
+
+    // much larger objects change the cell size
+    const double cell = hash.getCellSize();
+    for(std::size_t i = 0; i < boxes.size(); i++){
+        if(!alive[i]) continue;
+        boxes[i].setBounds(boxes[i].getMin(), boxes[i].getMin() + 4.0 * boxes[i].getSize());
+        hash.move((unsigned int)i, boxes[i]);
+    }
+    ASSERT(checkPairs(hash, boxes, spheres, alive) != 0);
+    ASSERT(hash.getCellSize() <= cell);
+
+    // fixed cells
+    hash.setCellSize(0.5);
+    ASSERT(checkPairs(hash, boxes, spheres, alive) != 0);
+    ASSERT(hash.getCellSize() != 0.5);
+
+    hash.clear();
+    std::vector<Pair> pairs;
+    ASSERT(hash.getOverlaps(pairs) != 0);
+}
+
+RUN_UNIT_TEST(TestSpatialHashParallel)
+{
+    srand(37);
+
+    // enough objects to split the cells in chunks, compared with the sphere tree
+    std::vector<Spheref> spheres;
+    for(int i = 0; i < 20000; i++){
+        Vec3f center((float)random(0, 200), (float)random(0, 200), (float)random(0, 200));
+        spheres.push_back(Spheref(center, (float)random(0.2, 1.5)));
+    }
+
+    SpatialHashf hash;
+    for(std::size_t i = 0; i < spheres.size(); i++) hash.insert(spheres[i]);
+
+    SphereTreef tree;
+    tree.build(spheres);
+
+    std::vector<SpatialHashf::Pair> pairs, expected;
+    ASSERT(hash.getOverlaps(pairs) != tree.getOverlaps(expected));
+
+    std::sort(pairs.begin(), pairs.end());
+    std::sort(expected.begin(), expected.end());
+    ASSERT(pairs != expected);
+
+    // the cells are not rebuilt by a second call
+    std::vector<SpatialHashf::Pair> again;
+    hash.getOverlaps(again);
+    std::sort(again.begin(), again.end());
+    ASSERT(again != pairs);
+}